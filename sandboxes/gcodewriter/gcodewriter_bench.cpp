@@ -0,0 +1,84 @@
+// Micro-benchmark of formatting the extrusion moves: std::ostringstream with std::fixed / std::setprecision,
+// as GCodeWriter used to format the moves, against GCodeFormatter used by GCodeWriter now.
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <libslic3r/GCodeWriter.hpp>
+
+using namespace Slic3r;
+
+const std::string USAGE_STR = {
+    "Usage: gcodewriter_bench [number_of_lines]"
+};
+
+// The extrusion move as formatted by GCodeWriter::extrude_to_xy() before GCodeFormatter.
+static std::string extrude_to_xy_stream(const Vec2d &point, double E)
+{
+    std::ostringstream gcode;
+    gcode << "G1 X" << std::fixed << std::setprecision(3) << point(0)
+          <<   " Y" << std::fixed << std::setprecision(3) << point(1)
+          <<   " E" << std::fixed << std::setprecision(5) << E;
+    gcode << "\n";
+    return gcode.str();
+}
+
+static std::string extrude_to_xy_formatter(const Vec2d &point, double E)
+{
+    GCodeFormatter gcode;
+    gcode << "G1 X" << GCodeFormatter::fixed(point(0), 3)
+          <<   " Y" << GCodeFormatter::fixed(point(1), 3)
+          <<   " E" << GCodeFormatter::fixed(E, 5);
+    gcode << "\n";
+    return gcode.string();
+}
+
+template<typename Fn>
+static double lines_per_second(const std::vector<Vec2d> &points, Fn &&fn, size_t &total_length)
+{
+    auto   start = std::chrono::steady_clock::now();
+    double E     = 0.;
+    for (const Vec2d &pt : points) {
+        E += 0.0123;
+        total_length += fn(pt, E).size();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return double(points.size()) / elapsed.count();
+}
+
+int main(const int argc, const char *argv[])
+{
+    if (argc > 2) {
+        std::cout << USAGE_STR << std::endl;
+        return EXIT_FAILURE;
+    }
+    size_t num_lines = argc == 2 ? size_t(std::atoll(argv[1])) : 2000000;
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> dist(0., 250.);
+    std::vector<Vec2d> points;
+    points.reserve(num_lines);
+    for (size_t i = 0; i < num_lines; ++ i)
+        points.emplace_back(dist(rng), dist(rng));
+
+    // Verify the output first, then measure.
+    for (size_t i = 0; i < std::min<size_t>(num_lines, 100000); ++ i)
+        if (extrude_to_xy_stream(points[i], double(i) * 0.0123) != extrude_to_xy_formatter(points[i], double(i) * 0.0123)) {
+            std::cerr << "Output of GCodeFormatter differs: " << extrude_to_xy_formatter(points[i], double(i) * 0.0123);
+            return EXIT_FAILURE;
+        }
+
+    size_t total_length = 0;
+    double stream    = lines_per_second(points, extrude_to_xy_stream, total_length);
+    double formatter = lines_per_second(points, extrude_to_xy_formatter, total_length);
+    std::cout << "std::ostringstream: " << size_t(stream)    << " lines/s" << std::endl;
+    std::cout << "GCodeFormatter:     " << size_t(formatter) << " lines/s" << std::endl;
+    std::cout << "Speedup:            " << formatter / stream << " (" << total_length << " characters)" << std::endl;
+    return EXIT_SUCCESS;
+}
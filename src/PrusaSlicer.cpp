@@ -17,22 +17,35 @@
     #endif /* SLIC3R_GUI */
 #endif /* WIN32 */
 
+#include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <string>
 #include <cstring>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <math.h>
+#include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/nowide/args.hpp>
 #include <boost/nowide/cenv.hpp>
+#include <boost/nowide/fstream.hpp>
 #include <boost/nowide/iostream.hpp>
 #include <boost/nowide/integration/filesystem.hpp>
+#include <boost/property_tree/ini_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
 
 #include "unix/fhs.hpp"  // Generated by CMake from ../platform/unix/fhs.hpp.in
 
 #include "libslic3r/libslic3r.h"
 #include "libslic3r/Config.hpp"
+#include "libslic3r/Execution.hpp"
 #include "libslic3r/Geometry.hpp"
 #include "libslic3r/Model.hpp"
 #include "libslic3r/ModelArrange.hpp"
@@ -199,6 +212,15 @@ int CLI::run(int argc, char **argv)
     // Normalizing after importing the 3MFs / AMFs
     m_print_config.normalize_fdm();
 
+    // The batch jobs load their own models and configs, the print options of the command line are shared by all the jobs.
+    if (std::find(m_actions.begin(), m_actions.end(), "batch") != m_actions.end()) {
+        if (m_actions.size() > 1 || ! m_transforms.empty() || ! m_input_files.empty()) {
+            boost::nowide::cerr << "error: --batch cannot be combined with input files, other actions or transform options" << std::endl;
+            return 1;
+        }
+        return this->run_batch(m_config.opt_string("batch")) ? 0 : 1;
+    }
+
     // Initialize full print configs for both the FFF and SLA technologies.
     FullPrintConfig    fff_print_config;
     SLAFullPrintConfig sla_print_config;
@@ -576,6 +598,262 @@ int CLI::run(int argc, char **argv)
     return 0;
 }
 
+namespace {
+
+// A single job of the batch manifest.
+struct BatchJob
+{
+    std::string                 name;
+    std::string                 model_path;
+    // Config files loaded over the command line options, keys to the shared parsed configs.
+    std::vector<std::string>    load_configs;
+    std::string                 output;
+    // Print options of the job, overriding the loaded configs.
+    DynamicPrintConfig          config;
+
+    // Results filled in by the batch worker.
+    bool                        success      = false;
+    // Path to the exported file or an error message.
+    std::string                 message;
+    double                      time_load    = 0.;
+    double                      time_slice   = 0.;
+    double                      time_export  = 0.;
+};
+
+// Parse the batch manifest. Each section of the ini file is a single job, for example:
+//
+// [bracket]
+// model = parts/bracket.stl
+// load = printer.ini;pla.ini
+// output = out/[input_filename_base].gcode
+// layer_height = 0.15
+//
+// The relative paths are resolved against the directory of the manifest.
+static std::vector<BatchJob> load_batch_manifest(const std::string &manifest_path)
+{
+    boost::property_tree::ptree tree;
+    boost::nowide::ifstream ifs(manifest_path);
+    if (! ifs)
+        throw Slic3r::RuntimeError(std::string("Cannot open the batch manifest ") + manifest_path);
+    boost::property_tree::read_ini(ifs, tree);
+
+    const boost::filesystem::path manifest_dir = boost::filesystem::absolute(manifest_path).parent_path();
+    auto resolve = [&manifest_dir](std::string path) {
+        boost::algorithm::trim(path);
+        return path.empty() ? path : boost::filesystem::absolute(path, manifest_dir).string();
+    };
+
+    std::vector<BatchJob> jobs;
+    for (const boost::property_tree::ptree::value_type &section : tree) {
+        if (section.second.empty())
+            throw Slic3r::RuntimeError("The batch manifest key \"" + section.first + "\" is not inside a job section");
+        BatchJob job;
+        job.name       = section.first;
+        job.model_path = resolve(section.second.get<std::string>("model", std::string()));
+        if (job.model_path.empty())
+            throw Slic3r::RuntimeError("The batch job \"" + job.name + "\" does not specify a model");
+        std::vector<std::string> load_configs;
+        boost::algorithm::split(load_configs, section.second.get<std::string>("load", std::string()), boost::algorithm::is_any_of(";"));
+        for (std::string &path : load_configs)
+            if (path = resolve(path); ! path.empty())
+                job.load_configs.emplace_back(std::move(path));
+        job.output     = resolve(section.second.get<std::string>("output", std::string()));
+        // Unlike DynamicPrintConfig::load(), which silently ignores the unknown keys, reject a misspelled print option.
+        for (const boost::property_tree::ptree::value_type &kvp : section.second)
+            if (kvp.first != "model" && kvp.first != "load" && kvp.first != "output") {
+                try {
+                    job.config.set_deserialize(kvp.first, kvp.second.get_value<std::string>());
+                } catch (const UnknownOptionException &) {
+                    throw Slic3r::RuntimeError("The batch job \"" + job.name + "\" contains an unknown option \"" + kvp.first + "\"");
+                }
+            }
+        jobs.emplace_back(std::move(job));
+    }
+    return jobs;
+}
+
+// Synchronize the default parameters of the printer technology with the ones of the config.
+static void apply_print_config_defaults(DynamicPrintConfig &config, PrinterTechnology printer_technology)
+{
+    if (printer_technology == ptSLA) {
+        SLAFullPrintConfig sla_print_config;
+        // The default value has to be different from the one in fff mode.
+        sla_print_config.printer_technology.value = ptSLA;
+        sla_print_config.output_filename_format.value = "[input_filename_base].sl1";
+        // The default bed shape should reflect the default display parameters and not the fff defaults.
+        double w = sla_print_config.display_width.getFloat();
+        double h = sla_print_config.display_height.getFloat();
+        sla_print_config.bed_shape.values = { Vec2d(0, 0), Vec2d(w, 0), Vec2d(w, h), Vec2d(0, h) };
+        sla_print_config.apply(config, true);
+        config.apply(sla_print_config, true);
+    } else {
+        FullPrintConfig fff_print_config;
+        fff_print_config.apply(config, true);
+        config.apply(fff_print_config, true);
+    }
+}
+
+// Load, slice and export a single batch job. The configs of the job are applied in this order:
+// config stored in the 3MF / AMF model, command line options, config files loaded by the job, print options of the job.
+static void slice_batch_job(BatchJob &job, const DynamicPrintConfig &cli_config, const std::map<std::string, DynamicPrintConfig> &configs,
+                            const ExecutionPolicy &policy, bool arrange)
+{
+    typedef std::chrono::steady_clock clock;
+    auto seconds_since = [](clock::time_point t) { return std::chrono::duration<double>(clock::now() - t).count(); };
+
+    clock::time_point t = clock::now();
+    DynamicPrintConfig config;
+    Model              model = Model::read_from_file(job.model_path, &config, true);
+    if (model.objects.empty())
+        throw Slic3r::RuntimeError("The model is empty");
+    config.apply(cli_config);
+    for (const std::string &path : job.load_configs)
+        config.apply(configs.at(path));
+    config.apply(job.config);
+    config.normalize_fdm();
+    PrinterTechnology printer_technology = (Slic3r::printer_technology(config) == ptSLA) ? ptSLA : ptFFF;
+    apply_print_config_defaults(config, printer_technology);
+    if (std::string validity = config.validate(); ! validity.empty())
+        throw Slic3r::RuntimeError(validity);
+
+    if (arrange) {
+        ArrangeParams arrange_cfg;
+        arrange_cfg.min_obj_distance = scaled(min_object_distance(config));
+        arrange_objects(model, get_bed_shape(config), arrange_cfg);
+    }
+    // Only the print of the printer technology of the job is constructed.
+    std::unique_ptr<Print>      fff_print;
+    std::unique_ptr<SLAPrint>   sla_print;
+    std::unique_ptr<SL1Archive> sla_archive;
+    PrintBase                  *print;
+    if (printer_technology == ptSLA) {
+        sla_print   = std::make_unique<SLAPrint>();
+        sla_archive = std::make_unique<SL1Archive>(sla_print->printer_config());
+        sla_print->set_printer(sla_archive.get());
+        print = sla_print.get();
+    } else {
+        fff_print = std::make_unique<Print>();
+        print = fff_print.get();
+        for (ModelObject *mo : model.objects)
+            fff_print->auto_assign_extruders(mo);
+    }
+    print->set_status_silent();
+    print->set_execution_policy(policy);
+    print->apply(model, config);
+    if (std::string err = print->validate(); ! err.empty())
+        throw Slic3r::RuntimeError(err);
+    if (print->empty())
+        throw Slic3r::RuntimeError("Nothing to print. Either the print is empty or no object is fully inside the print volume.");
+    job.time_load = seconds_since(t);
+
+    t = clock::now();
+    print->process();
+    job.time_slice = seconds_since(t);
+
+    t = clock::now();
+    std::string outfile = job.output;
+    std::string outfile_final;
+    if (printer_technology == ptFFF) {
+        // The outfile is processed by a PlaceholderParser.
+        outfile       = fff_print->export_gcode(outfile, nullptr, nullptr);
+        outfile_final = fff_print->print_statistics().finalize_output_path(outfile);
+    } else {
+        outfile       = sla_print->output_filepath(outfile);
+        outfile_final = sla_print->print_statistics().finalize_output_path(outfile);
+        sla_archive->export_print(outfile_final, *sla_print);
+    }
+    if (outfile != outfile_final && Slic3r::rename_file(outfile, outfile_final))
+        throw Slic3r::RuntimeError("Renaming file " + outfile + " to " + outfile_final + " failed");
+    job.time_export = seconds_since(t);
+    job.message     = outfile_final;
+}
+
+} // namespace
+
+bool CLI::run_batch(const std::string &manifest_path)
+{
+    typedef std::chrono::steady_clock clock;
+    clock::time_point t_start = clock::now();
+
+    std::vector<BatchJob>                     jobs;
+    // Config files shared by the jobs are parsed just once.
+    std::map<std::string, DynamicPrintConfig> configs;
+    try {
+        jobs = load_batch_manifest(manifest_path);
+        for (const BatchJob &job : jobs)
+            for (const std::string &path : job.load_configs)
+                if (configs.find(path) == configs.end()) {
+                    DynamicPrintConfig config;
+                    config.load(path);
+                    config.normalize_fdm();
+                    configs.emplace(path, std::move(config));
+                }
+    } catch (const std::exception &ex) {
+        boost::nowide::cerr << manifest_path << ": " << ex.what() << std::endl;
+        return false;
+    }
+    if (jobs.empty()) {
+        boost::nowide::cerr << manifest_path << ": no jobs to slice" << std::endl;
+        return false;
+    }
+
+    // Divide the threads of the process evenly between the concurrently sliced jobs.
+    const size_t nthreads = execution::max_threads();
+    size_t       njobs    = size_t(std::max(m_config.opt_int("batch_jobs"), 0));
+    if (njobs == 0)
+        njobs = std::max<size_t>(nthreads / 4, 1);
+    njobs = std::min(njobs, jobs.size());
+    ExecutionPolicy policy = default_execution_policy();
+    policy.max_threads = std::max<size_t>(nthreads / njobs, 1);
+
+    // Spin up the thread pool before the workers start to compete for it.
+    name_tbb_thread_pool_threads();
+
+    const bool          arrange = ! m_config.opt_bool("dont_arrange");
+    std::atomic<size_t> next_job(0);
+    std::mutex          output_mutex;
+    std::vector<boost::thread> workers;
+    for (size_t worker_id = 0; worker_id < njobs; ++ worker_id)
+        workers.emplace_back(create_thread([this, worker_id, &jobs, &configs, &policy, arrange, &next_job, &output_mutex]() {
+            set_current_thread_name("slic3r_batch_" + std::to_string(worker_id));
+            for (size_t idx = next_job ++; idx < jobs.size(); idx = next_job ++) {
+                BatchJob &job = jobs[idx];
+                try {
+                    slice_batch_job(job, m_print_config, configs, policy, arrange);
+                    job.success = true;
+                } catch (const std::exception &ex) {
+                    job.message = ex.what();
+                }
+                std::lock_guard<std::mutex> lock(output_mutex);
+                if (job.success)
+                    boost::nowide::cout << job.name << ": slicing result exported to " << job.message << std::endl;
+                else
+                    boost::nowide::cerr << job.name << ": " << job.message << std::endl;
+            }
+        }));
+    for (boost::thread &worker : workers)
+        worker.join();
+
+    // Timing report.
+    size_t name_width = 4;
+    for (const BatchJob &job : jobs)
+        name_width = std::max(name_width, job.name.size());
+    boost::nowide::cout << std::endl << "Batch of " << jobs.size() << " jobs, " << njobs << " at once with " << policy.max_threads << " threads each:" << std::endl
+        << std::left << std::setw(int(name_width)) << "job" << std::right
+        << std::setw(8) << "status" << std::setw(10) << "load [s]" << std::setw(11) << "slice [s]" << std::setw(12) << "export [s]" << std::setw(11) << "total [s]" << std::endl;
+    size_t num_failed = 0;
+    for (const BatchJob &job : jobs) {
+        num_failed += ! job.success;
+        boost::nowide::cout << std::left << std::setw(int(name_width)) << job.name << std::right << std::fixed << std::setprecision(2)
+            << std::setw(8) << (job.success ? "ok" : "failed")
+            << std::setw(10) << job.time_load << std::setw(11) << job.time_slice << std::setw(12) << job.time_export
+            << std::setw(11) << job.time_load + job.time_slice + job.time_export << std::endl;
+    }
+    boost::nowide::cout << "Total " << std::chrono::duration<double>(clock::now() - t_start).count() << " s, "
+        << jobs.size() - num_failed << " jobs succeeded, " << num_failed << " failed." << std::endl;
+    return num_failed == 0;
+}
+
 bool CLI::setup(int argc, char **argv)
 {
     {
@@ -638,6 +916,17 @@ bool CLI::setup(int argc, char **argv)
         if (opt_loglevel != 0)
             set_logging_level(opt_loglevel->value);
     }
+
+    {
+        // Set up the execution policy before the TBB thread pool is spinned up.
+        ExecutionPolicy policy;
+        const ConfigOptionInt *opt_max_threads = m_config.opt<ConfigOptionInt>("max_threads");
+        if (opt_max_threads != nullptr && opt_max_threads->value > 0)
+            execution::set_max_threads(size_t(opt_max_threads->value));
+        const ConfigOptionBool *opt_deterministic = m_config.opt<ConfigOptionBool>("deterministic");
+        policy.deterministic = opt_deterministic != nullptr && opt_deterministic->value;
+        set_default_execution_policy(policy);
+    }
     
     std::string validity = m_config.validate();
 
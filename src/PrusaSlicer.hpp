@@ -38,6 +38,9 @@ private:
     /// Exports loaded models to a file of the specified format, according to the options affecting output filename.
     bool export_models(IO::ExportFormat format);
     
+    /// Slices the jobs listed in a batch manifest, several jobs at once. Returns false if any of the jobs failed.
+    bool run_batch(const std::string &manifest_path);
+
     bool has_print_action() const { return m_config.opt_bool("export_gcode") || m_config.opt_bool("export_sla"); }
     
     std::string output_filepath(const Model &model, IO::ExportFormat format) const;
@@ -7,6 +7,9 @@
 #define slic3r_AABBTreeIndirect_hpp_
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
 #include <limits>
 #include <type_traits>
 #include <vector>
@@ -399,6 +402,98 @@ namespace detail {
 		}
 	}
 
+	// Packet of rays traversing the AABB tree together. Up to 32 rays, their activity is tracked by a bit mask.
+	template<typename AVertexType, typename AIndexedFaceType, typename ATreeType, typename AVectorType, size_t ANumRays>
+	struct RayPacketIntersector {
+		using VertexType 		= AVertexType;
+		using IndexedFaceType 	= AIndexedFaceType;
+		using TreeType			= ATreeType;
+		using VectorType 		= AVectorType;
+		using Scalar 			= typename VectorType::Scalar;
+		static constexpr size_t NumRays = ANumRays;
+		static_assert(NumRays > 0 && NumRays <= 32, "The rays of a packet are masked by a 32 bit integer.");
+
+		const std::vector<VertexType> 		&vertices;
+		const std::vector<IndexedFaceType> 	&faces;
+		const TreeType 						&tree;
+
+		std::array<VectorType, NumRays>		 origins;
+		std::array<VectorType, NumRays>		 dirs;
+		// Origins, inverse directions and direction signs by coordinate axes, so that the ray / box test
+		// of all rays of the packet against a single box is evaluated by SIMD instructions.
+		std::array<std::array<Scalar, NumRays>, 3> origins_soa;
+		std::array<std::array<Scalar, NumRays>, 3> invdirs_soa;
+		std::array<std::array<bool, NumRays>, 3>   negdirs_soa;
+		// Ray parameter of the closest hit found so far, infinity if there is none yet.
+		std::array<Scalar, NumRays>			 min_t;
+		std::array<igl::Hit, NumRays>		 hits;
+	};
+
+	// A node is only descended into if at least one ray of the packet intersects its bounding box closer
+	// than its closest hit so far. The node bounding box and the leaf triangle are fetched once
+	// for all the rays of the packet, only the rays which hit the bounding box are tested further.
+	template<typename RayPacketIntersectorType>
+	static inline void intersect_ray_packet_recursive_first_hits(RayPacketIntersectorType &ray_intersector, size_t node_idx, uint32_t active)
+	{
+		using Scalar = typename RayPacketIntersectorType::Scalar;
+
+		const auto &node = ray_intersector.tree.node(node_idx);
+		assert(node.is_valid());
+
+		// Slab test of all the rays against the node bounding box, see ray_box_intersect_invdir().
+		// The loops have no branches to be vectorized. A NaN parameter resulting from a ray starting
+		// on a slab boundary while parallel to it is ignored, the ray is considered to be inside the slab.
+		constexpr size_t 			  NumRays = RayPacketIntersectorType::NumRays;
+		std::array<Scalar, NumRays>   tmin;
+		std::array<Scalar, NumRays>   tmax;
+		tmin.fill(- std::numeric_limits<Scalar>::infinity());
+		tmax.fill(std::numeric_limits<Scalar>::infinity());
+		for (int axis = 0; axis < 3; ++ axis) {
+			const Scalar bmin  = Scalar(node.bbox.min()(axis));
+			const Scalar bmax  = Scalar(node.bbox.max()(axis));
+			const auto 	&org   = ray_intersector.origins_soa[axis];
+			const auto 	&inv   = ray_intersector.invdirs_soa[axis];
+			const auto 	&neg   = ray_intersector.negdirs_soa[axis];
+			for (size_t i = 0; i < NumRays; ++ i) {
+				Scalar tnear = ((neg[i] ? bmax : bmin) - org[i]) * inv[i];
+				Scalar tfar  = ((neg[i] ? bmin : bmax) - org[i]) * inv[i];
+				tmin[i] = tnear > tmin[i] ? tnear : tmin[i];
+				tmax[i] = tfar  < tmax[i] ? tfar  : tmax[i];
+			}
+		}
+		uint32_t mask = 0;
+		for (size_t i = 0; i < NumRays; ++ i)
+			mask |= uint32_t(tmin[i] <= tmax[i] && tmin[i] < ray_intersector.min_t[i] && tmax[i] > Scalar(0)) << i;
+		mask &= active;
+		if (mask == 0)
+			return;
+
+		if (node.is_leaf()) {
+			// Convert the triangle to the ray-triangle test accuracy once for all the rays.
+			using Vector = Eigen::Matrix<double, 3, 1>;
+			auto   face = ray_intersector.faces[node.idx];
+			Vector v0   = ray_intersector.vertices[face(0)].template cast<double>();
+			Vector v1   = ray_intersector.vertices[face(1)].template cast<double>();
+			Vector v2   = ray_intersector.vertices[face(2)].template cast<double>();
+			for (size_t i = 0; i < NumRays; ++ i)
+				if (mask & (uint32_t(1) << i)) {
+					double t, u, v;
+					if (intersect_triangle(ray_intersector.origins[i], ray_intersector.dirs[i], v0, v1, v2, t, u, v)
+						&& t > 0. && float(t) < ray_intersector.min_t[i]) {
+						ray_intersector.hits[i]  = igl::Hit { int(node.idx), -1, float(u), float(v), float(t) };
+						// Compare with the hit parameter rounded to float the same way intersect_ray_recursive_first_hit() does.
+						ray_intersector.min_t[i] = ray_intersector.hits[i].t;
+					}
+				}
+		} else {
+			// Left / right child node index.
+			size_t left  = node_idx * 2 + 1;
+			size_t right = left + 1;
+			intersect_ray_packet_recursive_first_hits(ray_intersector, left,  mask);
+			intersect_ray_packet_recursive_first_hits(ray_intersector, right, mask);
+		}
+	}
+
 	// Nothing to do with COVID-19 social distancing.
 	template<typename AVertexType, typename AIndexedFaceType, typename ATreeType, typename AVectorType>
 	struct IndexedTriangleSetDistancer {
@@ -665,6 +760,47 @@ inline bool intersect_ray_all_hits(
 	return ! hits.empty();
 }
 
+// Find first intersections of a packet of rays with indexed triangle set.
+// The rays are traversed through the AABB tree together, which pays off for coherent rays
+// (rays with close origins and similar directions), as the tree nodes are fetched once for the whole packet.
+// The hits are the same as if intersect_ray_first_hit() was called for each ray separately,
+// a ray which does not intersect the indexed triangle set gets a hit with infinite parameter t.
+// Returns true if at least one of the rays intersects the indexed triangle set.
+template<typename VertexType, typename IndexedFaceType, typename TreeType, typename VectorType, size_t NumRays>
+inline bool intersect_ray_packet_first_hits(
+	// Indexed triangle set - 3D vertices.
+	const std::vector<VertexType> 		&vertices,
+	// Indexed triangle set - triangular faces, references to vertices.
+	const std::vector<IndexedFaceType> 	&faces,
+	// AABBTreeIndirect::Tree over vertices & faces, bounding boxes built with the accuracy of vertices.
+	const TreeType 						&tree,
+	// Origins of the rays.
+	const std::array<VectorType, NumRays> &origins,
+	// Directions of the rays.
+	const std::array<VectorType, NumRays> &dirs,
+	// First intersections of the rays with the indexed triangle set.
+	std::array<igl::Hit, NumRays> 		&hits)
+{
+    using Scalar = typename VectorType::Scalar;
+    auto ray_intersector = detail::RayPacketIntersector<VertexType, IndexedFaceType, TreeType, VectorType, NumRays> {
+		vertices, faces, tree, origins, dirs
+	};
+	for (size_t i = 0; i < NumRays; ++ i) {
+		VectorType invdir = dirs[i].cwiseInverse();
+		for (int axis = 0; axis < 3; ++ axis) {
+			ray_intersector.origins_soa[axis][i] = origins[i](axis);
+			ray_intersector.invdirs_soa[axis][i] = invdir(axis);
+			ray_intersector.negdirs_soa[axis][i] = invdir(axis) < 0;
+		}
+		ray_intersector.min_t[i]  = std::numeric_limits<Scalar>::infinity();
+		ray_intersector.hits[i].t = std::numeric_limits<float>::infinity();
+	}
+	if (! tree.empty())
+		detail::intersect_ray_packet_recursive_first_hits(ray_intersector, size_t(0), uint32_t((uint64_t(1) << NumRays) - 1));
+	hits = ray_intersector.hits;
+	return std::any_of(hits.begin(), hits.end(), [](const igl::Hit &hit) { return ! std::isinf(hit.t); });
+}
+
 // Finding a closest triangle, its closest point and squared distance to the closest point
 // on a 3D indexed triangle set using a pre-built AABBTreeIndirect::Tree.
 // Closest point to triangle test will be performed with the accuracy of VectorType::Scalar
@@ -1,7 +1,10 @@
 #include "BridgeDetector.hpp"
 #include "ClipperUtils.hpp"
+#include "Execution.hpp"
 #include "Geometry.hpp"
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace Slic3r {
 
@@ -73,6 +76,11 @@ void BridgeDetector::initialize()
 }
 
 bool BridgeDetector::detect_angle(double bridge_direction_override)
+{
+    return this->detect_angle(default_execution_policy(), bridge_direction_override);
+}
+
+bool BridgeDetector::detect_angle(const ExecutionPolicy &policy, double bridge_direction_override)
 {
     if (this->_edges.empty() || this->_anchor_regions.empty()) 
         // The bridging region is completely in the air, there are no anchors available at the layer below.
@@ -91,59 +99,20 @@ bool BridgeDetector::detect_angle(double bridge_direction_override)
         we'll use this one to clip our test lines and be sure that their endpoints
         are inside the anchors and not on their contours leading to false negatives. */
     Polygons clip_area = offset(this->expolygons, 0.5f * float(this->spacing));
+    Polygons anchors   = to_polygons(this->_anchor_regions);
     
     /*  we'll now try several directions using a rudimentary visibility check:
         bridge in several directions and then sum the length of lines having both
         endpoints within anchors */
-        
-    bool have_coverage = false;
-    for (size_t i_angle = 0; i_angle < candidates.size(); ++ i_angle)
-    {
-        const double angle = candidates[i_angle].angle;
-
-        Lines lines;
-        {
-            // Get an oriented bounding box around _anchor_regions.
-            BoundingBox bbox = get_extents_rotated(this->_anchor_regions, - angle);
-            // Cover the region with line segments.
-            lines.reserve((bbox.max(1) - bbox.min(1) + this->spacing) / this->spacing);
-            double s = sin(angle);
-            double c = cos(angle);
-            //FIXME Vojtech: The lines shall be spaced half the line width from the edge, but then 
-            // some of the test cases fail. Need to adjust the test cases then?
-//            for (coord_t y = bbox.min(1) + this->spacing / 2; y <= bbox.max(1); y += this->spacing)
-            for (coord_t y = bbox.min(1); y <= bbox.max(1); y += this->spacing)
-                lines.push_back(Line(
-                    Point((coord_t)round(c * bbox.min(0) - s * y), (coord_t)round(c * y + s * bbox.min(0))),
-                    Point((coord_t)round(c * bbox.max(0) - s * y), (coord_t)round(c * y + s * bbox.max(0)))));
-        }
-
-        double total_length = 0;
-        double max_length = 0;
-        {
-            Lines clipped_lines = intersection_ln(lines, clip_area);
-            for (size_t i = 0; i < clipped_lines.size(); ++i) {
-                const Line &line = clipped_lines[i];
-                if (expolygons_contain(this->_anchor_regions, line.a) && expolygons_contain(this->_anchor_regions, line.b)) {
-                    // This line could be anchored.
-                    double len = line.length();
-                    total_length += len;
-                    max_length = std::max(max_length, len);
-                }
-            }        
-        }
-        if (total_length == 0.)
-            continue;
-
-        have_coverage = true;
-        // Sum length of bridged lines.
-        candidates[i_angle].coverage = total_length;
-        /*  The following produces more correct results in some cases and more broken in others.
-            TODO: investigate, as it looks more reliable than line clipping. */
-        // $directions_coverage{$angle} = sum(map $_->area, @{$self->coverage($angle)}) // 0;
-        // max length of bridged lines
-        candidates[i_angle].max_length = max_length;
-    }
+    execution::parallel_for(policy, tbb::blocked_range<size_t>(0, candidates.size(), 4),
+        [this, &candidates, &clip_area, &anchors](const tbb::blocked_range<size_t> &range) {
+            for (size_t i_angle = range.begin(); i_angle < range.end(); ++ i_angle)
+                candidates[i_angle] = this->evaluate_direction(candidates[i_angle].angle, clip_area, anchors);
+        });
+    /*  The following produces more correct results in some cases and more broken in others.
+        TODO: investigate, as it looks more reliable than line clipping. */
+    // $directions_coverage{$angle} = sum(map $_->area, @{$self->coverage($angle)}) // 0;
+    bool have_coverage = std::any_of(candidates.begin(), candidates.end(), [](const BridgeDirection &d) { return d.coverage > 0.; });
 
     // if no direction produced coverage, then there's no bridge direction
     if (! have_coverage)
@@ -170,6 +139,104 @@ bool BridgeDetector::detect_angle(double bridge_direction_override)
     return true;
 }
 
+// Intersect closed polygons with the lines y = y0 + i * step, 0 <= i < num_lines, of a coordinate frame rotated by -angle,
+// where (c, s) = (cos(angle), sin(angle)). The crossings are returned as pairs of (line index, x), sorted by the line index
+// and by x, thus a line is inside the polygons between its crossings 2k and 2k+1.
+static std::vector<std::pair<size_t, double>> scanline_crossings(const Polygons &polygons, double c, double s, double y0, double step, size_t num_lines)
+{
+    std::vector<std::pair<size_t, double>> crossings;
+    for (const Polygon &poly : polygons) {
+        if (poly.points.size() < 3)
+            continue;
+        // A line crosses an edge if its index is in the half open interval between the line indices of the edge end points,
+        // the vertex shared by two edges is thus assigned to the same lines by both edges.
+        auto rotate = [c, s, y0, step](const Point &pt) {
+            Vec2d p(c * double(pt.x()) + s * double(pt.y()), c * double(pt.y()) - s * double(pt.x()));
+            return std::make_pair(p, int64_t(std::ceil((p.y() - y0) / step)));
+        };
+        auto prev = rotate(poly.points.back());
+        for (const Point &pt : poly.points) {
+            auto next = rotate(pt);
+            if (prev.second != next.second) {
+                const Vec2d &a = prev.first;
+                const Vec2d &b = next.first;
+                int64_t ifirst = std::max<int64_t>(std::min(prev.second, next.second), 0);
+                int64_t ilast  = std::min<int64_t>(std::max(prev.second, next.second), int64_t(num_lines));
+                double  xmin   = std::min(a.x(), b.x());
+                double  xmax   = std::max(a.x(), b.x());
+                for (int64_t i = ifirst; i < ilast; ++ i) {
+                    double y = y0 + double(i) * step;
+                    crossings.emplace_back(size_t(i), std::clamp(a.x() + (y - a.y()) * (b.x() - a.x()) / (b.y() - a.y()), xmin, xmax));
+                }
+            }
+            prev = next;
+        }
+    }
+    std::sort(crossings.begin(), crossings.end());
+    return crossings;
+}
+
+BridgeDetector::BridgeDirection BridgeDetector::evaluate_direction(double angle, const Polygons &clip_area, const Polygons &anchors) const
+{
+    BridgeDirection out(angle);
+
+    // Get an oriented bounding box around the anchors.
+    double c = cos(angle);
+    double s = sin(angle);
+    Vec2d  bbox_min(std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+    Vec2d  bbox_max(std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest());
+    for (const Polygon &poly : anchors)
+        for (const Point &pt : poly.points) {
+            Vec2d p(c * double(pt.x()) + s * double(pt.y()), c * double(pt.y()) - s * double(pt.x()));
+            bbox_min = bbox_min.cwiseMin(p);
+            bbox_max = bbox_max.cwiseMax(p);
+        }
+    if (bbox_min.x() > bbox_max.x())
+        return out;
+
+    // Cover the bounding box with test lines. Instead of clipping the test lines with Clipper, both the clipping area
+    // and the anchors are intersected with the test lines in the rotated frame.
+    //FIXME Vojtech: The lines shall be spaced half the line width from the edge, but then 
+    // some of the test cases fail. Need to adjust the test cases then?
+    size_t num_lines = size_t(std::floor((bbox_max.y() - bbox_min.y()) / double(this->spacing))) + 1;
+    std::vector<std::pair<size_t, double>> clipped  = scanline_crossings(clip_area, c, s, bbox_min.y(), double(this->spacing), num_lines);
+    std::vector<std::pair<size_t, double>> anchored = scanline_crossings(anchors,   c, s, bbox_min.y(), double(this->spacing), num_lines);
+
+    // Index of an anchored interval, advanced together with the clipped intervals.
+    size_t j = 0;
+    auto   anchored_at = [&anchored](size_t k, size_t line, double x, double tolerance) {
+        return k < anchored.size() && anchored[k].first == line && anchored[k].second <= x + tolerance;
+    };
+    for (size_t i = 0; i < clipped.size(); i += 2) {
+        assert(clipped[i].first == clipped[i + 1].first);
+        size_t line = clipped[i].first;
+        // An end of a test line trimmed by the bounding box lies on an anchor contour. As the anchor vertices are rounded
+        // to integer coordinates, an anchor edge crossing the test lines at the bounding box is not exactly perpendicular
+        // to them, therefore such an end is accepted if an anchored interval starts or ends within one scaled unit.
+        // A larger tolerance, for example SCALED_EPSILON, accepts test lines just grazing an anchor vertex.
+        double x0   = std::max(clipped[i].second, bbox_min.x());
+        double x1   = std::min(clipped[i + 1].second, bbox_max.x());
+        double tol0 = clipped[i].second < bbox_min.x() ? 1. : 0.;
+        double tol1 = clipped[i + 1].second > bbox_max.x() ? 1. : 0.;
+        if (x0 >= x1)
+            continue;
+        while (j < anchored.size() && (anchored[j].first < line || (anchored[j].first == line && anchored[j + 1].second < x0 - tol0)))
+            j += 2;
+        if (! anchored_at(j, line, x0, tol0))
+            continue;
+        size_t k = j;
+        while (k < anchored.size() && anchored[k].first == line && anchored[k + 1].second < x1 - tol1)
+            k += 2;
+        if (anchored_at(k, line, x1, tol1)) {
+            // This line could be anchored.
+            double len = x1 - x0;
+            out.coverage  += len;
+            out.max_length = std::max(out.max_length, len);
+        }
+    }
+    return out;
+}
+
 std::vector<double> BridgeDetector::bridge_direction_candidates() const
 {
     // we test angles according to configured resolution
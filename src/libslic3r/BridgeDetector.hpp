@@ -7,6 +7,8 @@
 
 namespace Slic3r {
 
+struct ExecutionPolicy;
+
 // The bridge detector optimizes a direction of bridges over a region or a set of regions.
 // A bridge direction is considered optimal, if the length of the lines strang over the region is maximal.
 // This is optimal if the bridge is supported in a single direction only, but
@@ -32,6 +34,8 @@ public:
     BridgeDetector(const ExPolygons &_expolygons, const ExPolygons &_lower_slices, coord_t _extrusion_width);
     // If bridge_direction_override != 0, then the angle is used instead of auto-detect.
     bool detect_angle(double bridge_direction_override = 0.);
+    // Same as above, the candidate angles are evaluated in parallel following the execution policy.
+    bool detect_angle(const ExecutionPolicy &policy, double bridge_direction_override = 0.);
     Polygons coverage(double angle = -1) const;
     void unsupported_edges(double angle, Polylines* unsupported) const;
     Polylines unsupported_edges(double angle = -1) const;
@@ -56,6 +60,8 @@ private:
 
     // Get possible briging direction candidates.
     std::vector<double> bridge_direction_candidates() const;
+    // Sum the length of the test lines in the given direction, which are clipped by clip_area and anchored at both ends.
+    BridgeDirection evaluate_direction(double angle, const Polygons &clip_area, const Polygons &anchors) const;
 
     // Open lines representing the supporting edges.
     Polylines _edges;
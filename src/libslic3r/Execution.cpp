@@ -0,0 +1,42 @@
+#include "Execution.hpp"
+
+#include <memory>
+#include <thread>
+
+#include <tbb/global_control.h>
+
+namespace Slic3r {
+
+static ExecutionPolicy s_default_execution_policy;
+
+const ExecutionPolicy& default_execution_policy()
+{
+    return s_default_execution_policy;
+}
+
+void set_default_execution_policy(const ExecutionPolicy &policy)
+{
+    s_default_execution_policy = policy;
+}
+
+namespace execution {
+
+static size_t                               s_max_threads = 0;
+static std::unique_ptr<tbb::global_control> s_global_control;
+
+void set_max_threads(size_t nthreads)
+{
+    s_max_threads = nthreads;
+    if (nthreads == 0)
+        s_global_control.reset();
+    else
+        s_global_control = std::make_unique<tbb::global_control>(tbb::global_control::max_allowed_parallelism, nthreads);
+}
+
+size_t max_threads()
+{
+    return s_max_threads == 0 ? std::max<size_t>(std::thread::hardware_concurrency(), 1) : s_max_threads;
+}
+
+} // namespace execution
+} // namespace Slic3r
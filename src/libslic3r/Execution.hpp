@@ -0,0 +1,143 @@
+#ifndef slic3r_Execution_hpp_
+#define slic3r_Execution_hpp_
+
+#include <algorithm>
+#include <functional>
+
+// tbb/mutex.h includes Windows, which in turn defines min/max macros. Convince Windows.h to not define these min/max macros.
+#ifndef NOMINMAX
+    #define NOMINMAX
+#endif
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_arena.h>
+
+#include "libslic3r.h"
+
+namespace Slic3r {
+
+// Token to stop the parallel loops of a job early. The loops poll the token
+// before processing each chunk of the iteration range, the token throws
+// (usually a CanceledException) once the job has been canceled.
+class CancellationToken
+{
+public:
+    CancellationToken() = default;
+    explicit CancellationToken(std::function<void()> throw_if_canceled) : m_throw_if_canceled(std::move(throw_if_canceled)) {}
+
+    void throw_if_canceled() const { if (m_throw_if_canceled) m_throw_if_canceled(); }
+
+private:
+    std::function<void()> m_throw_if_canceled;
+};
+
+// Controls how the parallel algorithms of libslic3r are executed.
+struct ExecutionPolicy
+{
+    // Maximum number of threads working on a job, zero for the process wide limit.
+    size_t              max_threads   = 0;
+    // Minimum number of iterations of a parallel loop processed by a single task,
+    // zero to use the grain size of the particular loop.
+    size_t              grain_size    = 0;
+    // Partition the loops independently of the thread count and the scheduling
+    // and merge the partial results of the reductions in a fixed order.
+    bool                deterministic = false;
+    CancellationToken   cancel;
+};
+
+// Process wide execution policy, set from the command line.
+const ExecutionPolicy&  default_execution_policy();
+void                    set_default_execution_policy(const ExecutionPolicy &policy);
+
+namespace execution {
+
+// Limit the number of threads of the TBB thread pool for the whole process,
+// zero for the number of hardware threads. Call at the application startup,
+// before the thread pool is spinned up by name_tbb_thread_pool_threads().
+void    set_max_threads(size_t nthreads);
+// Number of threads of the TBB thread pool available to this process.
+size_t  max_threads();
+
+// Execute a job with the thread limit of the policy. The parallel algorithms
+// started from inside fn(), including the nested ones, share the limit.
+template<class Fn>
+void run(const ExecutionPolicy &policy, Fn &&fn)
+{
+    if (policy.max_threads == 0 || policy.max_threads >= max_threads())
+        fn();
+    else {
+        tbb::task_arena arena(int(policy.max_threads));
+        arena.execute(std::forward<Fn>(fn));
+    }
+}
+
+// Grain size of a loop over a range of the given size. In deterministic mode
+// the grain size does not depend on the thread count, as the range is split
+// down to the grain size.
+inline size_t grain_size(const ExecutionPolicy &policy, size_t range_size, size_t grain)
+{
+    grain = std::max(std::max(grain, policy.grain_size), size_t(1));
+    if (policy.deterministic)
+        grain = std::max(grain, range_size / 64);
+    return grain;
+}
+
+// tbb::parallel_for over a blocked range following the policy. The body
+// processes a whole chunk of the range, as with tbb::parallel_for.
+template<class I, class Body>
+void parallel_for(const ExecutionPolicy &policy, const tbb::blocked_range<I> &range, Body &&body)
+{
+    auto chunk = [&policy, &body](const tbb::blocked_range<I> &r) {
+        policy.cancel.throw_if_canceled();
+        body(r);
+    };
+    tbb::blocked_range<I> r(range.begin(), range.end(), grain_size(policy, range.size(), range.grainsize()));
+    if (policy.deterministic)
+        tbb::parallel_for(r, chunk, tbb::simple_partitioner());
+    else
+        tbb::parallel_for(r, chunk);
+}
+
+template<class Fn, class It>
+IteratorOnly<It, void> loop_(const tbb::blocked_range<It> &range, Fn &&fn)
+{
+    for (auto &el : range) fn(el);
+}
+
+template<class Fn, class I>
+IntegerOnly<I, void> loop_(const tbb::blocked_range<I> &range, Fn &&fn)
+{
+    for (I i = range.begin(); i < range.end(); ++i) fn(i);
+}
+
+// Call fn for each element (or index) of the range [from, to).
+template<class It, class Fn>
+void for_each(const ExecutionPolicy &policy, It from, It to, Fn &&fn, size_t granularity = 1)
+{
+    parallel_for(policy, tbb::blocked_range<It>{from, to, granularity},
+                 [&fn](const tbb::blocked_range<It> &range) { loop_(range, fn); });
+}
+
+// Merge the values of access(i) for each element (or index) of the range [from, to).
+// In deterministic mode the partial results are merged in the same order on each run.
+template<class I, class MergeFn, class T, class AccessFn>
+T reduce(const ExecutionPolicy &policy, I from, I to, const T &init, MergeFn &&mergefn, AccessFn &&access, size_t granularity = 1)
+{
+    auto chunk = [&policy, &mergefn, &access](const tbb::blocked_range<I> &range, T subinit) {
+        policy.cancel.throw_if_canceled();
+        T acc = subinit;
+        loop_(range, [&](auto &i) { acc = mergefn(acc, access(i)); });
+        return acc;
+    };
+    tbb::blocked_range<I> range(from, to, grain_size(policy, size_t(to - from), granularity));
+    return policy.deterministic ?
+        tbb::parallel_deterministic_reduce(range, init, chunk, mergefn) :
+        tbb::parallel_reduce(range, init, chunk, mergefn);
+}
+
+} // namespace execution
+} // namespace Slic3r
+
+#endif // slic3r_Execution_hpp_
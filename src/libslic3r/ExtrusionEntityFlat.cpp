@@ -0,0 +1,105 @@
+#include "ExtrusionEntityFlat.hpp"
+#include "ExtrusionEntityCollection.hpp"
+#include "Exception.hpp"
+
+namespace Slic3r {
+
+void ExtrusionEntitiesFlat::append(const ExtrusionEntity &extrusion_entity)
+{
+    if (const auto *path = dynamic_cast<const ExtrusionPath*>(&extrusion_entity); path != nullptr) {
+        m_entities.push_back({ etPath, elrDefault, uint32_t(this->num_paths()), uint32_t(this->num_paths() + 1) });
+        this->append_path(*path);
+    } else if (const auto *loop = dynamic_cast<const ExtrusionLoop*>(&extrusion_entity); loop != nullptr)
+        this->append_paths(etLoop, loop->loop_role(), loop->paths);
+    else if (const auto *multi_path = dynamic_cast<const ExtrusionMultiPath*>(&extrusion_entity); multi_path != nullptr)
+        this->append_paths(etMultiPath, elrDefault, multi_path->paths);
+    else if (const auto *collection = dynamic_cast<const ExtrusionEntityCollection*>(&extrusion_entity); collection != nullptr)
+        this->append(collection->entities);
+    else
+        throw Slic3r::RuntimeError("Unexpected extrusion_entity type in ExtrusionEntitiesFlat::append()");
+}
+
+void ExtrusionEntitiesFlat::clear()
+{
+    m_entities.clear();
+    m_path_roles.clear();
+    m_path_mm3_per_mm.clear();
+    m_path_widths.clear();
+    m_path_heights.clear();
+    m_path_points.assign(1, 0);
+    m_points.clear();
+}
+
+void ExtrusionEntitiesFlat::reserve(size_t num_entities, size_t num_paths, size_t num_points)
+{
+    m_entities.reserve(num_entities);
+    m_path_roles.reserve(num_paths);
+    m_path_mm3_per_mm.reserve(num_paths);
+    m_path_widths.reserve(num_paths);
+    m_path_heights.reserve(num_paths);
+    m_path_points.reserve(num_paths + 1);
+    m_points.reserve(num_points);
+}
+
+void ExtrusionEntitiesFlat::shrink_to_fit()
+{
+    m_entities.shrink_to_fit();
+    m_path_roles.shrink_to_fit();
+    m_path_mm3_per_mm.shrink_to_fit();
+    m_path_widths.shrink_to_fit();
+    m_path_heights.shrink_to_fit();
+    m_path_points.shrink_to_fit();
+    m_points.shrink_to_fit();
+}
+
+void ExtrusionEntitiesFlat::append_path(const ExtrusionPath &path)
+{
+    m_path_roles.emplace_back(path.role());
+    m_path_mm3_per_mm.emplace_back(path.mm3_per_mm);
+    m_path_widths.emplace_back(path.width);
+    m_path_heights.emplace_back(path.height);
+    m_points.insert(m_points.end(), path.polyline.points.begin(), path.polyline.points.end());
+    m_path_points.emplace_back(uint32_t(m_points.size()));
+}
+
+void ExtrusionEntitiesFlat::append_paths(EntityType type, ExtrusionLoopRole loop_role, const ExtrusionPaths &paths)
+{
+    if (paths.empty())
+        return;
+    m_entities.push_back({ type, loop_role, uint32_t(this->num_paths()), uint32_t(this->num_paths() + paths.size()) });
+    for (const ExtrusionPath &path : paths)
+        this->append_path(path);
+}
+
+ExtrusionPath ExtrusionEntitiesFlat::to_extrusion_path(size_t idx_path) const
+{
+    PathView      view = this->path(idx_path);
+    ExtrusionPath out(view.role, view.mm3_per_mm, view.width, view.height);
+    out.polyline.points.assign(view.points_begin, view.points_end);
+    return out;
+}
+
+ExtrusionEntity* ExtrusionEntitiesFlat::to_extrusion_entity(size_t idx) const
+{
+    const Entity  &entity = m_entities[idx];
+    ExtrusionPaths paths;
+    paths.reserve(entity.num_paths());
+    for (uint32_t idx_path = entity.path_begin; idx_path < entity.path_end; ++ idx_path)
+        paths.emplace_back(this->to_extrusion_path(idx_path));
+    switch (entity.type) {
+    case etPath:      return new ExtrusionPath(std::move(paths.front()));
+    case etMultiPath: { auto *multi_path = new ExtrusionMultiPath(); multi_path->paths = std::move(paths); return multi_path; }
+    case etLoop:      return new ExtrusionLoop(std::move(paths), entity.loop_role);
+    }
+    assert(false);
+    return nullptr;
+}
+
+void ExtrusionEntitiesFlat::to_extrusion_entity_collection(ExtrusionEntityCollection &out) const
+{
+    out.entities.reserve(out.entities.size() + m_entities.size());
+    for (size_t idx = 0; idx < m_entities.size(); ++ idx)
+        out.entities.emplace_back(this->to_extrusion_entity(idx));
+}
+
+} // namespace Slic3r
@@ -0,0 +1,113 @@
+#ifndef slic3r_ExtrusionEntityFlat_hpp_
+#define slic3r_ExtrusionEntityFlat_hpp_
+
+#include "libslic3r.h"
+#include "ExtrusionEntity.hpp"
+
+namespace Slic3r {
+
+class ExtrusionEntityCollection;
+
+// Flattened, read only copy of a tree of ExtrusionEntities.
+// The points of all the extrusion paths are stored in a single contiguous array and the attributes of the paths
+// (role and flow) are stored in parallel arrays. The extrusion entities (paths, multi-paths and loops) reference
+// continuous ranges of paths, the ExtrusionEntityCollections are flattened the same way as ExtrusionEntityCollection::flatten() does.
+// Traversal of the flattened extrusions requires neither virtual calls nor pointer chasing.
+// It is not the storage of the extrusions: LayerRegion and SupportLayer own the tree of ExtrusionEntities, which is
+// modified in place by the G-code generator. The toolpath preview builds a temporary flat copy of a layer
+// to generate the vertices of all instances of the layer from it.
+class ExtrusionEntitiesFlat
+{
+public:
+    enum EntityType : uint8_t {
+        etPath,
+        etMultiPath,
+        etLoop,
+    };
+
+    struct Entity {
+        EntityType          type;
+        ExtrusionLoopRole   loop_role;
+        // Range of paths of this entity.
+        uint32_t            path_begin;
+        uint32_t            path_end;
+
+        size_t              num_paths() const { return path_end - path_begin; }
+        bool                is_loop() const { return type == etLoop; }
+    };
+
+    // Lightweight view of a single path, referencing the data of the ExtrusionEntitiesFlat.
+    struct PathView {
+        ExtrusionRole       role;
+        double              mm3_per_mm;
+        float               width;
+        float               height;
+        const Point        *points_begin;
+        const Point        *points_end;
+
+        size_t              size() const { return points_end - points_begin; }
+        const Point&        first_point() const { return *points_begin; }
+        const Point&        last_point() const { return *(points_end - 1); }
+    };
+
+    ExtrusionEntitiesFlat() { m_path_points.emplace_back(0); }
+    explicit ExtrusionEntitiesFlat(const ExtrusionEntity &extrusion_entity) : ExtrusionEntitiesFlat() { this->append(extrusion_entity); }
+
+    // Append a copy of the extrusion entity. A collection is appended recursively.
+    void                append(const ExtrusionEntity &extrusion_entity);
+    void                append(const ExtrusionEntitiesPtr &extrusion_entities)
+        { for (const ExtrusionEntity *ee : extrusion_entities) this->append(*ee); }
+    void                clear();
+    // Reserve memory for the extrusions to be appended.
+    void                reserve(size_t num_entities, size_t num_paths, size_t num_points);
+    void                shrink_to_fit();
+
+    bool                empty()        const { return m_entities.empty(); }
+    size_t              num_entities() const { return m_entities.size(); }
+    size_t              num_paths()    const { return m_path_roles.size(); }
+    size_t              num_points()   const { return m_points.size(); }
+
+    const Entity&       entity(size_t idx) const { return m_entities[idx]; }
+    const std::vector<Entity>& entities() const { return m_entities; }
+    PathView            path(size_t idx) const {
+        return PathView { m_path_roles[idx], m_path_mm3_per_mm[idx], m_path_widths[idx], m_path_heights[idx],
+                          m_points.data() + m_path_points[idx], m_points.data() + m_path_points[idx + 1] };
+    }
+    // Role of an entity: Role of its first path.
+    ExtrusionRole       entity_role(size_t idx) const { return m_path_roles[m_entities[idx].path_begin]; }
+    // All points of all paths.
+    const Points&       points() const { return m_points; }
+
+    // Call fn(const Entity &entity, const PathView &path) for each path of each entity.
+    template<typename FN>
+    void                for_each_path(FN &&fn) const {
+        for (const Entity &entity : m_entities)
+            for (uint32_t idx_path = entity.path_begin; idx_path < entity.path_end; ++ idx_path)
+                fn(entity, this->path(idx_path));
+    }
+
+    // Convert an entity back to the polymorphic representation, for example to be extruded by the G-code generator.
+    // The caller takes ownership of the returned object.
+    ExtrusionEntity*    to_extrusion_entity(size_t idx) const;
+    ExtrusionPath       to_extrusion_path(size_t idx_path) const;
+    void                to_extrusion_entity_collection(ExtrusionEntityCollection &out) const;
+
+private:
+    void                append_path(const ExtrusionPath &path);
+    void                append_paths(EntityType type, ExtrusionLoopRole loop_role, const ExtrusionPaths &paths);
+
+    std::vector<Entity>         m_entities;
+    // Attributes of the paths.
+    std::vector<ExtrusionRole>  m_path_roles;
+    std::vector<double>         m_path_mm3_per_mm;
+    std::vector<float>          m_path_widths;
+    std::vector<float>          m_path_heights;
+    // Index of the first point of a path into m_points, terminated by m_points.size().
+    std::vector<uint32_t>       m_path_points;
+    // Points of all paths.
+    Points                      m_points;
+};
+
+} // namespace Slic3r
+
+#endif // slic3r_ExtrusionEntityFlat_hpp_
@@ -1,5 +1,6 @@
 #include "../ClipperUtils.hpp"
 #include "../ExPolygon.hpp"
+#include "../Execution.hpp"
 #include "../Surface.hpp"
 #include "../Geometry.hpp"
 #include "../Layer.hpp"
@@ -25,6 +26,8 @@
 #include <boost/geometry/geometries/segment.hpp>
 #include <boost/geometry/index/rtree.hpp>
 
+#include <tbb/enumerable_thread_specific.h>
+
 
 namespace Slic3r {
 namespace FillAdaptive {
@@ -262,6 +265,8 @@ struct Octree
     Cube*                       root_cube { nullptr };
     Vec3d                       origin;
     std::vector<CubeProperties> cubes_properties;
+    // Octrees built in parallel by build_octree() and merged into this one. They own the Cubes adopted by this octree.
+    std::vector<std::unique_ptr<Octree>> subtrees;
 
     Octree(const Vec3d &origin, const std::vector<CubeProperties> &cubes_properties)
         : root_cube(pool.construct(origin)), origin(origin), cubes_properties(cubes_properties) {}
@@ -1457,6 +1462,18 @@ static void transform_center(Cube *current_cube, const Eigen::Matrix3d &rot)
             transform_center(child, rot);
 }
 
+// Merge the cubes of src into dst. The cubes of src missing in dst are adopted by dst together with their children.
+static void merge_cubes(Cube *dst, Cube *src)
+{
+    for (size_t i = 0; i < 8; ++ i)
+        if (Cube *child = src->children[i]; child) {
+            if (dst->children[i])
+                merge_cubes(dst->children[i], child);
+            else
+                dst->children[i] = child;
+        }
+}
+
 OctreePtr build_octree(
     // Mesh is rotated to the coordinate system of the octree.
     const indexed_triangle_set  &triangle_mesh,
@@ -1464,7 +1481,8 @@ OctreePtr build_octree(
     // rotated to the coordinate system of the octree.
     const std::vector<Vec3d>    &overhang_triangles, 
     coordf_t                     line_spacing,
-    bool                         support_overhangs_only)
+    bool                         support_overhangs_only,
+    const ExecutionPolicy       &policy)
 {
     assert(line_spacing > 0);
     assert(! std::isnan(line_spacing));
@@ -1475,27 +1493,46 @@ OctreePtr build_octree(
     auto                        octree           = OctreePtr(new Octree(cube_center, cubes_properties));
 
     if (cubes_properties.size() > 1) {
-        Octree *octree_ptr = octree.get();
         double edge_length_half = 0.5 * cubes_properties.back().edge_length;
         Vec3d  diag_half(edge_length_half, edge_length_half, edge_length_half);
         int    max_depth = int(cubes_properties.size()) - 1;
-        auto process_triangle = [octree_ptr, max_depth, diag_half](const Vec3d &a, const Vec3d &b, const Vec3d &c) {
-            octree_ptr->insert_triangle(
-                a, b, c,
-                octree_ptr->root_cube,
-                BoundingBoxf3(octree_ptr->root_cube->center - diag_half, octree_ptr->root_cube->center + diag_half),
-                max_depth);
-        };
-        auto up_vector = support_overhangs_only ? Vec3d(transform_to_octree() * Vec3d(0., 0., 1.)) : Vec3d();
-        for (auto &tri : triangle_mesh.indices) {
-            auto a = triangle_mesh.vertices[tri[0]].cast<double>();
-            auto b = triangle_mesh.vertices[tri[1]].cast<double>();
-            auto c = triangle_mesh.vertices[tri[2]].cast<double>();
-            if (! support_overhangs_only || is_overhang_triangle(a, b, c, up_vector))
-                process_triangle(a, b, c);
-        }
-        for (size_t i = 0; i < overhang_triangles.size(); i += 3)
-            process_triangle(overhang_triangles[i], overhang_triangles[i + 1], overhang_triangles[i + 2]);
+        auto   up_vector = support_overhangs_only ? Vec3d(transform_to_octree() * Vec3d(0., 0., 1.)) : Vec3d();
+        size_t num_mesh_triangles = triangle_mesh.indices.size();
+        size_t num_triangles      = num_mesh_triangles + overhang_triangles.size() / 3;
+        // The triangles are inserted into subtrees in parallel, each thread allocating the Cubes of its subtree from its own pool.
+        // The Cubes created by a triangle do not depend on the other triangles, therefore the merged subtrees
+        // are the same as an octree built by inserting all the triangles sequentially.
+        tbb::enumerable_thread_specific<std::unique_ptr<Octree>> subtrees;
+        execution::parallel_for(policy, tbb::blocked_range<size_t>(0, num_triangles, 1024),
+            [&](const tbb::blocked_range<size_t> &range) {
+                std::unique_ptr<Octree> &subtree = subtrees.local();
+                if (! subtree)
+                    subtree = std::make_unique<Octree>(cube_center, cubes_properties);
+                auto process_triangle = [&subtree, max_depth, diag_half](const Vec3d &a, const Vec3d &b, const Vec3d &c) {
+                    subtree->insert_triangle(
+                        a, b, c,
+                        subtree->root_cube,
+                        BoundingBoxf3(subtree->root_cube->center - diag_half, subtree->root_cube->center + diag_half),
+                        max_depth);
+                };
+                for (size_t i = range.begin(); i < range.end(); ++ i)
+                    if (i < num_mesh_triangles) {
+                        const stl_triangle_vertex_indices &tri = triangle_mesh.indices[i];
+                        auto a = triangle_mesh.vertices[tri[0]].cast<double>();
+                        auto b = triangle_mesh.vertices[tri[1]].cast<double>();
+                        auto c = triangle_mesh.vertices[tri[2]].cast<double>();
+                        if (! support_overhangs_only || is_overhang_triangle(a, b, c, up_vector))
+                            process_triangle(a, b, c);
+                    } else {
+                        size_t j = 3 * (i - num_mesh_triangles);
+                        process_triangle(overhang_triangles[j], overhang_triangles[j + 1], overhang_triangles[j + 2]);
+                    }
+            });
+        for (std::unique_ptr<Octree> &subtree : subtrees)
+            if (subtree) {
+                merge_cubes(octree->root_cube, subtree->root_cube);
+                octree->subtrees.emplace_back(std::move(subtree));
+            }
         {
             // Transform the octree to world coordinates to reduce computation when extracting infill lines.
             auto rot = transform_to_world().toRotationMatrix();
@@ -17,6 +17,7 @@ struct indexed_triangle_set;
 
 namespace Slic3r {
 
+struct ExecutionPolicy;
 class PrintObject;
 
 namespace FillAdaptive
@@ -46,7 +47,9 @@ FillAdaptive::OctreePtr         build_octree(
     const std::vector<Vec3d>    &overhang_triangles, 
     coordf_t                     line_spacing, 
     // If true, octree is densified below internal overhangs only.
-    bool                         support_overhangs_only);
+    bool                         support_overhangs_only,
+    // The triangles are inserted in parallel following the policy.
+    const ExecutionPolicy       &policy);
 
 //
 // Some of the algorithms used by class FillAdaptive were inspired by
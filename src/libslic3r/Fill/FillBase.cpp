@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <numeric>
+#include <tuple>
 
 #include "../ClipperUtils.hpp"
 #include "../EdgeGrid.hpp"
@@ -21,6 +22,34 @@
 
 namespace Slic3r {
 
+bool FillPatternCache::Key::operator<(const Key &rhs) const
+{
+    auto tuple = [](const Key &k) {
+        return std::make_tuple(int(k.pattern), k.spacing, k.density, k.angle, k.bbox.min.x(), k.bbox.min.y(), k.bbox.max.x(), k.bbox.max.y());
+    };
+    return tuple(*this) < tuple(rhs);
+}
+
+FillPatternCache::Pattern FillPatternCache::get(const Key &key, const std::function<Polylines()> &generate)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_patterns.find(key);
+        if (it != m_patterns.end()) {
+            ++ m_hits;
+            return it->second;
+        }
+    }
+    // Generate outside of the lock. If two threads generate the same pattern, both generate the same polylines.
+    ++ m_misses;
+    auto pattern = std::make_shared<const Polylines>(generate());
+    size_t num_points = std::accumulate(pattern->begin(), pattern->end(), size_t(0), [](size_t n, const Polyline &pl) { return n + pl.points.size(); });
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_num_points + num_points <= m_max_points && m_patterns.emplace(key, pattern).second)
+        m_num_points += num_points;
+    return pattern;
+}
+
 Fill* Fill::new_from_type(const InfillPattern type)
 {
     switch (type) {
@@ -7,11 +7,17 @@
 #include <stdint.h>
 #include <stdexcept>
 
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <type_traits>
 
 #include "../libslic3r.h"
 #include "../BoundingBox.hpp"
 #include "../Exception.hpp"
+#include "../Polyline.hpp"
 #include "../Utils.hpp"
 
 namespace Slic3r {
@@ -30,6 +36,16 @@ public:
     InfillFailedException() : Slic3r::RuntimeError("Infill failed") {}
 };
 
+// Algorithm ordering the monotonic infill regions, see FillMonotonic.
+enum class MonotonicOrdering : unsigned char {
+    // Ant colony for a low number of regions, local search otherwise.
+    Auto,
+    // Ant colony optimization, cost grows quickly with the number of regions.
+    AntColony,
+    // Greedy order refined by a local search with a bounded number of steps.
+    LocalSearch,
+};
+
 struct FillParams
 {
     bool        full_infill() const { return density > 0.9999f; }
@@ -49,6 +65,7 @@ struct FillParams
 
     // Monotonic infill - strictly left to right for better surface quality of top infills.
     bool 		monotonic		{ false };
+    MonotonicOrdering monotonic_ordering { MonotonicOrdering::Auto };
 
     // For Honeycomb.
     // we were requested to complete each loop;
@@ -57,6 +74,41 @@ struct FillParams
 };
 static_assert(IsTriviallyCopyable<FillParams>::value, "FillParams class is not POD (and it should be - see constructor).");
 
+// Infill patterns before clipping with the surfaces to be filled, shared by the layers and regions of a PrintObject.
+// The patterns are generated over a bounding box aligned to the pattern grid, therefore the layers of a prismatic object
+// share the pattern and only clip it with their surfaces. Only the patterns not depending on Z are cached. Thread safe.
+class FillPatternCache
+{
+public:
+    struct Key {
+        InfillPattern   pattern;
+        coordf_t        spacing;
+        float           density;
+        float           angle;
+        BoundingBox     bbox;
+
+        bool operator<(const Key &rhs) const;
+    };
+    using Pattern = std::shared_ptr<const Polylines>;
+
+    // Stop caching new patterns once the cached patterns contain max_points points.
+    explicit FillPatternCache(size_t max_points = 8 * 1024 * 1024) : m_max_points(max_points) {}
+
+    // Return the cached pattern, otherwise generate it with generate() and cache it.
+    Pattern get(const Key &key, const std::function<Polylines()> &generate);
+
+    size_t  hits()   const { return m_hits; }
+    size_t  misses() const { return m_misses; }
+
+private:
+    std::mutex                  m_mutex;
+    std::map<Key, Pattern>      m_patterns;
+    size_t                      m_num_points { 0 };
+    const size_t                m_max_points;
+    std::atomic<size_t>         m_hits   { 0 };
+    std::atomic<size_t>         m_misses { 0 };
+};
+
 class Fill
 {
 public:
@@ -82,6 +134,9 @@ public:
     // Octree builds on mesh for usage in the adaptive cubic infill
     FillAdaptive::Octree* adapt_fill_octree = nullptr;
 
+    // Cache of the unclipped patterns shared with the other layers, may be null.
+    FillPatternCache* pattern_cache = nullptr;
+
 public:
     virtual ~Fill() {}
     virtual Fill* clone() const = 0;
@@ -128,6 +183,10 @@ protected:
 
     virtual std::pair<float, Point> _infill_direction(const Surface *surface) const;
 
+    // Take the unclipped pattern from the pattern cache if available, otherwise generate it.
+    FillPatternCache::Pattern _pattern(const FillPatternCache::Key &key, const std::function<Polylines()> &generate) const
+        { return this->pattern_cache ? this->pattern_cache->get(key, generate) : std::make_shared<const Polylines>(generate()); }
+
 public:
     static void connect_infill(Polylines &&infill_ordered, const ExPolygon &boundary, Polylines &polylines_out, const double spacing, const FillParams &params);
     static void connect_infill(Polylines &&infill_ordered, const Polygons &boundary, const BoundingBox& bbox, Polylines &polylines_out, const double spacing, const FillParams &params);
@@ -49,13 +49,13 @@ static inline Polyline make_wave(
     }
 
     // and construct the final polyline to return:
+    // The wave is emitted monotonic in Y, see make_gyroid_waves().
     Polyline polyline;
     polyline.points.reserve(points.size());
     for (auto& point : points) {
         point(1) += offset;
         point(1) = clamp(0., height, double(point(1)));
-        if (vertical)
-            std::swap(point(0), point(1));
+        std::swap(point(0), point(1));
         polyline.points.emplace_back((point * scaleFactor).cast<coord_t>());
     }
 
@@ -75,33 +75,65 @@ static std::vector<Vec2d> make_one_period(double width, double scaleFactor, doub
     points.emplace_back(Vec2d(limit, f(limit, z_sin, z_cos, vertical, flip)));
 
     // piecewise increase in resolution up to requested tolerance
-    for(;;)
+    // The split test of a segment depends on its end points only, thus only the segments split in the previous round are tested.
+    // The midpoints of the segments to be tested are evaluated in a batch.
+    std::vector<unsigned char> test_segment(points.size() - 1, true);
+    std::vector<double>        xs, ys;
+    std::vector<Vec2d>         points_new;
+    std::vector<unsigned char> test_segment_new;
+    for (;;)
     {
-        size_t size = points.size();
-        for (unsigned int i = 1;i < size; ++i) {
+        xs.clear();
+        for (size_t i = 1; i < points.size(); ++ i)
+            if (test_segment[i - 1])
+                xs.emplace_back(points[i - 1](0) + (points[i](0) - points[i - 1](0)) / 2);
+        ys.assign(xs.size(), 0.);
+        for (size_t i = 0; i < xs.size(); ++ i)
+            ys[i] = f(xs[i], z_sin, z_cos, vertical, flip);
+
+        points_new.clear();
+        test_segment_new.clear();
+        points_new.reserve(points.size() + xs.size());
+        test_segment_new.reserve(points.size() + xs.size());
+        bool refined = false;
+        for (size_t i = 1, j = 0; i < points.size(); ++ i) {
             auto& lp = points[i-1]; // left point
             auto& rp = points[i];   // right point
-            double x = lp(0) + (rp(0) - lp(0)) / 2;
-            double y = f(x, z_sin, z_cos, vertical, flip);
-            Vec2d ip = {x, y};
-            if (std::abs(cross2(Vec2d(ip - lp), Vec2d(ip - rp))) > sqr(tolerance)) {
-                points.emplace_back(std::move(ip));
+            points_new.emplace_back(lp);
+            if (test_segment[i - 1]) {
+                Vec2d ip = { xs[j], ys[j] };
+                ++ j;
+                if (std::abs(cross2(Vec2d(ip - lp), Vec2d(ip - rp))) > sqr(tolerance)) {
+                    points_new.emplace_back(ip);
+                    test_segment_new.emplace_back(true);
+                    test_segment_new.emplace_back(true);
+                    refined = true;
+                    continue;
+                }
             }
+            test_segment_new.emplace_back(false);
         }
+        points_new.emplace_back(points.back());
 
-        if (size == points.size())
+        if (! refined)
             break;
-        else
-        {
-            // insert new points in order
-            std::sort(points.begin(), points.end(),
-                      [](const Vec2d &lhs, const Vec2d &rhs) { return lhs(0) < rhs(0); });
-        }
+        points.swap(points_new);
+        test_segment.swap(test_segment_new);
     }
 
     return points;
 }
 
+// The waves are horizontal (monotonic in X) or vertical (monotonic in Y) depending on the phase of the pattern in Z.
+static inline bool gyroid_waves_vertical(double gridZ, double scaleFactor)
+{
+    const double z = gridZ / scaleFactor;
+    return std::abs(sin(z)) <= std::abs(cos(z));
+}
+
+// Generate the waves over the (width, height) rectangle. All the waves are generated monotonic in Y, which is the sweep
+// direction of Clipper. Clipping of the waves monotonic in X is slower, therefore the horizontal waves are generated
+// transposed (with X and Y swapped).
 static Polylines make_gyroid_waves(double gridZ, double density_adjusted, double line_spacing, double width, double height)
 {
     const double scaleFactor = scale_(line_spacing) / density_adjusted;
@@ -116,7 +148,7 @@ static Polylines make_gyroid_waves(double gridZ, double density_adjusted, double
     const double z_sin = sin(z);
     const double z_cos = cos(z);
 
-    bool vertical = (std::abs(z_sin) <= std::abs(z_cos));
+    bool vertical = gyroid_waves_vertical(gridZ, scaleFactor);
     double lower_bound = 0.;
     double upper_bound = height;
     bool flip = true;
@@ -168,19 +200,34 @@ void FillGyroid::_fill_surface_single(
     // align bounding box to a multiple of our grid module
     bb.merge(_align_to_grid(bb.min, Point(2*M_PI*distance, 2*M_PI*distance)));
 
+    // The horizontal waves are generated transposed, see make_gyroid_waves().
+    bool        transposed = ! gyroid_waves_vertical(scale_(this->z), scale_(this->spacing) / density_adjusted);
+    auto        transpose  = [](Points &pts) { for (Point &pt : pts) std::swap(pt.x(), pt.y()); };
+
     // generate pattern
-    Polylines polylines = make_gyroid_waves(
+    // The pattern is not shared through the FillPatternCache: It depends on Z, thus the layers would never share it.
+    Polylines pattern = make_gyroid_waves(
         scale_(this->z),
         density_adjusted,
         this->spacing,
         ceil(bb.size()(0) / distance) + 1.,
         ceil(bb.size()(1) / distance) + 1.);
 
-	// shift the polyline to the grid origin
-	for (Polyline &pl : polylines)
-		pl.translate(bb.min);
+    // shift the polyline to the grid origin
+    Point origin = transposed ? Point(bb.min.y(), bb.min.x()) : bb.min;
+    for (Polyline &pl : pattern)
+        pl.translate(origin);
 
-	polylines = intersection_pl(polylines, to_polygons(expolygon));
+    // Clip all the waves in a single pass. Transposing the clipping polygons reverses their orientation,
+    // which does not change the result of the non-zero fill rule.
+    Polygons  clip = to_polygons(expolygon);
+    if (transposed)
+        for (Polygon &polygon : clip)
+            transpose(polygon.points);
+    Polylines polylines = intersection_pl(pattern, clip);
+    if (transposed)
+        for (Polyline &pl : polylines)
+            transpose(pl.points);
 
     if (! polylines.empty()) {
 		// Remove very small bits, but be careful to not remove infill lines connecting thin walls!
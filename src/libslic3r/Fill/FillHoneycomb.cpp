@@ -1,4 +1,5 @@
 #include "../ClipperUtils.hpp"
+#include "../PrintConfig.hpp"
 #include "../ShortestPath.hpp"
 #include "../Surface.hpp"
 
@@ -32,24 +33,23 @@ void FillHoneycomb::_fill_surface_single(
     }
     CacheData &m = it_m->second;
 
-    Polylines all_polylines;
+    // adjust actual bounding box to the nearest multiple of our hex pattern
+    // and align it so that it matches across layers
+    BoundingBox bounding_box = expolygon.contour.bounding_box();
     {
-        // adjust actual bounding box to the nearest multiple of our hex pattern
-        // and align it so that it matches across layers
+        // rotate bounding box according to infill direction
+        Polygon bb_polygon = bounding_box.polygon();
+        bb_polygon.rotate(direction.first, m.hex_center);
+        bounding_box = bb_polygon.bounding_box();
         
-        BoundingBox bounding_box = expolygon.contour.bounding_box();
-        {
-            // rotate bounding box according to infill direction
-            Polygon bb_polygon = bounding_box.polygon();
-            bb_polygon.rotate(direction.first, m.hex_center);
-            bounding_box = bb_polygon.bounding_box();
-            
-            // extend bounding box so that our pattern will be aligned with other layers
-            // $bounding_box->[X1] and [Y1] represent the displacement between new bounding box offset and old one
-            // The infill is not aligned to the object bounding box, but to a world coordinate system. Supposedly good enough.
-            bounding_box.merge(_align_to_grid(bounding_box.min, Point(m.hex_width, m.pattern_height)));
-        }
+        // extend bounding box so that our pattern will be aligned with other layers
+        // $bounding_box->[X1] and [Y1] represent the displacement between new bounding box offset and old one
+        // The infill is not aligned to the object bounding box, but to a world coordinate system. Supposedly good enough.
+        bounding_box.merge(_align_to_grid(bounding_box.min, Point(m.hex_width, m.pattern_height)));
+    }
 
+    FillPatternCache::Pattern pattern = this->_pattern({ ipHoneycomb, this->spacing, params.density, direction.first, bounding_box }, [&m, &bounding_box, &direction]() {
+        Polylines all_polylines;
         coord_t x = bounding_box.min(0);
         while (x <= bounding_box.max(0)) {
             Polyline p;
@@ -71,9 +71,10 @@ void FillHoneycomb::_fill_surface_single(
             p.rotate(-direction.first, m.hex_center);
             all_polylines.push_back(p);
         }
-    }
+        return all_polylines;
+    });
     
-    all_polylines = intersection_pl(std::move(all_polylines), to_polygons(expolygon));
+    Polylines all_polylines = intersection_pl(*pattern, to_polygons(expolygon));
     if (params.dont_connect() || all_polylines.size() <= 1)
         append(polylines_out, chain_polylines(std::move(all_polylines)));
     else
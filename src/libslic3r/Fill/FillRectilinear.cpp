@@ -2,6 +2,8 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <limits>
 #include <random>
@@ -1585,6 +1587,26 @@ struct MonotonicRegionLink
     AntPath 			*next_flipped;
 };
 
+// Length of a link from the right side of region_from to the left side of region_to, unscaled.
+// The length is measured along the perimeter if such perimeter segment exists, otherwise the Eucledian distance of the end points is returned.
+static float monotonic_region_link_length(
+	const ExPolygonWithOffset &poly_with_offset, const std::vector<SegmentedIntersectionLine> &segs,
+	const MonotonicRegion &region_from, bool flipped_from, const MonotonicRegion &region_to, bool flipped_to)
+{
+	int i_from = region_from.right_intersection_point(flipped_from);
+	int i_to   = region_to.left_intersection_point(flipped_to);
+	const SegmentedIntersectionLine &vline_from = segs[region_from.right.vline];
+	const SegmentedIntersectionLine &vline_to   = segs[region_to.left.vline];
+	if (region_from.right.vline + 1 == region_from.left.vline) {
+		int i_right = vline_from.intersections[i_from].right_horizontal();
+		if (i_right == i_to && vline_from.intersections[i_from].next_on_contour_quality == SegmentIntersection::LinkQuality::Valid)
+			// Measure length along the contour.
+            return unscale<float>(measure_perimeter_horizontal_segment_length(poly_with_offset, segs, region_from.right.vline, i_from, i_to));
+	}
+	// Just apply the Eucledian distance of the end points.
+    return unscale<float>(Vec2f(vline_to.pos - vline_from.pos, vline_to.intersections[i_to].pos() - vline_from.intersections[i_from].pos()).norm());
+}
+
 // Matrix of paths (AntPath) connecting ends of MontonousRegions.
 // AntPath lengths and their derived visibilities refer to the length of the perimeter line if such perimeter segment exists.
 class AntPathMatrix
@@ -1614,21 +1636,7 @@ public:
 		AntPath &path = m_matrix[row * m_regions.size() * 2 + col];
 		if (path.length == -1.) {
 			// This path is accessed for the first time. Update the length and cost.
-			int i_from = region_from.right_intersection_point(flipped_from);
-			int i_to   = region_to.left_intersection_point(flipped_to);
-			const SegmentedIntersectionLine &vline_from = m_segs[region_from.right.vline];
-			const SegmentedIntersectionLine &vline_to   = m_segs[region_to.left.vline];
-			if (region_from.right.vline + 1 == region_from.left.vline) {
-				int i_right = vline_from.intersections[i_from].right_horizontal();
-				if (i_right == i_to && vline_from.intersections[i_from].next_on_contour_quality == SegmentIntersection::LinkQuality::Valid) {
-					// Measure length along the contour.
-	                path.length = unscale<float>(measure_perimeter_horizontal_segment_length(m_poly_with_offset, m_segs, region_from.right.vline, i_from, i_to));
-				}
-			}
-			if (path.length == -1.) {
-				// Just apply the Eucledian distance of the end points.
-			    path.length = unscale<float>(Vec2f(vline_to.pos - vline_from.pos, vline_to.intersections[i_to].pos() - vline_from.intersections[i_from].pos()).norm());
-			}
+			path.length     = monotonic_region_link_length(m_poly_with_offset, m_segs, region_from, flipped_from, region_to, flipped_to);
 			path.visibility = 1.f / (path.length + float(EPSILON));
 		}
 		return path;
@@ -2521,6 +2529,223 @@ end:
     return best_path;
 }
 
+// Find a run through monotonic infill blocks by a greedy search, refined by a local search: flipping the zig-zags of a single region
+// and moving short chains of regions (Or-opt) while maintaining the ordering constraints. Contrary to the ant colony optimization,
+// the number of link lengths evaluated grows linearly with the number of regions. The search is deterministic.
+static std::vector<MonotonicRegionLink> chain_monotonic_regions_local_search(
+	std::vector<MonotonicRegion> &regions, const ExPolygonWithOffset &poly_with_offset, const std::vector<SegmentedIntersectionLine> &segs)
+{
+	// Maximum number of regions moved at once by the Or-opt step.
+	constexpr int    or_opt_max_chain 	= 3;
+	// How far to move a chain of regions by the Or-opt step.
+	constexpr int    or_opt_window    	= 32;
+	// Maximum number of improving passes over the whole path.
+	constexpr int    num_passes_max   	= 8;
+	// Budget of link length evaluations of the local search per region.
+	constexpr size_t evaluations_per_region = 512;
+
+	auto region_idx = [&regions](const MonotonicRegion *region) { return size_t(region - regions.data()); };
+	size_t num_evaluations = 0;
+	auto link_length = [&poly_with_offset, &segs, &num_evaluations](const MonotonicRegionLink &from, const MonotonicRegionLink &to) {
+		++ num_evaluations;
+		return monotonic_region_link_length(poly_with_offset, segs, *from.region, from.flipped, *to.region, to.flipped);
+	};
+
+	std::vector<MonotonicRegionLink> path;
+	path.reserve(regions.size());
+
+	// Greedy path: Prefer the right neighbors of the last region, which had their constraints satisfied by the last region,
+	// take the closest region from the queue of regions with their constraints satisfied otherwise.
+	{
+		// Number of left neighbors not printed yet.
+		std::vector<int32_t> 		  left_neighbors_unprocessed(regions.size(), 0);
+		std::vector<MonotonicRegion*> queue;
+		queue.reserve(regions.size());
+		for (MonotonicRegion &region : regions)
+			if (region.left_neighbors.empty())
+				queue.emplace_back(&region);
+			else
+				left_neighbors_unprocessed[region_idx(&region)] = int32_t(region.left_neighbors.size());
+		// Start with the leftmost region.
+		size_t num_released = 0;
+		{
+			auto it = std::min_element(queue.begin(), queue.end(), [](const MonotonicRegion *l, const MonotonicRegion *r) { return l->left.vline < r->left.vline; });
+			std::swap(*it, queue.back());
+			num_released = 1;
+		}
+		while (! queue.empty()) {
+			// Candidates are the regions released by the last region, or the whole queue if none was released.
+			size_t 			 	 first 		  = num_released > 0 ? queue.size() - num_released : 0;
+			size_t 				 best_idx 	  = first;
+			MonotonicRegionLink  best 		  { queue[first], false };
+			if (! path.empty()) {
+				float best_length = std::numeric_limits<float>::max();
+				for (size_t i = first; i < queue.size(); ++ i)
+					for (bool dir : { false, true }) {
+						MonotonicRegionLink next { queue[i], dir };
+						float l = link_length(path.back(), next);
+						if (l < best_length) {
+							best_length = l;
+							best_idx    = i;
+							best        = next;
+						}
+					}
+			}
+			queue[best_idx] = queue.back();
+			queue.pop_back();
+			path.emplace_back(best);
+			num_released = 0;
+			for (MonotonicRegion *next : best.region->right_neighbors)
+				if (-- left_neighbors_unprocessed[region_idx(next)] == 0) {
+					queue.emplace_back(next);
+					++ num_released;
+				}
+		}
+		assert(path.size() == regions.size());
+	}
+
+	// Local search.
+	const size_t 		num_evaluations_max = num_evaluations + evaluations_per_region * regions.size();
+	const int 			n = int(path.size());
+	// Position of a region on the path.
+	std::vector<int> 	pos(regions.size());
+	for (int i = 0; i < n; ++ i)
+		pos[region_idx(path[i].region)] = i;
+	// Length of the link from path[i] to path[j], zero if either of them is outside of the path.
+	auto path_link = [&path, &link_length, n](int i, int j) {
+		return (i < 0 || j < 0 || i >= n || j >= n) ? 0.f : link_length(path[i], path[j]);
+	};
+	for (int pass = 0; pass < num_passes_max && num_evaluations < num_evaluations_max; ++ pass) {
+		bool improved = false;
+		// Flip the zig-zags of a single region.
+		for (int i = 0; i < n && num_evaluations < num_evaluations_max; ++ i) {
+			MonotonicRegionLink &link = path[i];
+			float old_length = link.region->length(link.flipped) + path_link(i - 1, i) + path_link(i, i + 1);
+			link.flipped = ! link.flipped;
+			float new_length = link.region->length(link.flipped) + path_link(i - 1, i) + path_link(i, i + 1);
+			if (new_length < old_length - float(EPSILON))
+				improved = true;
+			else
+				link.flipped = ! link.flipped;
+		}
+		// Or-opt: Move a chain of up to or_opt_max_chain regions to another position on the path.
+		for (int k = 1; k <= or_opt_max_chain; ++ k)
+			for (int i = 0; i + k <= n && num_evaluations < num_evaluations_max; ++ i) {
+				// The chain may be moved to the left up to the rightmost left neighbor, to the right up to the leftmost right neighbor.
+				int lo = 0;
+				int hi = n;
+				for (int j = i; j < i + k; ++ j) {
+					for (const MonotonicRegion *left : path[j].region->left_neighbors)
+						if (int p = pos[region_idx(left)]; p < i)
+							lo = std::max(lo, p + 1);
+					for (const MonotonicRegion *right : path[j].region->right_neighbors)
+						if (int p = pos[region_idx(right)]; p >= i + k)
+							hi = std::min(hi, p);
+				}
+				lo = std::max(lo, i - or_opt_window);
+				hi = std::min(hi, i + k + or_opt_window);
+				// Gain of removing the chain from the path.
+				float gain = path_link(i - 1, i) + path_link(i + k - 1, i + k) - path_link(i - 1, i + k);
+				float best_delta = - float(EPSILON);
+				int   best_j     = -1;
+				// Insert the chain in front of path[j].
+				for (int j = lo; j < i; ++ j) {
+					float delta = path_link(j - 1, i) + path_link(i + k - 1, j) - path_link(j - 1, j) - gain;
+					if (delta < best_delta) {
+						best_delta = delta;
+						best_j     = j;
+					}
+				}
+				// Insert the chain behind path[j].
+				for (int j = i + k; j < hi; ++ j) {
+					float delta = path_link(j, i) + path_link(i + k - 1, j + 1) - path_link(j, j + 1) - gain;
+					if (delta < best_delta) {
+						best_delta = delta;
+						best_j     = j;
+					}
+				}
+				if (best_j != -1) {
+					int from, to;
+					if (best_j < i) {
+						std::rotate(path.begin() + best_j, path.begin() + i, path.begin() + i + k);
+						from = best_j;
+						to   = i + k;
+					} else {
+						std::rotate(path.begin() + i, path.begin() + i + k, path.begin() + best_j + 1);
+						from = i;
+						to   = best_j + 1;
+					}
+					for (int j = from; j < to; ++ j)
+						pos[region_idx(path[j].region)] = j;
+					improved = true;
+				}
+			}
+		if (! improved)
+			break;
+	}
+
+#ifndef NDEBUG
+	// Verify the ordering constraints.
+	for (int i = 0; i < n; ++ i)
+		for (const MonotonicRegion *left : path[i].region->left_neighbors)
+			assert(pos[region_idx(left)] < i);
+#endif /* NDEBUG */
+
+	return path;
+}
+
+static std::atomic<size_t>   s_monotonic_ordering_calls[2];
+static std::atomic<size_t>   s_monotonic_ordering_regions[2];
+// Length of the links in micrometers, time in microseconds.
+static std::atomic<uint64_t> s_monotonic_ordering_links_length[2];
+static std::atomic<uint64_t> s_monotonic_ordering_time[2];
+
+MonotonicOrderingStatistics monotonic_ordering_statistics()
+{
+	MonotonicOrderingStatistics out;
+	for (int i = 0; i < 2; ++ i) {
+		MonotonicOrderingStatistics::Engine &engine = i == 0 ? out.ant_colony : out.local_search;
+		engine.calls        = s_monotonic_ordering_calls[i];
+		engine.regions      = s_monotonic_ordering_regions[i];
+		engine.links_length = double(s_monotonic_ordering_links_length[i]) * 0.001;
+		engine.time         = double(s_monotonic_ordering_time[i]) * 0.000001;
+	}
+	return out;
+}
+
+MonotonicOrderingStatistics MonotonicOrderingStatistics::operator-(const MonotonicOrderingStatistics &rhs) const
+{
+	auto sub = [](const Engine &l, const Engine &r) { return Engine{ l.calls - r.calls, l.regions - r.regions, l.links_length - r.links_length, l.time - r.time }; };
+	return { sub(this->ant_colony, rhs.ant_colony), sub(this->local_search, rhs.local_search) };
+}
+
+// Above this number of regions, MonotonicOrdering::Auto switches from the ant colony to the local search.
+static constexpr size_t monotonic_ordering_ant_colony_max_regions = 48;
+
+static std::vector<MonotonicRegionLink> chain_monotonic_regions(
+	std::vector<MonotonicRegion> &regions, const ExPolygonWithOffset &poly_with_offset, const std::vector<SegmentedIntersectionLine> &segs, MonotonicOrdering ordering)
+{
+	bool ant_colony = ordering == MonotonicOrdering::AntColony ||
+		(ordering == MonotonicOrdering::Auto && regions.size() <= monotonic_ordering_ant_colony_max_regions);
+	auto t_start = std::chrono::steady_clock::now();
+	std::vector<MonotonicRegionLink> path;
+	if (ant_colony) {
+	    std::mt19937_64 rng;
+		path = chain_monotonic_regions(regions, poly_with_offset, segs, rng);
+	} else
+		path = chain_monotonic_regions_local_search(regions, poly_with_offset, segs);
+	auto t_end = std::chrono::steady_clock::now();
+	float links_length = 0.f;
+	for (size_t i = 1; i < path.size(); ++ i)
+		links_length += monotonic_region_link_length(poly_with_offset, segs, *path[i - 1].region, path[i - 1].flipped, *path[i].region, path[i].flipped);
+	int engine = ant_colony ? 0 : 1;
+	++ s_monotonic_ordering_calls[engine];
+	s_monotonic_ordering_regions[engine] += regions.size();
+	s_monotonic_ordering_links_length[engine] += uint64_t(links_length * 1000.f);
+	s_monotonic_ordering_time[engine] += uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(t_end - t_start).count());
+	return path;
+}
+
 // Traverse path, produce polylines.
 static void polylines_from_paths(const std::vector<MonotonicRegionLink> &path, const ExPolygonWithOffset &poly_with_offset, const std::vector<SegmentedIntersectionLine> &segs, Polylines &polylines_out)
 {
@@ -2784,8 +3009,7 @@ bool FillRectilinear::fill_surface_by_lines(const Surface *surface, const FillPa
 #endif // INFILL_DEBUG_OUTPUT
 		connect_monotonic_regions(regions, poly_with_offset, segs);
         if (! regions.empty()) {
-		    std::mt19937_64 rng;
-		    std::vector<MonotonicRegionLink> path = chain_monotonic_regions(regions, poly_with_offset, segs, rng);
+		    std::vector<MonotonicRegionLink> path = chain_monotonic_regions(regions, poly_with_offset, segs, params.monotonic_ordering);
 		    polylines_from_paths(path, poly_with_offset, segs, polylines_out);
         }
 	} else
@@ -49,6 +49,27 @@ public:
 	bool no_sort() const override { return true; }
 };
 
+// Statistics of ordering the monotonic regions by FillMonotonic, accumulated over all threads of the process.
+struct MonotonicOrderingStatistics
+{
+    struct Engine {
+        // Number of infill islands ordered.
+        size_t  calls   { 0 };
+        // Number of monotonic regions ordered.
+        size_t  regions { 0 };
+        // Total length of the links between the regions, unscaled.
+        double  links_length { 0. };
+        // Time spent ordering the regions, in seconds.
+        double  time    { 0. };
+    };
+    Engine  ant_colony;
+    Engine  local_search;
+
+    MonotonicOrderingStatistics operator-(const MonotonicOrderingStatistics &rhs) const;
+};
+
+MonotonicOrderingStatistics monotonic_ordering_statistics();
+
 class FillGrid : public FillRectilinear
 {
 public:
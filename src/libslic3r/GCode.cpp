@@ -120,7 +120,7 @@ namespace Slic3r {
             // Reducing all the object slices into the Z projection in a logarithimc fashion.
             // First reduce to half the number of layers.
             std::vector<Polygons> polygons_per_layer((object->layers().size() + 1) / 2);
-            tbb::parallel_for(tbb::blocked_range<size_t>(0, object->layers().size() / 2),
+            execution::parallel_for(object->print()->execution_policy(), tbb::blocked_range<size_t>(0, object->layers().size() / 2),
                 [&object, &polygons_per_layer](const tbb::blocked_range<size_t>& range) {
                     for (size_t i = range.begin(); i < range.end(); ++i) {
                         const Layer* layer1 = object->layers()[i * 2];
@@ -148,7 +148,7 @@ namespace Slic3r {
             // Now reduce down to a single layer.
             size_t cnt = polygons_per_layer.size();
             while (cnt > 1) {
-                tbb::parallel_for(tbb::blocked_range<size_t>(0, cnt / 2),
+                execution::parallel_for(object->print()->execution_policy(), tbb::blocked_range<size_t>(0, cnt / 2),
                     [&polygons_per_layer](const tbb::blocked_range<size_t>& range) {
                         for (size_t i = range.begin(); i < range.end(); ++i) {
                             Polygons polys;
@@ -730,6 +730,7 @@ void GCode::do_export(Print* print, const char* path, GCodeProcessor::Result* re
 
     try {
         m_placeholder_parser_failed_templates.clear();
+        m_placeholder_parser_compiled_templates.clear();
         this->_do_export(*print, file, thumbnail_cb);
         fflush(file);
         if (ferror(file)) {
@@ -762,7 +763,8 @@ void GCode::do_export(Print* print, const char* path, GCodeProcessor::Result* re
     }
 
     BOOST_LOG_TRIVIAL(debug) << "Start processing gcode, " << log_memory_info();
-    m_processor.process_file(path_tmp, true, [print]() { print->throw_if_canceled(); });
+    // The G-code has been processed while being written, only the lines M73 are inserted into the file.
+    m_processor.finish_streaming(path_tmp, true);
     DoExport::update_print_estimated_times_stats(m_processor, print->m_print_statistics);
     if (result != nullptr)
         *result = std::move(m_processor.extract_result());
@@ -1013,6 +1015,8 @@ void GCode::_do_export(Print& print, FILE* file, ThumbnailsGeneratorCallback thu
 
     // modifies m_silent_time_estimator_enabled
     DoExport::init_gcode_processor(print.config(), m_processor, m_silent_time_estimator_enabled);
+    // The G-code processor consumes the G-code as it is being written by _write().
+    m_processor.start_streaming([&print]() { print.throw_if_canceled(); });
 
     // resets analyzer's tracking data
     m_last_height  = 0.f;
@@ -1433,7 +1437,10 @@ void GCode::_do_export(Print& print, FILE* file, ThumbnailsGeneratorCallback thu
 std::string GCode::placeholder_parser_process(const std::string &name, const std::string &templ, unsigned int current_extruder_id, const DynamicConfig *config_override)
 {
     try {
-        return m_placeholder_parser.process(templ, current_extruder_id, config_override);
+        auto it_compiled = m_placeholder_parser_compiled_templates.find(templ);
+        if (it_compiled == m_placeholder_parser_compiled_templates.end())
+            it_compiled = m_placeholder_parser_compiled_templates.emplace(templ, PlaceholderParser::compile(templ)).first;
+        return m_placeholder_parser.process(it_compiled->second, current_extruder_id, config_override);
     } catch (std::runtime_error &err) {
         // Collect the names of failed template substitutions for error reporting.
         auto it = m_placeholder_parser_failed_templates.find(name);
@@ -1514,30 +1521,30 @@ static bool custom_gcode_sets_temperature(const std::string &gcode, const int mc
 }
 
 // Print the machine envelope G-code for the Marlin firmware based on the "machine_max_xxx" parameters.
-// Do not process this piece of G-code by the time estimator, it already knows the values through another sources.
+// The time estimator skips these lines, it already knows the values through another sources.
 void GCode::print_machine_envelope(FILE *file, Print &print)
 {
     if (print.config().gcode_flavor.value == gcfMarlin && print.config().machine_limits_usage.value == MachineLimitsUsage::EmitToGCode) {
-        fprintf(file, "M201 X%d Y%d Z%d E%d ; sets maximum accelerations, mm/sec^2\n",
+        _write_format(file, "M201 X%d Y%d Z%d E%d ; sets maximum accelerations, mm/sec^2\n",
             int(print.config().machine_max_acceleration_x.values.front() + 0.5),
             int(print.config().machine_max_acceleration_y.values.front() + 0.5),
             int(print.config().machine_max_acceleration_z.values.front() + 0.5),
             int(print.config().machine_max_acceleration_e.values.front() + 0.5));
-        fprintf(file, "M203 X%d Y%d Z%d E%d ; sets maximum feedrates, mm/sec\n",
+        _write_format(file, "M203 X%d Y%d Z%d E%d ; sets maximum feedrates, mm/sec\n",
             int(print.config().machine_max_feedrate_x.values.front() + 0.5),
             int(print.config().machine_max_feedrate_y.values.front() + 0.5),
             int(print.config().machine_max_feedrate_z.values.front() + 0.5),
             int(print.config().machine_max_feedrate_e.values.front() + 0.5));
-        fprintf(file, "M204 P%d R%d T%d ; sets acceleration (P, T) and retract acceleration (R), mm/sec^2\n",
+        _write_format(file, "M204 P%d R%d T%d ; sets acceleration (P, T) and retract acceleration (R), mm/sec^2\n",
             int(print.config().machine_max_acceleration_extruding.values.front() + 0.5),
             int(print.config().machine_max_acceleration_retracting.values.front() + 0.5),
             int(print.config().machine_max_acceleration_extruding.values.front() + 0.5));
-        fprintf(file, "M205 X%.2lf Y%.2lf Z%.2lf E%.2lf ; sets the jerk limits, mm/sec\n",
+        _write_format(file, "M205 X%.2lf Y%.2lf Z%.2lf E%.2lf ; sets the jerk limits, mm/sec\n",
             print.config().machine_max_jerk_x.values.front(),
             print.config().machine_max_jerk_y.values.front(),
             print.config().machine_max_jerk_z.values.front(),
             print.config().machine_max_jerk_e.values.front());
-        fprintf(file, "M205 S%d T%d ; sets the minimum extruding and travel feed rate, mm/sec\n",
+        _write_format(file, "M205 S%d T%d ; sets the minimum extruding and travel feed rate, mm/sec\n",
             int(print.config().machine_min_extruding_rate.values.front() + 0.5),
             int(print.config().machine_min_travel_rate.values.front() + 0.5));
     }
@@ -2204,12 +2211,18 @@ void GCode::process_layer(
     // bottom non-spiral layers otherwise it will mess with positions)
     // we apply spiral vase at this stage because it requires a full layer.
     // Just a reminder: A spiral vase mode is allowed for a single object per layer, single material print only.
-    if (m_spiral_vase)
-        gcode = m_spiral_vase->process_layer(gcode);
+    // The layer G-code is parsed into lines once, the spiral vase and the cooling buffer edit the lines in place
+    // and the G-code text is assembled once after the last of them.
+    {
+        GCodeLines lines(std::move(gcode), m_config.get_extrusion_axis()[0]);
+        if (m_spiral_vase)
+            m_spiral_vase->process_layer(lines);
 
-    // Apply cooling logic; this may alter speeds.
-    if (m_cooling_buffer)
-        gcode = m_cooling_buffer->process_layer(gcode, layer.id());
+        // Apply cooling logic; this may alter speeds.
+        if (m_cooling_buffer)
+            m_cooling_buffer->process_layer(lines, layer.id());
+        gcode = lines.str();
+    }
 
 #ifdef HAS_PRESSURE_EQUALIZER
     // Apply pressure equalization if enabled;
@@ -2555,6 +2568,8 @@ void GCode::_write(FILE* file, const char *what)
         const char* gcode = what;
         // writes string to file
         fwrite(gcode, 1, ::strlen(gcode), file);
+        // and processes it
+        m_processor.process_buffer(gcode);
     }
 }
 
@@ -21,6 +21,7 @@
 #include <memory>
 #include <map>
 #include <string>
+#include <unordered_map>
 
 #ifdef HAS_PRESSURE_EQUALIZER
 #include "GCode/PressureEqualizer.hpp"
@@ -325,6 +326,9 @@ private:
     PlaceholderParser                   m_placeholder_parser;
     // Collection of templates, on which the placeholder substitution failed.
     std::map<std::string, std::string>  m_placeholder_parser_failed_templates;
+    // Custom G-code templates compiled by the PlaceholderParser, indexed by the template source, so that the templates
+    // processed repeatedly (layer change, tool change) are split into blocks just once.
+    std::unordered_map<std::string, PlaceholderParser::CompiledTemplate> m_placeholder_parser_compiled_templates;
     OozePrevention                      m_ooze_prevention;
     Wipe                                m_wipe;
     AvoidCrossingPerimeters             m_avoid_crossing_perimeters;
@@ -49,8 +49,8 @@ struct CoolingLine
         TYPE_G92                = 1 << 11,
     };
 
-    CoolingLine(unsigned int type, size_t  line_start, size_t  line_end) :
-        type(type), line_start(line_start), line_end(line_end),
+    CoolingLine(unsigned int type, size_t line_idx) :
+        type(type), line_idx(line_idx),
         length(0.f), feedrate(0.f), time(0.f), time_max(0.f), slowdown(false) {}
 
     bool adjustable(bool slowdown_external_perimeters) const {
@@ -64,10 +64,8 @@ struct CoolingLine
     }
 
     size_t  type;
-    // Start of this line at the G-code snippet.
-    size_t  line_start;
-    // End of this line at the G-code snippet.
-    size_t  line_end;
+    // Index of this line at the G-code lines of the layer.
+    size_t  line_idx;
     // XY Euclidian length of this segment.
     float   length;
     // Current feedrate, possibly adjusted.
@@ -279,16 +277,23 @@ finished:
 	return new_feedrate;
 }
 
-std::string CoolingBuffer::process_layer(const std::string &gcode, size_t layer_id)
+void CoolingBuffer::process_layer(GCodeLines &gcode, size_t layer_id)
 {
     std::vector<PerExtruderAdjustments> per_extruder_adjustments = this->parse_layer_gcode(gcode, m_current_pos);
     float layer_time_stretched = this->calculate_layer_slowdown(per_extruder_adjustments);
-    return this->apply_layer_cooldown(gcode, layer_id, layer_time_stretched, per_extruder_adjustments);
+    this->apply_layer_cooldown(gcode, layer_id, layer_time_stretched, per_extruder_adjustments);
+}
+
+std::string CoolingBuffer::process_layer(const std::string &gcode, size_t layer_id)
+{
+    GCodeLines lines(gcode, m_gcodegen.config().get_extrusion_axis()[0]);
+    this->process_layer(lines, layer_id);
+    return lines.str();
 }
 
 // Parse the layer G-code for the moves, which could be adjusted.
 // Return the list of parsed lines, bucketed by an extruder.
-std::vector<PerExtruderAdjustments> CoolingBuffer::parse_layer_gcode(const std::string &gcode, std::vector<float> &current_pos) const
+std::vector<PerExtruderAdjustments> CoolingBuffer::parse_layer_gcode(const GCodeLines &gcode, std::vector<float> &current_pos) const
 {
     const FullPrintConfig       &config        = m_gcodegen.config();
     const std::vector<Extruder> &extruders     = m_gcodegen.writer().extruders();
@@ -311,62 +316,45 @@ std::vector<PerExtruderAdjustments> CoolingBuffer::parse_layer_gcode(const std::
     const std::string toolchange_prefix = m_gcodegen.writer().toolchange_prefix();
     unsigned int      current_extruder  = m_current_extruder;
     PerExtruderAdjustments *adjustment  = &per_extruder_adjustments[map_extruder_to_per_extruder_adjustment[current_extruder]];
-    const char       *line_start = gcode.c_str();
-    const char       *line_end   = line_start;
-    const char        extrusion_axis = config.get_extrusion_axis()[0];
     // Index of an existing CoolingLine of the current adjustment, which holds the feedrate setting command
     // for a sequence of extrusion moves.
     size_t            active_speed_modifier = size_t(-1);
 
-    for (; *line_start != 0; line_start = line_end) 
+    for (size_t line_idx = 0; line_idx < gcode.size(); ++ line_idx)
     {
-        while (*line_end != '\n' && *line_end != 0)
-            ++ line_end;
-        // sline will not contain the trailing '\n'.
-        std::string sline(line_start, line_end);
-        // CoolingLine will contain the trailing '\n'.
-        if (*line_end == '\n')
-            ++ line_end;
-        CoolingLine line(0, line_start - gcode.c_str(), line_end - gcode.c_str());
-        if (boost::starts_with(sline, "G0 "))
+        const GCodeLines::Line &gline = gcode[line_idx];
+        if (gline.removed())
+            continue;
+        // sline does not contain the trailing '\n'.
+        std::string_view sline = gcode.text(gline);
+        CoolingLine line(0, line_idx);
+        if (gline.type == GCodeLines::Line::G0)
             line.type = CoolingLine::TYPE_G0;
-        else if (boost::starts_with(sline, "G1 "))
+        else if (gline.type == GCodeLines::Line::G1)
             line.type = CoolingLine::TYPE_G1;
-        else if (boost::starts_with(sline, "G92 "))
+        else if (gline.type == GCodeLines::Line::G92)
             line.type = CoolingLine::TYPE_G92;
         if (line.type) {
             // G0, G1 or G92
-            // Parse the G-code line.
+            // The axes were parsed with the G-code lines.
             std::vector<float> new_pos(current_pos);
-            const char *c = sline.data() + 3;
-            for (;;) {
-                // Skip whitespaces.
-                for (; *c == ' ' || *c == '\t'; ++ c);
-                if (*c == 0 || *c == ';')
-                    break;
-                // Parse the axis.
-                size_t axis = (*c >= 'X' && *c <= 'Z') ? (*c - 'X') :
-                              (*c == extrusion_axis) ? 3 : (*c == 'F') ? 4 : size_t(-1);
-                if (axis != size_t(-1)) {
-                    new_pos[axis] = float(atof(++c));
-                    if (axis == 4) {
-                        // Convert mm/min to mm/sec.
-                        new_pos[4] /= 60.f;
-                        if ((line.type & CoolingLine::TYPE_G92) == 0)
-                            // This is G0 or G1 line and it sets the feedrate. This mark is used for reducing the duplicate F calls.
-                            line.type |= CoolingLine::TYPE_HAS_F;
-                    }
-                }
-                // Skip this word.
-                for (; *c != ' ' && *c != '\t' && *c != 0; ++ c);
+            for (size_t axis = 0; axis < 5; ++ axis)
+                if (gline.has(Axis(axis)))
+                    new_pos[axis] = gline.value(Axis(axis));
+            if (gline.has(F)) {
+                // Convert mm/min to mm/sec.
+                new_pos[4] /= 60.f;
+                if ((line.type & CoolingLine::TYPE_G92) == 0)
+                    // This is G0 or G1 line and it sets the feedrate. This mark is used for reducing the duplicate F calls.
+                    line.type |= CoolingLine::TYPE_HAS_F;
             }
-            bool external_perimeter = boost::contains(sline, ";_EXTERNAL_PERIMETER");
-            bool wipe               = boost::contains(sline, ";_WIPE");
+            bool external_perimeter = sline.find(";_EXTERNAL_PERIMETER") != std::string_view::npos;
+            bool wipe               = sline.find(";_WIPE") != std::string_view::npos;
             if (external_perimeter)
                 line.type |= CoolingLine::TYPE_EXTERNAL_PERIMETER;
             if (wipe)
                 line.type |= CoolingLine::TYPE_WIPE;
-            if (boost::contains(sline, ";_EXTRUDE_SET_SPEED") && ! wipe) {
+            if (sline.find(";_EXTRUDE_SET_SPEED") != std::string_view::npos && ! wipe) {
                 line.type |= CoolingLine::TYPE_ADJUSTABLE;
                 active_speed_modifier = adjustment->lines.size();
             }
@@ -416,7 +404,7 @@ std::vector<PerExtruderAdjustments> CoolingBuffer::parse_layer_gcode(const std::
             line.type = CoolingLine::TYPE_EXTRUDE_END;
             active_speed_modifier = size_t(-1);
         } else if (boost::starts_with(sline, toolchange_prefix)) {
-            unsigned int new_extruder = (unsigned int)atoi(sline.c_str() + toolchange_prefix.size());
+            unsigned int new_extruder = (unsigned int)atoi(std::string(sline.substr(toolchange_prefix.size())).c_str());
             // Only change extruder in case the number is meaningful. User could provide an out-of-range index through custom gcodes - those shall be ignored.
             if (new_extruder < map_extruder_to_per_extruder_adjustment.size()) {
                 if (new_extruder != current_extruder) {
@@ -436,14 +424,15 @@ std::vector<PerExtruderAdjustments> CoolingBuffer::parse_layer_gcode(const std::
             line.type = CoolingLine::TYPE_BRIDGE_FAN_START;
         } else if (boost::starts_with(sline, ";_BRIDGE_FAN_END")) {
             line.type = CoolingLine::TYPE_BRIDGE_FAN_END;
-        } else if (boost::starts_with(sline, "G4 ")) {
+        } else if (gline.type == GCodeLines::Line::G4) {
             // Parse the wait time.
             line.type = CoolingLine::TYPE_G4;
-            size_t pos_S = sline.find('S', 3);
-            size_t pos_P = sline.find('P', 3);
+            std::string g4(sline);
+            size_t pos_S = g4.find('S', 3);
+            size_t pos_P = g4.find('P', 3);
             line.time = line.time_max = float(
-                (pos_S > 0) ? atof(sline.c_str() + pos_S + 1) :
-                (pos_P > 0) ? atof(sline.c_str() + pos_P + 1) * 0.001 : 0.);
+                (pos_S > 0) ? atof(g4.c_str() + pos_S + 1) :
+                (pos_P > 0) ? atof(g4.c_str() + pos_P + 1) * 0.001 : 0.);
         }
         if (line.type != 0)
             adjustment->lines.emplace_back(std::move(line));
@@ -648,10 +637,10 @@ float CoolingBuffer::calculate_layer_slowdown(std::vector<PerExtruderAdjustments
 }
 
 // Apply slow down over G-code lines stored in per_extruder_adjustments, enable fan if needed.
-// Returns the adjusted G-code.
-std::string CoolingBuffer::apply_layer_cooldown(
-    // Source G-code for the current layer.
-    const std::string                      &gcode,
+// The G-code lines are adjusted in place.
+void CoolingBuffer::apply_layer_cooldown(
+    // G-code lines of the current layer.
+    GCodeLines                             &gcode,
     // ID of the current layer, used to disable fan for the first n layers.
     size_t                                  layer_id, 
     // Total time of this layer after slow down, used to control the fan.
@@ -669,15 +658,15 @@ std::string CoolingBuffer::apply_layer_cooldown(
         for (const PerExtruderAdjustments &adj : per_extruder_adjustments)
             for (const CoolingLine &line : adj.lines)
                 lines.emplace_back(&line);
-        std::sort(lines.begin(), lines.end(), [](const CoolingLine *ln1, const CoolingLine *ln2) { return ln1->line_start < ln2->line_start; } );
+        std::sort(lines.begin(), lines.end(), [](const CoolingLine *ln1, const CoolingLine *ln2) { return ln1->line_idx < ln2->line_idx; } );
     }
-    // Second generate the adjusted G-code.
-    std::string new_gcode;
-    new_gcode.reserve(gcode.size() * 2);
+    // Second adjust the G-code lines.
     int  fan_speed          = -1;
     bool bridge_fan_control = false;
     int  bridge_fan_speed   = 0;
-    auto change_extruder_set_fan = [ this, layer_id, layer_time, &new_gcode, &fan_speed, &bridge_fan_control, &bridge_fan_speed ]() {
+    // Fan commands are inserted before this line.
+    size_t fan_line_idx     = 0;
+    auto change_extruder_set_fan = [ this, layer_id, layer_time, &gcode, &fan_speed, &bridge_fan_control, &bridge_fan_speed, &fan_line_idx ]() {
         const FullPrintConfig &config = m_gcodegen.config();
 #define EXTRUDER_CONFIG(OPT) config.OPT.get_at(m_current_extruder)
         int min_fan_speed = EXTRUDER_CONFIG(min_fan_speed);
@@ -719,35 +708,39 @@ std::string CoolingBuffer::apply_layer_cooldown(
         }
         if (fan_speed_new != fan_speed) {
             fan_speed = fan_speed_new;
-            new_gcode += m_gcodegen.writer().set_fan(fan_speed);
+            gcode.insert(fan_line_idx, m_gcodegen.writer().set_fan(fan_speed));
         }
     };
 
-    const char         *pos               = gcode.c_str();
     int                 current_feedrate  = 0;
     const std::string   toolchange_prefix = m_gcodegen.writer().toolchange_prefix();
     change_extruder_set_fan();
     for (const CoolingLine *line : lines) {
-        const char *line_start  = gcode.c_str() + line->line_start;
-        const char *line_end    = gcode.c_str() + line->line_end;
-        if (line_start > pos)
-            new_gcode.append(pos, line_start - pos);
+        GCodeLines::Line   &gline = gcode[line->line_idx];
+        fan_line_idx = line->line_idx;
         if (line->type & CoolingLine::TYPE_SET_TOOL) {
-            unsigned int new_extruder = (unsigned int)atoi(line_start + toolchange_prefix.size());
+            unsigned int new_extruder = (unsigned int)atoi(std::string(gcode.text(gline).substr(toolchange_prefix.size())).c_str());
             if (new_extruder != m_current_extruder) {
                 m_current_extruder = new_extruder;
                 change_extruder_set_fan();
             }
-            new_gcode.append(line_start, line_end - line_start);
         } else if (line->type & CoolingLine::TYPE_BRIDGE_FAN_START) {
             if (bridge_fan_control)
-                new_gcode += m_gcodegen.writer().set_fan(bridge_fan_speed, true);
+                gcode.insert(fan_line_idx, m_gcodegen.writer().set_fan(bridge_fan_speed, true));
+            gcode.remove(gline);
         } else if (line->type & CoolingLine::TYPE_BRIDGE_FAN_END) {
             if (bridge_fan_control)
-                new_gcode += m_gcodegen.writer().set_fan(fan_speed, true);
+                gcode.insert(fan_line_idx, m_gcodegen.writer().set_fan(fan_speed, true));
+            gcode.remove(gline);
         } else if (line->type & CoolingLine::TYPE_EXTRUDE_END) {
             // Just remove this comment.
+            gcode.remove(gline);
         } else if (line->type & (CoolingLine::TYPE_ADJUSTABLE | CoolingLine::TYPE_EXTERNAL_PERIMETER | CoolingLine::TYPE_WIPE | CoolingLine::TYPE_HAS_F)) {
+            // The source line without the trailing newline, and the line to replace it.
+            const std::string   src(gcode.text(gline));
+            std::string         new_line;
+            const char         *line_start = src.c_str();
+            const char         *line_end   = line_start + src.size();
             // Find the start of a comment, or roll to the end of line.
             const char *end = line_start;
             for (; end < line_end && *end != ';'; ++ end);
@@ -763,7 +756,7 @@ std::string CoolingBuffer::apply_layer_cooldown(
                 new_feedrate = atoi(fpos);
                 if (new_feedrate != current_feedrate) {
                     // Append the line without the comment.
-                    new_gcode.append(line_start, end - line_start);
+                    new_line.append(line_start, end - line_start);
                     current_feedrate = new_feedrate;
                 } else if ((line->type & (CoolingLine::TYPE_ADJUSTABLE | CoolingLine::TYPE_EXTERNAL_PERIMETER | CoolingLine::TYPE_WIPE)) || line->length == 0.) {
                     // Feedrate does not change and this line does not move the print head. Skip the complete G-code line including the G-code comment.
@@ -776,26 +769,26 @@ std::string CoolingBuffer::apply_layer_cooldown(
             if (modify) {
                 if (new_feedrate != current_feedrate) {
                     // Replace the feedrate.
-                    new_gcode.append(line_start, fpos - line_start);
+                    new_line.append(line_start, fpos - line_start);
                     current_feedrate = new_feedrate;
                     char buf[64];
                     sprintf(buf, "%d", int(current_feedrate));
-                    new_gcode += buf;
+                    new_line += buf;
                 } else {
                     // Remove the feedrate word.
                     const char *f = fpos;
                     // Roll the pointer before the 'F' word.
                     for (f -= 2; f > line_start && (*f == ' ' || *f == '\t'); -- f);
                     // Append up to the F word, without the trailing whitespace.
-                    new_gcode.append(line_start, f - line_start + 1);
+                    new_line.append(line_start, f - line_start + 1);
                 }
                 // Skip the non-whitespaces of the F parameter up the comment or end of line.
-                for (; fpos != end && *fpos != ' ' && *fpos != ';' && *fpos != '\n'; ++fpos);
+                for (; fpos != end && *fpos != ' ' && *fpos != ';'; ++fpos);
                 // Append the rest of the line without the comment.
                 if (fpos < end)
-                    new_gcode.append(fpos, end - fpos);
+                    new_line.append(fpos, end - fpos);
                 // There should never be an empty G1 statement emited by the filter. Such lines should be removed completely.
-                assert(new_gcode.size() < 4 || new_gcode.substr(new_gcode.size() - 4) != "G1 \n");
+                assert(new_line != "G1 ");
             }
             // Process the rest of the line.
             if (end < line_end) {
@@ -807,22 +800,19 @@ std::string CoolingBuffer::apply_layer_cooldown(
                         boost::replace_all(comment, ";_EXTERNAL_PERIMETER", "");
                     if (line->type & CoolingLine::TYPE_WIPE)
                         boost::replace_all(comment, ";_WIPE", "");
-                    new_gcode += comment;
+                    new_line += comment;
                 } else {
                     // Just attach the rest of the source line.
-                    new_gcode.append(end, line_end - end);
+                    new_line.append(end, line_end - end);
                 }
             }
-        } else {
-            new_gcode.append(line_start, line_end - line_start);
+            if (new_line.empty())
+                // The complete line is skipped.
+                gcode.remove(gline);
+            else if (new_line != src)
+                gcode.set_text(gline, std::move(new_line));
         }
-        pos = line_end;
     }
-    const char *gcode_end = gcode.c_str() + gcode.size();
-    if (pos < gcode_end)
-        new_gcode.append(pos, gcode_end - pos);
-
-    return new_gcode;
 }
 
 } // namespace Slic3r
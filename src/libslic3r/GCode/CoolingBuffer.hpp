@@ -2,6 +2,7 @@
 #define slic3r_CoolingBuffer_hpp_
 
 #include "../libslic3r.h"
+#include "GCodeLines.hpp"
 #include <map>
 #include <string>
 
@@ -25,16 +26,18 @@ public:
     CoolingBuffer(GCode &gcodegen);
     void        reset();
     void        set_current_extruder(unsigned int extruder_id) { m_current_extruder = extruder_id; }
+    // Adjust the G-code lines of a layer in place.
+    void        process_layer(GCodeLines &gcode, size_t layer_id);
     std::string process_layer(const std::string &gcode, size_t layer_id);
     GCode* 	    gcodegen() { return &m_gcodegen; }
 
 private:
 	CoolingBuffer& operator=(const CoolingBuffer&) = delete;
-    std::vector<PerExtruderAdjustments> parse_layer_gcode(const std::string &gcode, std::vector<float> &current_pos) const;
+    std::vector<PerExtruderAdjustments> parse_layer_gcode(const GCodeLines &gcode, std::vector<float> &current_pos) const;
     float       calculate_layer_slowdown(std::vector<PerExtruderAdjustments> &per_extruder_adjustments);
     // Apply slow down over G-code lines stored in per_extruder_adjustments, enable fan if needed.
-    // Returns the adjusted G-code.
-    std::string apply_layer_cooldown(const std::string &gcode, size_t layer_id, float layer_time, std::vector<PerExtruderAdjustments> &per_extruder_adjustments);
+    // The G-code lines are adjusted in place.
+    void        apply_layer_cooldown(GCodeLines &gcode, size_t layer_id, float layer_time, std::vector<PerExtruderAdjustments> &per_extruder_adjustments);
 
     GCode&              m_gcodegen;
     std::string         m_gcode;
@@ -0,0 +1,127 @@
+#include "GCodeLines.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+
+namespace Slic3r {
+
+static inline bool is_whitespace(char c)        { return c == ' ' || c == '\t'; }
+static inline bool is_end_of_line(char c)       { return c == '\r' || c == '\n' || c == 0; }
+static inline bool is_end_of_gcode_line(char c) { return c == ';' || is_end_of_line(c); }
+static inline bool is_end_of_word(char c)       { return is_whitespace(c) || is_end_of_gcode_line(c); }
+
+GCodeLines::GCodeLines(std::string gcode, char extrusion_axis) : m_gcode(std::move(gcode)), m_extrusion_axis(extrusion_axis)
+{
+    const char *start = m_gcode.c_str();
+    m_lines.reserve(std::count(m_gcode.begin(), m_gcode.end(), '\n') + 1);
+    for (const char *ptr = start; *ptr != 0;) {
+        Line line;
+        line.m_begin = ptr - start;
+        // Parse the command, the same way GCodeReader does.
+        const char *c = ptr;
+        for (; is_whitespace(*c); ++ c) ;
+        const char *cmd = c;
+        for (; ! is_end_of_word(*c); ++ c) ;
+        if (cmd[0] == 'G') {
+            size_t cmd_len = c - cmd;
+            if (cmd_len == 2 && cmd[1] == '0')
+                line.type = Line::G0;
+            else if (cmd_len == 2 && cmd[1] == '1')
+                line.type = Line::G1;
+            else if (cmd_len == 2 && cmd[1] == '4')
+                line.type = Line::G4;
+            else if (cmd_len == 3 && cmd[1] == '9' && cmd[2] == '2')
+                line.type = Line::G92;
+        }
+        if (line.type != Line::OTHER && line.type != Line::G4) {
+            // Parse the axes up to the end of line or comment.
+            while (! is_end_of_gcode_line(*c)) {
+                for (; is_whitespace(*c); ++ c) ;
+                if (is_end_of_gcode_line(*c))
+                    break;
+                int axis = -1;
+                switch (*c) {
+                case 'X': axis = X; break;
+                case 'Y': axis = Y; break;
+                case 'Z': axis = Z; break;
+                case 'F': axis = F; break;
+                default:  if (*c == m_extrusion_axis) axis = E; break;
+                }
+                if (axis != -1) {
+                    char   *pend = nullptr;
+                    double  v    = strtod(++ c, &pend);
+                    if (pend != nullptr && is_end_of_word(*pend)) {
+                        line.axis[axis] = float(v);
+                        line.mask |= 1 << axis;
+                        c = pend;
+                        continue;
+                    }
+                }
+                // Skip the rest of the word.
+                for (; ! is_end_of_word(*c); ++ c) ;
+            }
+        }
+        for (; *c != '\n' && *c != 0; ++ c) ;
+        line.m_end     = c - start;
+        line.m_newline = *c == '\n';
+        ptr = line.m_newline ? c + 1 : c;
+        m_lines.emplace_back(std::move(line));
+    }
+}
+
+void GCodeLines::set_axis(Line &line, Axis axis, float value, int decimal_digits)
+{
+    char buf[64];
+    sprintf(buf, "%.*f", decimal_digits, double(value));
+
+    char match[3] = " X";
+    if (int(axis) < 3)
+        match[1] += int(axis);
+    else if (axis == F)
+        match[1] = 'F';
+    else {
+        assert(axis == E);
+        match[1] = m_extrusion_axis;
+    }
+
+    std::string text(this->text(line));
+    if (line.has(axis)) {
+        size_t pos = text.find(match) + 2;
+        size_t end = text.find(' ', pos + 1);
+        text.replace(pos, end - pos, buf);
+    } else {
+        size_t pos = text.find(' ');
+        if (pos == std::string::npos)
+            text += std::string(match) + buf;
+        else
+            text.replace(pos, 0, std::string(match) + buf);
+    }
+    this->set_text(line, std::move(text));
+    // Store the value as written, as if the edited G-code was parsed again.
+    line.axis[axis] = float(atof(buf));
+    line.mask |= 1 << int(axis);
+}
+
+std::string GCodeLines::str() const
+{
+    size_t len = m_appended.size();
+    for (const Line &line : m_lines)
+        len += line.m_inserted.size() + (line.m_removed ? 0 : (line.m_edited ? line.m_text.size() : line.m_end - line.m_begin) + 1);
+
+    std::string out;
+    out.reserve(len);
+    for (const Line &line : m_lines) {
+        out += line.m_inserted;
+        if (! line.m_removed) {
+            out += this->text(line);
+            if (line.m_newline)
+                out += '\n';
+        }
+    }
+    out += m_appended;
+    return out;
+}
+
+} // namespace Slic3r
@@ -0,0 +1,98 @@
+#ifndef slic3r_GCodeLines_hpp_
+#define slic3r_GCodeLines_hpp_
+
+#include "../libslic3r.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Slic3r {
+
+// G-code of a single layer split into lines, with the axes of the G0 / G1 / G92 moves parsed.
+// The layer G-code is parsed once after it has been generated, the layer filters (SpiralVase, CoolingBuffer)
+// then read and edit the lines in place, and the G-code text is assembled once after the last filter.
+class GCodeLines
+{
+public:
+    struct Line {
+        enum Type : unsigned char {
+            OTHER,
+            G0,
+            G1,
+            G4,
+            G92,
+        };
+
+        bool  is_move() const { return this->type == G0 || this->type == G1; }
+        bool  has(Axis axis) const { return (this->mask & (1 << int(axis))) != 0; }
+        float value(Axis axis) const { return this->axis[axis]; }
+        bool  removed() const { return m_removed; }
+
+        Type        type = OTHER;
+        // Bit mask of the axes present at the line.
+        uint32_t    mask = 0;
+        // Values of the axes present at the line, the feedrate in mm/min.
+        float       axis[NUM_AXES] = { 0.f, 0.f, 0.f, 0.f, 0.f };
+
+    private:
+        // Span of the source line at the layer G-code, without the trailing newline.
+        size_t      m_begin     = 0;
+        size_t      m_end       = 0;
+        bool        m_newline   = false;
+        bool        m_edited    = false;
+        bool        m_removed   = false;
+        // Text of the line after it has been edited.
+        std::string m_text;
+        // G-code inserted before this line.
+        std::string m_inserted;
+        friend class GCodeLines;
+    };
+
+    GCodeLines() = default;
+    // Split the layer G-code into lines and parse the moves.
+    GCodeLines(std::string gcode, char extrusion_axis);
+
+    size_t          size()  const { return m_lines.size(); }
+    bool            empty() const { return m_lines.empty(); }
+    Line&           operator[](size_t idx)       { return m_lines[idx]; }
+    const Line&     operator[](size_t idx) const { return m_lines[idx]; }
+    std::vector<Line>::iterator       begin()       { return m_lines.begin(); }
+    std::vector<Line>::iterator       end()         { return m_lines.end(); }
+    std::vector<Line>::const_iterator begin() const { return m_lines.begin(); }
+    std::vector<Line>::const_iterator end()   const { return m_lines.end(); }
+    char            extrusion_axis() const { return m_extrusion_axis; }
+
+    // Current text of the line without the trailing newline.
+    std::string_view text(const Line &line) const
+        { return line.m_edited ? std::string_view(line.m_text) : std::string_view(m_gcode).substr(line.m_begin, line.m_end - line.m_begin); }
+    // Comment of the line starting after the ';', empty if there is no comment.
+    std::string_view comment(const Line &line) const {
+        std::string_view t = this->text(line);
+        size_t pos = t.find(';');
+        return pos == std::string_view::npos ? std::string_view() : t.substr(pos + 1);
+    }
+
+    // Replace the text of the line, the trailing newline is kept. The parsed axes are not updated.
+    void            set_text(Line &line, std::string text) { line.m_text = std::move(text); line.m_edited = true; }
+    // Set or add an axis value of a move.
+    void            set_axis(Line &line, Axis axis, float value, int decimal_digits = 3);
+    // Remove the line including its trailing newline. The G-code inserted before the line is kept.
+    void            remove(Line &line) { line.m_removed = true; }
+    // Insert G-code (with its newlines) before the line idx, or at the end of the layer if idx == size().
+    void            insert(size_t idx, const std::string &gcode) { (idx < m_lines.size() ? m_lines[idx].m_inserted : m_appended) += gcode; }
+
+    // Assemble the G-code text of the edited layer.
+    std::string     str() const;
+
+private:
+    std::string         m_gcode;
+    char                m_extrusion_axis = 'E';
+    std::vector<Line>   m_lines;
+    // G-code inserted after the last line.
+    std::string         m_appended;
+};
+
+} // namespace Slic3r
+
+#endif /* slic3r_GCodeLines_hpp_ */
@@ -9,6 +9,8 @@
 
 #include <float.h>
 #include <assert.h>
+#include <cstring>
+#include <limits>
 
 #if __has_include(<charconv>)
     #include <charconv>
@@ -328,9 +330,32 @@ void GCodeProcessor::TimeProcessor::reset()
     machines[static_cast<size_t>(PrintEstimatedTimeStatistics::ETimeMode::Normal)].enabled = true;
 }
 
-void GCodeProcessor::TimeProcessor::post_process(const std::string& filename)
+// check for temporary lines
+static bool is_temporary_decoration(const std::string_view gcode_line)
 {
-    boost::nowide::ifstream in(filename);
+    // remove trailing '\n'
+    assert(! gcode_line.empty());
+    assert(gcode_line.back() == '\n');
+
+    // return true for decorations which are used in processing the gcode but that should not be exported into the final gcode
+    // i.e.:
+    // bool ret = gcode_line.substr(0, gcode_line.length() - 1) == ";" + Layer_Change_Tag;
+    // ...
+    // return ret;
+    return false;
+}
+
+void GCodeProcessor::TimeProcessor::FilePositions::reset()
+{
+    g1_line_steps = std::vector<uint32_t>();
+    last_g1_line = 0;
+    replaced_lines.clear();
+}
+
+void GCodeProcessor::TimeProcessor::post_process(const std::string& filename, const FilePositions* positions)
+{
+    // the recorded positions are byte offsets, thus the file has to be read in binary mode
+    boost::nowide::ifstream in(filename, (positions != nullptr) ? std::ios::in | std::ios::binary : std::ios::in);
     if (!in.good())
         throw Slic3r::RuntimeError(std::string("Time estimator post process export failed.\nCannot open file for reading.\n"));
 
@@ -398,20 +423,6 @@ void GCodeProcessor::TimeProcessor::post_process(const std::string& filename)
         return std::make_pair(!ret.empty(), ret.empty() ? gcode_line : ret);
     };
 
-    // check for temporary lines
-    auto is_temporary_decoration = [](const std::string_view gcode_line) {
-        // remove trailing '\n'
-        assert(! gcode_line.empty());
-        assert(gcode_line.back() == '\n');
-
-        // return true for decorations which are used in processing the gcode but that should not be exported into the final gcode
-        // i.e.:
-        // bool ret = gcode_line.substr(0, gcode_line.length() - 1) == ";" + Layer_Change_Tag;
-        // ...
-        // return ret;
-        return false;
-    };
-
     // Iterators for the normal and silent cached time estimate entry recently processed, used by process_line_G1.
     auto g1_times_cache_it = Slic3r::reserve_vector<std::vector<TimeMachine::G1LinesCacheItem>::const_iterator>(machines.size());
     for (const auto& machine : machines)
@@ -453,7 +464,57 @@ void GCodeProcessor::TimeProcessor::post_process(const std::string& filename)
         export_line.clear();
     };
 
-    while (std::getline(in, gcode_line)) {
+    if (positions != nullptr) {
+        // copy the gcode by blocks up to the next line to be replaced or to be preceded by lines M73
+        std::vector<char> buffer(65536);
+        size_t in_pos = 0;
+        auto copy_up_to = [&](size_t end) {
+            while (in_pos < end) {
+                size_t n = std::min(end - in_pos, buffer.size());
+                if (!in.read(buffer.data(), n)) {
+                    fclose(out);
+                    throw Slic3r::RuntimeError(std::string("Time estimator post process export failed.\nError while reading from file.\n"));
+                }
+                export_line.append(buffer.data(), n);
+                in_pos += n;
+                if (export_line.length() > 65535)
+                    write_string(export_line);
+            }
+        };
+        auto replace_lines_up_to = [&](std::vector<std::pair<size_t, size_t>>::const_iterator& it, size_t end) {
+            for (; it != positions->replaced_lines.end() && it->first < end; ++it) {
+                copy_up_to(it->first);
+                gcode_line.resize(it->second);
+                if (!in.read(gcode_line.data(), it->second)) {
+                    fclose(out);
+                    throw Slic3r::RuntimeError(std::string("Time estimator post process export failed.\nError while reading from file.\n"));
+                }
+                in_pos += it->second;
+                // remove temporary lines, replace placeholder lines
+                if (!is_temporary_decoration(gcode_line))
+                    export_line += process_placeholders(gcode_line).second;
+            }
+        };
+
+        auto replaced_line_it = positions->replaced_lines.cbegin();
+        size_t g1_line = 0;
+        for (uint32_t step : positions->g1_line_steps) {
+            g1_line += step;
+            replace_lines_up_to(replaced_line_it, g1_line);
+            copy_up_to(g1_line);
+            process_line_G1();
+            ++g1_lines_counter;
+        }
+        replace_lines_up_to(replaced_line_it, std::numeric_limits<size_t>::max());
+        // copy the rest of the file
+        while (in.read(buffer.data(), buffer.size()) || in.gcount() > 0) {
+            export_line.append(buffer.data(), size_t(in.gcount()));
+            if (export_line.length() > 65535)
+                write_string(export_line);
+        }
+    }
+
+    while (positions == nullptr && std::getline(in, gcode_line)) {
         if (!in.good()) {
             fclose(out);
             throw Slic3r::RuntimeError(std::string("Time estimator post process export failed.\nError while reading from file.\n"));
@@ -505,7 +566,7 @@ const std::vector<std::pair<GCodeProcessor::EProducer, std::string>> GCodeProces
     { EProducer::KissSlicer,  "KISSlicer" }
 };
 
-unsigned int GCodeProcessor::s_result_id = 0;
+std::atomic<unsigned int> GCodeProcessor::s_result_id(0);
 
 GCodeProcessor::GCodeProcessor()
 {
@@ -766,6 +827,10 @@ void GCodeProcessor::reset()
 
     m_time_processor.reset();
 
+    m_stream_line.clear();
+    m_stream_size = 0;
+    m_stream_positions.reset();
+
     m_result.reset();
     m_result.id = ++s_result_id;
 
@@ -807,9 +872,7 @@ void GCodeProcessor::process_file(const std::string& filename, bool apply_postpr
     }
 
     // process gcode
-    m_result.id = ++s_result_id;
-    // 1st move must be a dummy move
-    m_result.moves.emplace_back(MoveVertex());
+    start_processing();
     m_parser.parse_file(filename, [this, cancel_callback, &last_cancel_callback_time](GCodeReader& reader, const GCodeReader::GCodeLine& line) {
         if (cancel_callback != nullptr) {
             // call the cancel callback every 100 ms
@@ -822,6 +885,102 @@ void GCodeProcessor::process_file(const std::string& filename, bool apply_postpr
         process_gcode_line(line);
         });
 
+    finish_processing(filename, apply_postprocess, nullptr);
+
+#if ENABLE_GCODE_VIEWER_STATISTICS
+    m_result.time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start_time).count();
+#endif // ENABLE_GCODE_VIEWER_STATISTICS
+}
+
+void GCodeProcessor::start_streaming(std::function<void()> cancel_callback)
+{
+    m_stream_line.clear();
+    m_stream_size = 0;
+    m_stream_positions.reset();
+    m_stream_cancel_callback = cancel_callback;
+    m_stream_last_cancel_callback_time = std::chrono::high_resolution_clock::now();
+    start_processing();
+}
+
+void GCodeProcessor::process_buffer(const char* buffer)
+{
+    const char* ptr = buffer;
+    if (!m_stream_line.empty()) {
+        // complete the line left over by the previous buffer
+        const char* end = ::strchr(ptr, '\n');
+        if (end == nullptr) {
+            m_stream_line += ptr;
+            return;
+        }
+        m_stream_line.append(ptr, end + 1);
+        process_stream_line(m_stream_line.c_str(), m_stream_line.length());
+        m_stream_line.clear();
+        ptr = end + 1;
+    }
+    while (*ptr != 0) {
+        const char* end = ::strchr(ptr, '\n');
+        if (end == nullptr) {
+            // keep the incomplete line until the rest of it arrives
+            m_stream_line = ptr;
+            return;
+        }
+        process_stream_line(ptr, end + 1 - ptr);
+        ptr = end + 1;
+    }
+}
+
+void GCodeProcessor::finish_streaming(const std::string& filename, bool apply_postprocess)
+{
+    if (!m_stream_line.empty()) {
+        // the gcode does not end with a newline
+        process_stream_line(m_stream_line.c_str(), m_stream_line.length());
+        m_stream_line.clear();
+    }
+    finish_processing(filename, apply_postprocess, &m_stream_positions);
+    m_stream_positions.reset();
+    m_stream_cancel_callback = nullptr;
+}
+
+void GCodeProcessor::process_stream_line(const char* line, size_t length)
+{
+    if (m_stream_cancel_callback != nullptr) {
+        // call the cancel callback every 100 ms
+        auto curr_time = std::chrono::high_resolution_clock::now();
+        if (std::chrono::duration_cast<std::chrono::milliseconds>(curr_time - m_stream_last_cancel_callback_time).count() > 100) {
+            m_stream_cancel_callback();
+            m_stream_last_cancel_callback_time = curr_time;
+        }
+    }
+
+    auto callback = [this, line, length](GCodeReader& reader, const GCodeReader::GCodeLine& gline) {
+        // record the positions of the lines the post-processing will remove, replace or precede by lines M73
+        const std::string& raw = gline.raw();
+        if (line[length - 1] == '\n' && is_temporary_decoration(std::string_view(line, length)))
+            m_stream_positions.replaced_lines.emplace_back(m_stream_size, length);
+        else if (gline.cmd_is("G1")) {
+            assert(m_stream_size - m_stream_positions.last_g1_line <= std::numeric_limits<uint32_t>::max());
+            m_stream_positions.g1_line_steps.emplace_back(uint32_t(m_stream_size - m_stream_positions.last_g1_line));
+            m_stream_positions.last_g1_line = m_stream_size;
+        }
+        else if (raw.length() > 6 && raw.compare(0, 6, "; _GP_") == 0 &&
+            (raw == First_Line_M73_Placeholder_Tag || raw == Last_Line_M73_Placeholder_Tag || raw == Estimated_Printing_Time_Placeholder_Tag))
+            m_stream_positions.replaced_lines.emplace_back(m_stream_size, length);
+        process_gcode_line(gline);
+    };
+    GCodeReader::GCodeLine gline;
+    m_parser.parse_line(line, gline, callback);
+    m_stream_size += length;
+}
+
+void GCodeProcessor::start_processing()
+{
+    m_result.id = ++s_result_id;
+    // 1st move must be a dummy move
+    m_result.moves.emplace_back(MoveVertex());
+}
+
+void GCodeProcessor::finish_processing(const std::string& filename, bool apply_postprocess, const TimeProcessor::FilePositions* positions)
+{
 #if ENABLE_SHOW_WIPE_MOVES
     // update width/height of wipe moves
     for (MoveVertex& move : m_result.moves) {
@@ -845,7 +1004,7 @@ void GCodeProcessor::process_file(const std::string& filename, bool apply_postpr
 
     // post-process to add M73 lines into the gcode
     if (apply_postprocess)
-        m_time_processor.post_process(filename);
+        m_time_processor.post_process(filename, positions);
 
 #if ENABLE_GCODE_VIEWER_DATA_CHECKING
     std::cout << "\n";
@@ -853,10 +1012,6 @@ void GCodeProcessor::process_file(const std::string& filename, bool apply_postpr
     m_height_compare.output();
     m_width_compare.output();
 #endif // ENABLE_GCODE_VIEWER_DATA_CHECKING
-
-#if ENABLE_GCODE_VIEWER_STATISTICS
-    m_result.time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start_time).count();
-#endif // ENABLE_GCODE_VIEWER_STATISTICS
 }
 
 float GCodeProcessor::get_time(PrintEstimatedTimeStatistics::ETimeMode mode) const
@@ -8,9 +8,12 @@
 #include "libslic3r/CustomGCode.hpp"
 
 #include <array>
+#include <atomic>
 #include <vector>
 #include <string>
 #include <string_view>
+#include <chrono>
+#include <functional>
 
 namespace Slic3r {
 
@@ -250,10 +253,24 @@ namespace Slic3r {
             std::vector<float> filament_unload_times;
             std::array<TimeMachine, static_cast<size_t>(PrintEstimatedTimeStatistics::ETimeMode::Count)> machines;
 
+            // positions of the lines in the gcode file, recorded while the gcode is streamed to the processor
+            struct FilePositions
+            {
+                // distances in bytes between the starts of the consecutive G1 lines, the first one from the start of the file
+                std::vector<uint32_t> g1_line_steps;
+                // start of the last G1 line
+                size_t last_g1_line{ 0 };
+                // start and length (including the trailing newline) of the placeholder lines and of the temporary lines
+                std::vector<std::pair<size_t, size_t>> replaced_lines;
+
+                void reset();
+            };
+
             void reset();
 
             // post process the file with the given filename to add remaining time lines M73
-            void post_process(const std::string& filename);
+            // if the positions of the lines are known, the file is copied by blocks without being parsed again
+            void post_process(const std::string& filename, const FilePositions* positions = nullptr);
         };
 
     public:
@@ -439,8 +456,17 @@ namespace Slic3r {
 
         TimeProcessor m_time_processor;
 
+        // incomplete last line of the previous buffer sent to process_buffer()
+        std::string m_stream_line;
+        // number of bytes streamed so far
+        size_t m_stream_size;
+        TimeProcessor::FilePositions m_stream_positions;
+        std::function<void()> m_stream_cancel_callback;
+        std::chrono::high_resolution_clock::time_point m_stream_last_cancel_callback_time;
+
         Result m_result;
-        static unsigned int s_result_id;
+        // atomic, as multiple prints may be exported at once, for example by the batch slicing of the command line interface
+        static std::atomic<unsigned int> s_result_id;
 
 #if ENABLE_GCODE_VIEWER_DATA_CHECKING
         DataChecker m_mm3_per_mm_compare{ "mm3_per_mm", 0.01f };
@@ -468,6 +494,14 @@ namespace Slic3r {
         // throws CanceledException through print->throw_if_canceled() (sent by the caller as callback).
         void process_file(const std::string& filename, bool apply_postprocess, std::function<void()> cancel_callback = nullptr);
 
+        // Process the gcode while it is being exported, instead of reading it back from the exported file:
+        // call start_streaming(), then process_buffer() with the consecutive pieces of the gcode as they are written to the file,
+        // then finish_streaming() once the file is closed.
+        // The cancel callback is called every 100 ms while processing the streamed gcode, see process_file().
+        void start_streaming(std::function<void()> cancel_callback = nullptr);
+        void process_buffer(const char* buffer);
+        void finish_streaming(const std::string& filename, bool apply_postprocess);
+
         float get_time(PrintEstimatedTimeStatistics::ETimeMode mode) const;
         std::string get_time_dhm(PrintEstimatedTimeStatistics::ETimeMode mode) const;
         std::vector<std::pair<CustomGCode::Type, std::pair<float, float>>> get_custom_gcode_times(PrintEstimatedTimeStatistics::ETimeMode mode, bool include_remaining) const;
@@ -477,6 +511,10 @@ namespace Slic3r {
         std::vector<float> get_layers_time(PrintEstimatedTimeStatistics::ETimeMode mode) const;
 
     private:
+        void start_processing();
+        void finish_processing(const std::string& filename, bool apply_postprocess, const TimeProcessor::FilePositions* positions);
+        // Process a single streamed line, including its trailing newline.
+        void process_stream_line(const char* line, size_t length);
         void process_gcode_line(const GCodeReader::GCodeLine& line);
 
         // Process tags embedded into comments
@@ -1,10 +1,19 @@
 #include "SpiralVase.hpp"
 #include "GCode.hpp"
-#include <sstream>
+#include <algorithm>
+#include <cmath>
 
 namespace Slic3r {
 
-std::string SpiralVase::process_layer(const std::string &gcode)
+void SpiralVase::update_position(float *position, const GCodeLines::Line &line) const
+{
+    if (line.is_move() || line.type == GCodeLines::Line::G92)
+        for (size_t i = 0; i < NUM_AXES; ++ i)
+            if (line.has(Axis(i)))
+                position[i] = line.value(Axis(i));
+}
+
+void SpiralVase::process_layer(GCodeLines &gcode)
 {
     /*  This post-processor relies on several assumptions:
         - all layers are processed through it, including those that are not supposed
@@ -14,12 +23,23 @@ std::string SpiralVase::process_layer(const std::string &gcode)
         - each layer is composed by suitable geometry (i.e. a single complete loop)
         - loops were not clipped before calling this method  */
     
-    // If we're not going to modify G-code, just feed it to the reader
-    // in order to update positions.
+    // If we're not going to modify G-code, just update positions.
     if (! this->enable) {
-        m_reader.parse_buffer(gcode);
-        return gcode;
+        for (const GCodeLines::Line &line : gcode)
+            this->update_position(m_position, line);
+        return;
     }
+
+    const bool relative_e = m_config->use_relative_e_distances.value;
+    auto dist_XY = [](const float *position, const GCodeLines::Line &line) {
+        float x = line.has(X) ? (line.value(X) - position[X]) : 0;
+        float y = line.has(Y) ? (line.value(Y) - position[Y]) : 0;
+        return sqrt(x*x + y*y);
+    };
+    // With relative E distances, the E axis is reset before each line with an E word.
+    auto extruding = [relative_e](const float *position, const GCodeLines::Line &line) {
+        return line.type == GCodeLines::Line::G1 && line.has(E) && line.value(E) - (relative_e ? 0.f : position[E]) > 0;
+    };
     
     // Get total XY length for this layer by summing all extrusion moves.
     float total_layer_length = 0;
@@ -28,60 +48,55 @@ std::string SpiralVase::process_layer(const std::string &gcode)
     bool set_z = false;
     
     {
-        //FIXME Performance warning: This copies the GCodeConfig of the reader.
-        GCodeReader r = m_reader;  // clone
-        r.parse_buffer(gcode, [&total_layer_length, &layer_height, &z, &set_z]
-            (GCodeReader &reader, const GCodeReader::GCodeLine &line) {
-            if (line.cmd_is("G1")) {
-                if (line.extruding(reader)) {
-                    total_layer_length += line.dist_XY(reader);
+        float position[NUM_AXES];
+        std::copy(m_position, m_position + NUM_AXES, position);
+        for (const GCodeLines::Line &line : gcode) {
+            if (line.type == GCodeLines::Line::G1) {
+                if (extruding(position, line)) {
+                    total_layer_length += dist_XY(position, line);
                 } else if (line.has(Z)) {
-                    layer_height += line.dist_Z(reader);
+                    layer_height += line.value(Z) - position[Z];
                     if (!set_z) {
-                        z = line.new_Z(reader);
+                        z = line.value(Z);
                         set_z = true;
                     }
                 }
             }
-        });
+            this->update_position(position, line);
+        }
     }
     
-    // Remove layer height from initial Z.
+    // Remove layer height from initial Z.
     z -= layer_height;
     
-    std::string new_gcode;
-    m_reader.parse_buffer(gcode, [&new_gcode, &z, &layer_height, &total_layer_length]
-        (GCodeReader &reader, GCodeReader::GCodeLine line) {
-        if (line.cmd_is("G1")) {
-            if (line.has_z()) {
-                // If this is the initial Z move of the layer, replace it with a
-                // (redundant) move to the last Z of previous layer.
-                line.set(reader, Z, z);
-                new_gcode += line.raw() + '\n';
-                return;
-            } else {
-                float dist_XY = line.dist_XY(reader);
-                if (dist_XY > 0) {
-                    // horizontal move
-                    if (line.extruding(reader)) {
-                        z += dist_XY * layer_height / total_layer_length;
-                        line.set(reader, Z, z);
-                        new_gcode += line.raw() + '\n';
-                    }
-                    return;
-                
-                    /*  Skip travel moves: the move to first perimeter point will
-                        cause a visible seam when loops are not aligned in XY; by skipping
-                        it we blend the first loop move in the XY plane (although the smoothness
-                        of such blend depend on how long the first segment is; maybe we should
-                        enforce some minimum length?).  */
-                }
-            }
+    for (GCodeLines::Line &line : gcode) {
+        if (line.type != GCodeLines::Line::G1) {
+            this->update_position(m_position, line);
+            continue;
         }
-        new_gcode += line.raw() + '\n';
-    });
-    
-    return new_gcode;
+        // The position is updated with the source line, before its Z is edited.
+        bool  has_z   = line.has(Z);
+        float dist    = dist_XY(m_position, line);
+        bool  extrude = extruding(m_position, line);
+        this->update_position(m_position, line);
+        if (has_z) {
+            // If this is the initial Z move of the layer, replace it with a
+            // (redundant) move to the last Z of previous layer.
+            gcode.set_axis(line, Z, z);
+        } else if (dist > 0) {
+            // horizontal move
+            if (extrude) {
+                z += dist * layer_height / total_layer_length;
+                gcode.set_axis(line, Z, z);
+            } else
+                /*  Skip travel moves: the move to first perimeter point will
+                    cause a visible seam when loops are not aligned in XY; by skipping
+                    it we blend the first loop move in the XY plane (although the smoothness
+                    of such blend depend on how long the first segment is; maybe we should
+                    enforce some minimum length?).  */
+                gcode.remove(line);
+        }
+    }
 }
 
 }
@@ -2,7 +2,8 @@
 #define slic3r_SpiralVase_hpp_
 
 #include "../libslic3r.h"
-#include "../GCodeReader.hpp"
+#include "../PrintConfig.hpp"
+#include "GCodeLines.hpp"
 
 namespace Slic3r {
 
@@ -12,14 +13,18 @@ public:
     
     SpiralVase(const PrintConfig &config) : m_config(&config)
     {
-        m_reader.z() = (float)m_config->z_offset;
-        m_reader.apply_config(*m_config);
+        m_position[Z] = (float)m_config->z_offset;
     };
-    std::string process_layer(const std::string &gcode);
+    // Edit the G-code lines of a layer in place.
+    void process_layer(GCodeLines &gcode);
     
 private:
+    // Update the tool position the same way GCodeReader does.
+    void update_position(float *position, const GCodeLines::Line &line) const;
+
     const PrintConfig  *m_config;
-    GCodeReader 		m_reader;
+    // X,Y,Z,E,F of the G-code processed so far.
+    float               m_position[NUM_AXES] = { 0.f, 0.f, 0.f, 0.f, 0.f };
 };
 
 }
@@ -15,6 +15,7 @@
 #include <limits>
 
 #include <libslic3r.h>
+#include "../Execution.hpp"
 
 
 namespace Slic3r {
@@ -191,7 +192,9 @@ void ToolOrdering::collect_extruders(const PrintObject &object, const std::vecto
 	it_per_layer_extruder_override = per_layer_extruder_switches.begin();
     unsigned int extruder_override = 0;
 
-    // Collect the object extruders.
+    // Assign the object layers to the LayerTools first, so that the object layers may be analyzed in parallel.
+    std::vector<LayerTools*> object_layer_tools;
+    object_layer_tools.reserve(object.layers().size());
     for (auto layer : object.layers()) {
         LayerTools &layer_tools = this->tools_for_layer(layer->print_z);
 
@@ -199,62 +202,97 @@ void ToolOrdering::collect_extruders(const PrintObject &object, const std::vecto
     	for (; it_per_layer_extruder_override != per_layer_extruder_switches.end() && it_per_layer_extruder_override->first < layer->print_z + EPSILON; ++ it_per_layer_extruder_override)
     		extruder_override = (int)it_per_layer_extruder_override->second;
 
-        // Store the current extruder override (set to zero if no overriden), so that layer_tools.wiping_extrusions().is_overridable_and_mark() will use it.
+        // Store the current extruder override (set to zero if no overriden), so that layer_tools.wiping_extrusions().is_overridable() will use it.
         layer_tools.extruder_override = extruder_override;
+        // Let the wiping extrusions know their LayerTools before they are queried from the worker threads.
+        layer_tools.wiping_extrusions();
+        object_layer_tools.emplace_back(&layer_tools);
+    }
 
-        // What extruders are required to print this object layer?
-        for (size_t region_id = 0; region_id < object.region_volumes.size(); ++ region_id) {
-            const LayerRegion *layerm = (region_id < layer->regions().size()) ? layer->regions()[region_id] : nullptr;
-            if (layerm == nullptr)
-                continue;
-            const PrintRegion &region = *object.print()->regions()[region_id];
+    // What extruders are required to print the object layers?
+    struct LayerExtruders {
+        std::vector<unsigned int> extruders;
+        bool                      has_object            = false;
+        bool                      something_overridable = false;
+    };
+    std::vector<LayerExtruders> layer_extruders(object.layers().size());
+    execution::parallel_for(object.print()->execution_policy(), tbb::blocked_range<size_t>(0, object.layers().size()),
+        [this, &object, &object_layer_tools, &layer_extruders](const tbb::blocked_range<size_t> &range) {
+        for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+            const Layer            *layer             = object.layers()[layer_idx];
+            const LayerTools       &layer_tools       = *object_layer_tools[layer_idx];
+            const WipingExtrusions &wiping_extrusions = layer_tools.wiping_extrusions();
+            const unsigned int      extruder_override = layer_tools.extruder_override;
+            LayerExtruders         &out               = layer_extruders[layer_idx];
+            auto is_overriddable = [this, &object, &wiping_extrusions, &out](const ExtrusionEntityCollection &eec, const PrintRegion &region) {
+                bool overriddable = wiping_extrusions.is_overriddable(eec, *m_print_config_ptr, object, region);
+                out.something_overridable |= overriddable;
+                return overriddable;
+            };
+
+            for (size_t region_id = 0; region_id < object.region_volumes.size(); ++ region_id) {
+                const LayerRegion *layerm = (region_id < layer->regions().size()) ? layer->regions()[region_id] : nullptr;
+                if (layerm == nullptr)
+                    continue;
+                const PrintRegion &region = *object.print()->regions()[region_id];
 
-            if (! layerm->perimeters.entities.empty()) {
-                bool something_nonoverriddable = true;
+                if (! layerm->perimeters.entities.empty()) {
+                    bool something_nonoverriddable = true;
 
-                if (m_print_config_ptr) { // in this case complete_objects is false (see ToolOrdering constructors)
-                    something_nonoverriddable = false;
-                    for (const auto& eec : layerm->perimeters.entities) // let's check if there are nonoverriddable entities
-                        if (!layer_tools.wiping_extrusions().is_overriddable_and_mark(dynamic_cast<const ExtrusionEntityCollection&>(*eec), *m_print_config_ptr, object, region))
-                            something_nonoverriddable = true;
-                }
+                    if (m_print_config_ptr) { // in this case complete_objects is false (see ToolOrdering constructors)
+                        something_nonoverriddable = false;
+                        for (const auto& eec : layerm->perimeters.entities) // let's check if there are nonoverriddable entities
+                            if (! is_overriddable(dynamic_cast<const ExtrusionEntityCollection&>(*eec), region))
+                                something_nonoverriddable = true;
+                    }
 
-                if (something_nonoverriddable)
-               		layer_tools.extruders.emplace_back((extruder_override == 0) ? region.config().perimeter_extruder.value : extruder_override);
+                    if (something_nonoverriddable)
+                        out.extruders.emplace_back((extruder_override == 0) ? region.config().perimeter_extruder.value : extruder_override);
 
-                layer_tools.has_object = true;
-            }
+                    out.has_object = true;
+                }
 
-            bool has_infill       = false;
-            bool has_solid_infill = false;
-            bool something_nonoverriddable = false;
-            for (const ExtrusionEntity *ee : layerm->fills.entities) {
-                // fill represents infill extrusions of a single island.
-                const auto *fill = dynamic_cast<const ExtrusionEntityCollection*>(ee);
-                ExtrusionRole role = fill->entities.empty() ? erNone : fill->entities.front()->role();
-                if (is_solid_infill(role))
-                    has_solid_infill = true;
-                else if (role != erNone)
-                    has_infill = true;
-
-                if (m_print_config_ptr) {
-                    if (! layer_tools.wiping_extrusions().is_overriddable_and_mark(*fill, *m_print_config_ptr, object, region))
-                        something_nonoverriddable = true;
+                bool has_infill       = false;
+                bool has_solid_infill = false;
+                bool something_nonoverriddable = false;
+                for (const ExtrusionEntity *ee : layerm->fills.entities) {
+                    // fill represents infill extrusions of a single island.
+                    const auto *fill = dynamic_cast<const ExtrusionEntityCollection*>(ee);
+                    ExtrusionRole role = fill->entities.empty() ? erNone : fill->entities.front()->role();
+                    if (is_solid_infill(role))
+                        has_solid_infill = true;
+                    else if (role != erNone)
+                        has_infill = true;
+
+                    if (m_print_config_ptr) {
+                        if (! is_overriddable(*fill, region))
+                            something_nonoverriddable = true;
+                    }
                 }
-            }
 
-            if (something_nonoverriddable || !m_print_config_ptr) {
-            	if (extruder_override == 0) {
-	                if (has_solid_infill)
-	                    layer_tools.extruders.emplace_back(region.config().solid_infill_extruder);
-	                if (has_infill)
-	                    layer_tools.extruders.emplace_back(region.config().infill_extruder);
-            	} else if (has_solid_infill || has_infill)
-            		layer_tools.extruders.emplace_back(extruder_override);
+                if (something_nonoverriddable || !m_print_config_ptr) {
+                    if (extruder_override == 0) {
+                        if (has_solid_infill)
+                            out.extruders.emplace_back(region.config().solid_infill_extruder);
+                        if (has_infill)
+                            out.extruders.emplace_back(region.config().infill_extruder);
+                    } else if (has_solid_infill || has_infill)
+                        out.extruders.emplace_back(extruder_override);
+                }
+                if (has_solid_infill || has_infill)
+                    out.has_object = true;
             }
-            if (has_solid_infill || has_infill)
-                layer_tools.has_object = true;
         }
+    });
+
+    // Merge the extruders of the object layers into the LayerTools in the order of the object layers.
+    for (size_t layer_idx = 0; layer_idx < layer_extruders.size(); ++ layer_idx) {
+        LayerTools     &layer_tools = *object_layer_tools[layer_idx];
+        LayerExtruders &src         = layer_extruders[layer_idx];
+        append(layer_tools.extruders, std::move(src.extruders));
+        layer_tools.has_object |= src.has_object;
+        if (src.something_overridable)
+            layer_tools.wiping_extrusions().mark_overridable();
     }
 
     for (auto& layer : m_layer_tools) {
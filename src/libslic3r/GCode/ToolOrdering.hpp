@@ -42,11 +42,8 @@ public:
     void ensure_perimeters_infills_order(const Print& print);
 
     bool is_overriddable(const ExtrusionEntityCollection& ee, const PrintConfig& print_config, const PrintObject& object, const PrintRegion& region) const;
-    bool is_overriddable_and_mark(const ExtrusionEntityCollection& ee, const PrintConfig& print_config, const PrintObject& object, const PrintRegion& region) {
-    	bool out = this->is_overriddable(ee, print_config, object, region);
-    	this->something_overridable |= out;
-    	return out;
-    }
+    // Called by ToolOrdering::collect_extruders() once an overriddable entity was found on this layer.
+    void mark_overridable() { this->something_overridable = true; }
 
     void set_layer_tools_ptr(const LayerTools* lt) { m_layer_tools = lt; }
 
@@ -114,6 +111,8 @@ public:
         m_wiping_extrusions.set_layer_tools_ptr(this);
         return m_wiping_extrusions;
     }
+    // The non-const accessor has to be called first to point the wiping extrusions to this LayerTools.
+    const WipingExtrusions& wiping_extrusions() const { return m_wiping_extrusions; }
 
 private:
     // This object holds list of extrusion that will be used for extruder wiping
@@ -7,6 +7,7 @@
 
 #include "GCodeProcessor.hpp"
 #include "BoundingBox.hpp"
+#include "Execution.hpp"
 
 
 // Experimental "Peter's wipe tower" feature was partially implemented, inspired by
@@ -1302,9 +1303,87 @@ void WipeTower::save_on_last_wipe()
     }
 }
 
+WipeTower::GeneratorState WipeTower::generator_state() const
+{
+    return { m_current_tool, m_old_temperature, m_num_layer_changes, m_num_tool_changes, m_current_shape, m_internal_rotation, m_y_shift };
+}
+
+void WipeTower::set_generator_state(const GeneratorState &state)
+{
+    m_current_tool      = state.current_tool;
+    m_old_temperature   = state.old_temperature;
+    m_num_layer_changes = state.num_layer_changes;
+    m_num_tool_changes  = state.num_tool_changes;
+    m_current_shape     = state.current_shape;
+    m_internal_rotation = state.internal_rotation;
+    m_y_shift           = state.y_shift;
+}
+
+// Mirrors the state changes of set_layer(), generate_layer() and tool_change().
+void WipeTower::advance_generator_state(GeneratorState &state, const WipeTowerInfo &layer, bool first_layer) const
+{
+    if (first_layer) {
+        state.num_layer_changes = 0;
+        state.num_tool_changes  = 0;
+    } else
+        ++ state.num_layer_changes;
+    state.current_shape = (! first_layer && state.current_shape == SHAPE_NORMAL) ? SHAPE_REVERSED : SHAPE_NORMAL;
+    state.internal_rotation += m_peters_wipe_tower ? 90.f : 180.f;
+    if (!m_peters_wipe_tower && layer.depth < m_wipe_tower_depth - m_perimeter_width)
+        state.y_shift = (m_wipe_tower_depth-layer.depth-m_perimeter_width)/2.f;
+
+    // The first tool change of the first layer prints the brim only.
+    for (size_t i = first_layer ? 1 : 0; i < layer.tool_changes.size(); ++ i) {
+        size_t tool            = layer.tool_changes[i].new_tool;
+        int    new_temperature = first_layer ? m_filpar[tool].first_layer_temperature : m_filpar[tool].temperature;
+        if (m_semm && new_temperature != 0 && (new_temperature != state.old_temperature || first_layer))
+            state.old_temperature = new_temperature;
+        state.current_tool = tool;
+        ++ state.num_tool_changes;
+    }
+}
+
+std::vector<WipeTower::ToolChangeResult> WipeTower::generate_layer(const WipeTowerInfo &layer, bool first_layer, bool last_layer)
+{
+    std::vector<WipeTower::ToolChangeResult> layer_result;
+
+    set_layer(layer.z,layer.height,0,first_layer,last_layer);
+    if (m_peters_wipe_tower)
+        m_internal_rotation += 90.f;
+    else
+        m_internal_rotation += 180.f;
+
+    if (!m_peters_wipe_tower && m_layer_info->depth < m_wipe_tower_depth - m_perimeter_width)
+        m_y_shift = (m_wipe_tower_depth-m_layer_info->depth-m_perimeter_width)/2.f;
+
+    for (const auto &toolchange : layer.tool_changes)
+        layer_result.emplace_back(tool_change(toolchange.new_tool));
+
+    if (! layer_finished()) {
+        auto finish_layer_toolchange = finish_layer();
+        if ( ! layer.tool_changes.empty() ) { // we will merge it to the last toolchange
+            auto& last_toolchange = layer_result.back();
+            if (last_toolchange.end_pos != finish_layer_toolchange.start_pos) {
+                char buf[2048];     // Add a travel move from tc1.end_pos to tc2.start_pos.
+                sprintf(buf, "G1 X%.3f Y%.3f F7200\n", finish_layer_toolchange.start_pos.x(), finish_layer_toolchange.start_pos.y());
+                last_toolchange.gcode += buf;
+            }
+            last_toolchange.gcode += finish_layer_toolchange.gcode;
+            last_toolchange.extrusions.insert(last_toolchange.extrusions.end(), finish_layer_toolchange.extrusions.begin(), finish_layer_toolchange.extrusions.end());
+            last_toolchange.end_pos = finish_layer_toolchange.end_pos;
+            last_toolchange.wipe_path = finish_layer_toolchange.wipe_path;
+        }
+        else
+            layer_result.emplace_back(std::move(finish_layer_toolchange));
+    }
+
+    m_is_first_layer = false;
+    return layer_result;
+}
+
 // Processes vector m_plan and calls respective functions to generate G-code for the wipe tower
 // Resulting ToolChangeResults are appended into vector "result"
-void WipeTower::generate(std::vector<std::vector<WipeTower::ToolChangeResult>> &result)
+void WipeTower::generate(std::vector<std::vector<WipeTower::ToolChangeResult>> &result, const ExecutionPolicy &policy)
 {
 	if (m_plan.empty())
 
@@ -1336,42 +1415,67 @@ void WipeTower::generate(std::vector<std::vector<WipeTower::ToolChangeResult>> &
 
     m_old_temperature = -1; // reset last temperature written in the gcode
 
-    std::vector<WipeTower::ToolChangeResult> layer_result;
-	for (auto layer : m_plan)
-	{
-		set_layer(layer.z,layer.height,0,layer.z == m_plan.front().z,layer.z == m_plan.back().z);
-		if (m_peters_wipe_tower)
-			m_internal_rotation += 90.f;
-		else
-            m_internal_rotation += 180.f;
-
-		if (!m_peters_wipe_tower && m_layer_info->depth < m_wipe_tower_depth - m_perimeter_width)
-			m_y_shift = (m_wipe_tower_depth-m_layer_info->depth-m_perimeter_width)/2.f;
-
-		for (const auto &toolchange : layer.tool_changes)
-            layer_result.emplace_back(tool_change(toolchange.new_tool));
-
-		if (! layer_finished()) {
-            auto finish_layer_toolchange = finish_layer();
-            if ( ! layer.tool_changes.empty() ) { // we will merge it to the last toolchange
-                auto& last_toolchange = layer_result.back();
-                if (last_toolchange.end_pos != finish_layer_toolchange.start_pos) {
-                    char buf[2048];     // Add a travel move from tc1.end_pos to tc2.start_pos.
-					sprintf(buf, "G1 X%.3f Y%.3f F7200\n", finish_layer_toolchange.start_pos.x(), finish_layer_toolchange.start_pos.y());
-					last_toolchange.gcode += buf;
-				}
-                last_toolchange.gcode += finish_layer_toolchange.gcode;
-                last_toolchange.extrusions.insert(last_toolchange.extrusions.end(), finish_layer_toolchange.extrusions.begin(), finish_layer_toolchange.extrusions.end());
-                last_toolchange.end_pos = finish_layer_toolchange.end_pos;
-                last_toolchange.wipe_path = finish_layer_toolchange.wipe_path;
+    // Once the plan is fixed, a layer only depends on the layers below through the generator state, which follows
+    // from the planned tool changes, and through the wiping direction, which is reset by the first tool change of a layer.
+    // Split the plan into runs of layers starting with a layer with tool changes, capture the generator state
+    // at the start of each run and generate the runs concurrently.
+    std::vector<size_t>         run_begin;
+    std::vector<GeneratorState> run_state;
+    {
+        GeneratorState state = this->generator_state();
+        for (size_t i = 0; i < m_plan.size(); ++ i) {
+            bool first_layer = m_plan[i].z == m_plan.front().z;
+            if (i == 0 || ! m_plan[i].tool_changes.empty()) {
+                run_begin.emplace_back(i);
+                run_state.emplace_back(state);
             }
-            else
-                layer_result.emplace_back(std::move(finish_layer_toolchange));
+            this->advance_generator_state(state, m_plan[i], first_layer);
         }
-
-		result.emplace_back(std::move(layer_result));
-		m_is_first_layer = false;
-	}
+    }
+    // Each generator holds a copy of the whole plan, as the ramming looks at the layer below.
+    // Merge the runs into a few chunks to limit the number of copies. A single thread generates the whole plan by itself.
+    size_t num_threads = policy.max_threads == 0 ? execution::max_threads() : policy.max_threads;
+    size_t num_chunks  = num_threads == 1 ? 1 : std::min(run_begin.size(), 4 * num_threads);
+    size_t chunk_size  = (run_begin.size() + num_chunks - 1) / num_chunks;
+    num_chunks         = (run_begin.size() + chunk_size - 1) / chunk_size;
+    auto   chunk_begin = [&run_begin, chunk_size, this](size_t chunk_idx) {
+        return chunk_idx * chunk_size < run_begin.size() ? run_begin[chunk_idx * chunk_size] : m_plan.size();
+    };
+
+    // All chunks but the last one are generated by copies of this wipe tower.
+    // The last chunk is generated by this wipe tower, leaving it in the state expected by the final purge.
+    std::vector<WipeTower> generators;
+    generators.reserve(num_chunks - 1);
+    for (size_t chunk_idx = 0; chunk_idx + 1 < num_chunks; ++ chunk_idx) {
+        generators.emplace_back(*this);
+        generators.back().m_layer_info = generators.back().m_plan.begin() + chunk_begin(chunk_idx);
+    }
+    m_layer_info = m_plan.begin() + chunk_begin(num_chunks - 1);
+
+    std::vector<std::vector<std::vector<WipeTower::ToolChangeResult>>> chunk_results(num_chunks);
+    execution::for_each(policy, size_t(0), num_chunks,
+        [this, &generators, &run_state, chunk_size, &chunk_begin, &chunk_results](size_t chunk_idx) {
+            WipeTower &generator = chunk_idx < generators.size() ? generators[chunk_idx] : *this;
+            generator.set_generator_state(run_state[chunk_idx * chunk_size]);
+            for (size_t i = chunk_begin(chunk_idx); i < chunk_begin(chunk_idx + 1); ++ i) {
+                const WipeTowerInfo &layer = generator.m_plan[i];
+                chunk_results[chunk_idx].emplace_back(generator.generate_layer(layer, layer.z == generator.m_plan.front().z, layer.z == generator.m_plan.back().z));
+            }
+        });
+
+    // Merge the chunks in the order of the layers.
+    std::vector<float> used_filament_length(m_used_filament_length.size(), 0.f);
+    for (size_t chunk_idx = 0; chunk_idx < num_chunks; ++ chunk_idx) {
+        const WipeTower &generator = chunk_idx < generators.size() ? generators[chunk_idx] : *this;
+        for (size_t i = 0; i < used_filament_length.size(); ++ i)
+            used_filament_length[i] += generator.m_used_filament_length[i];
+        for (std::vector<WipeTower::ToolChangeResult> &layer_result : chunk_results[chunk_idx])
+            result.emplace_back(std::move(layer_result));
+    }
+    m_used_filament_length = std::move(used_filament_length);
+    if (! generators.empty())
+        // The brim is printed by the first chunk.
+        m_wipe_tower_brim_width = generators.front().m_wipe_tower_brim_width;
 }
 
 void WipeTower::make_wipe_tower_square()
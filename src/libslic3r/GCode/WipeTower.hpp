@@ -14,6 +14,7 @@ namespace Slic3r
 
 class WipeTowerWriter;
 class PrintConfig;
+struct ExecutionPolicy;
 enum GCodeFlavor : unsigned char;
 
 
@@ -105,7 +106,7 @@ public:
 	void plan_toolchange(float z_par, float layer_height_par, unsigned int old_tool, unsigned int new_tool, bool brim, float wipe_volume = 0.f);
 
 	// Iterates through prepared m_plan, generates ToolChangeResults and appends them to "result"
-	void generate(std::vector<std::vector<ToolChangeResult>> &result);
+	void generate(std::vector<std::vector<ToolChangeResult>> &result, const ExecutionPolicy &policy);
 
     float get_depth() const { return m_wipe_tower_depth; }
     float get_brim_width() const { return m_wipe_tower_brim_width; }
@@ -361,6 +362,24 @@ private:
 	// offset			-- set to 0		-- experimental, offset to replace brim in front / rear of wipe tower
 	ToolChangeResult toolchange_Brim(bool sideOnly = false, float y_offset = 0.f);
 
+	// State of the G-code generator carried over from a wipe tower layer to the layers above.
+	struct GeneratorState {
+		size_t       current_tool;
+		int          old_temperature;
+		unsigned int num_layer_changes;
+		unsigned int num_tool_changes;
+		wipe_shape   current_shape;
+		float        internal_rotation;
+		float        y_shift;
+	};
+	GeneratorState generator_state() const;
+	void set_generator_state(const GeneratorState &state);
+	// Updates the state as if the layer was generated, without generating it.
+	void advance_generator_state(GeneratorState &state, const WipeTowerInfo &layer, bool first_layer) const;
+
+	// Generates a single layer of m_plan, the generator state has to be set to the end of the layer below.
+	std::vector<ToolChangeResult> generate_layer(const WipeTowerInfo &layer, bool first_layer, bool last_layer);
+
 	void toolchange_Unload(
 		WipeTowerWriter &writer,
 		const box_coordinates  &cleaning_box, 
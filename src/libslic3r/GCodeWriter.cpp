@@ -1,6 +1,7 @@
 #include "GCodeWriter.hpp"
 #include "CustomGCode.hpp"
 #include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <map>
@@ -9,12 +10,51 @@
 #define FLAVOR_IS(val) this->config.gcode_flavor == val
 #define FLAVOR_IS_NOT(val) this->config.gcode_flavor != val
 #define COMMENT(comment) if (this->config.gcode_comments && !comment.empty()) gcode << " ; " << comment;
-#define PRECISION(val, precision) std::fixed << std::setprecision(precision) << (val)
-#define XYZF_NUM(val) PRECISION(val, 3)
-#define E_NUM(val) PRECISION(val, 5)
+#define XYZF_NUM(val) GCodeFormatter::fixed(val, 3)
+#define E_NUM(val) GCodeFormatter::fixed(val, 5)
 
 namespace Slic3r {
 
+void GCodeFormatter::append_fixed(std::string &out, double value, int digits)
+{
+    static constexpr const double pow10[] = { 1., 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+    assert(digits >= 0 && digits <= 9);
+    double a      = std::abs(value);
+    double scaled = a * pow10[digits];
+    if (! (scaled < 4503599627370496.)) {
+        // Beyond 2^52 the fractional part of the scaled value is not representable, NaN or infinity.
+        // Such values are never emitted for a print, leave them to the stream.
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(digits) << value;
+        out += ss.str();
+        return;
+    }
+    // Round the exact decimal value of a * 10^digits to nearest, ties to even, the same way printf() does.
+    // The product is rounded, however scaled + err == a * 10^digits exactly. With scaled < 2^52,
+    // frac is a multiple of the ulp of scaled, while |err| <= ulp / 2, thus err only decides the exact ties of frac.
+    double   n    = std::floor(scaled);
+    double   frac = scaled - n;
+    double   err  = std::fma(a, pow10[digits], - scaled);
+    uint64_t r    = uint64_t(n);
+    if (frac > 0.5 || (frac == 0.5 && (err > 0. || (err == 0. && (r & 1) != 0))))
+        ++ r;
+    // Write the digits from the back.
+    char  buf[32];
+    char *end = buf + sizeof(buf);
+    char *ptr = end;
+    for (int i = 0; i < digits; ++ i, r /= 10)
+        *(-- ptr) = char('0' + r % 10);
+    if (digits > 0)
+        *(-- ptr) = '.';
+    do {
+        *(-- ptr) = char('0' + r % 10);
+        r /= 10;
+    } while (r > 0);
+    if (std::signbit(value))
+        *(-- ptr) = '-';
+    out.append(ptr, end - ptr);
+}
+
 void GCodeWriter::apply_print_config(const PrintConfig &print_config)
 {
     this->config.apply(print_config, true);
@@ -283,12 +323,12 @@ std::string GCodeWriter::set_speed(double F, const std::string &comment, const s
 {
     assert(F > 0.);
     assert(F < 100000.);
-    std::ostringstream gcode;
+    GCodeFormatter gcode;
     gcode << "G1 F" << XYZF_NUM(F);
     COMMENT(comment);
     gcode << cooling_marker;
     gcode << "\n";
-    return gcode.str();
+    return gcode.string();
 }
 
 std::string GCodeWriter::travel_to_xy(const Vec2d &point, const std::string &comment)
@@ -296,13 +336,13 @@ std::string GCodeWriter::travel_to_xy(const Vec2d &point, const std::string &com
     m_pos(0) = point(0);
     m_pos(1) = point(1);
     
-    std::ostringstream gcode;
+    GCodeFormatter gcode;
     gcode << "G1 X" << XYZF_NUM(point(0))
           <<   " Y" << XYZF_NUM(point(1))
           <<   " F" << XYZF_NUM(this->config.travel_speed.value * 60.0);
     COMMENT(comment);
     gcode << "\n";
-    return gcode.str();
+    return gcode.string();
 }
 
 std::string GCodeWriter::travel_to_xyz(const Vec3d &point, const std::string &comment)
@@ -326,14 +366,14 @@ std::string GCodeWriter::travel_to_xyz(const Vec3d &point, const std::string &co
     m_lifted = 0;
     m_pos = point;
     
-    std::ostringstream gcode;
+    GCodeFormatter gcode;
     gcode << "G1 X" << XYZF_NUM(point(0))
           <<   " Y" << XYZF_NUM(point(1))
           <<   " Z" << XYZF_NUM(point(2))
           <<   " F" << XYZF_NUM(this->config.travel_speed.value * 60.0);
     COMMENT(comment);
     gcode << "\n";
-    return gcode.str();
+    return gcode.string();
 }
 
 std::string GCodeWriter::travel_to_z(double z, const std::string &comment)
@@ -359,12 +399,12 @@ std::string GCodeWriter::_travel_to_z(double z, const std::string &comment)
 {
     m_pos(2) = z;
     
-    std::ostringstream gcode;
+    GCodeFormatter gcode;
     gcode << "G1 Z" << XYZF_NUM(z)
           <<   " F" << XYZF_NUM(this->config.travel_speed.value * 60.0);
     COMMENT(comment);
     gcode << "\n";
-    return gcode.str();
+    return gcode.string();
 }
 
 bool GCodeWriter::will_move_z(double z) const
@@ -385,13 +425,13 @@ std::string GCodeWriter::extrude_to_xy(const Vec2d &point, double dE, const std:
     m_pos(1) = point(1);
     m_extruder->extrude(dE);
     
-    std::ostringstream gcode;
+    GCodeFormatter gcode;
     gcode << "G1 X" << XYZF_NUM(point(0))
           <<   " Y" << XYZF_NUM(point(1))
           <<    " " << m_extrusion_axis << E_NUM(m_extruder->E());
     COMMENT(comment);
     gcode << "\n";
-    return gcode.str();
+    return gcode.string();
 }
 
 std::string GCodeWriter::extrude_to_xyz(const Vec3d &point, double dE, const std::string &comment)
@@ -400,14 +440,14 @@ std::string GCodeWriter::extrude_to_xyz(const Vec3d &point, double dE, const std
     m_lifted = 0;
     m_extruder->extrude(dE);
     
-    std::ostringstream gcode;
+    GCodeFormatter gcode;
     gcode << "G1 X" << XYZF_NUM(point(0))
           <<   " Y" << XYZF_NUM(point(1))
           <<   " Z" << XYZF_NUM(point(2))
           <<    " " << m_extrusion_axis << E_NUM(m_extruder->E());
     COMMENT(comment);
     gcode << "\n";
-    return gcode.str();
+    return gcode.string();
 }
 
 std::string GCodeWriter::retract(bool before_wipe)
@@ -434,7 +474,7 @@ std::string GCodeWriter::retract_for_toolchange(bool before_wipe)
 
 std::string GCodeWriter::_retract(double length, double restart_extra, const std::string &comment)
 {
-    std::ostringstream gcode;
+    GCodeFormatter gcode;
     
     /*  If firmware retraction is enabled, we use a fake value of 1
         since we ignore the actual configured retract_length which 
@@ -467,12 +507,12 @@ std::string GCodeWriter::_retract(double length, double restart_extra, const std
     if (FLAVOR_IS(gcfMakerWare))
         gcode << "M103 ; extruder off\n";
     
-    return gcode.str();
+    return gcode.string();
 }
 
 std::string GCodeWriter::unretract()
 {
-    std::ostringstream gcode;
+    GCodeFormatter gcode;
     
     if (FLAVOR_IS(gcfMakerWare))
         gcode << "M101 ; extruder on\n";
@@ -494,7 +534,7 @@ std::string GCodeWriter::unretract()
         }
     }
     
-    return gcode.str();
+    return gcode.string();
 }
 
 /*  If this method is called more than once before calling unlift(),
@@ -3,6 +3,7 @@
 
 #include "libslic3r.h"
 #include <string>
+#include <type_traits>
 #include "Extruder.hpp"
 #include "Point.hpp"
 #include "PrintConfig.hpp"
@@ -10,6 +11,38 @@
 
 namespace Slic3r {
 
+// Formats a G-code line into a string. Numbers are written with a fixed number of decimal digits
+// exactly as std::fixed << std::setprecision(digits) would write them, but without the overhead
+// of std::ostringstream and of its locale. The line is written straight into the string returned.
+class GCodeFormatter {
+public:
+    // A number to be written with a fixed number of decimal digits.
+    struct Fixed {
+        double  value;
+        int     digits;
+    };
+    static Fixed    fixed(double value, int digits) { return { value, digits }; }
+
+    GCodeFormatter() { m_str.reserve(64); }
+
+    GCodeFormatter& operator<<(const char *s)        { m_str += s; return *this; }
+    GCodeFormatter& operator<<(const std::string &s) { m_str += s; return *this; }
+    GCodeFormatter& operator<<(char c)               { m_str += c; return *this; }
+    GCodeFormatter& operator<<(const Fixed &f)       { append_fixed(m_str, f.value, f.digits); return *this; }
+    // Numbers have to be written through fixed(), otherwise an int or a double would be silently converted to a char.
+    template<typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value && ! std::is_same<T, char>::value>>
+    GCodeFormatter& operator<<(T) = delete;
+
+    // Move the formatted G-code out of the formatter.
+    std::string     string() { return std::move(m_str); }
+
+    // Append value with a fixed number of decimal digits (at most 9) to out.
+    static void     append_fixed(std::string &out, double value, int digits);
+
+private:
+    std::string     m_str;
+};
+
 class GCodeWriter {
 public:
     GCodeConfig config;
@@ -9,6 +9,7 @@
 
 namespace Slic3r {
 
+class FillPatternCache;
 class Layer;
 class PrintRegion;
 class PrintObject;
@@ -139,7 +140,7 @@ public:
     }
     void                    make_perimeters();
     void                    make_fills() { this->make_fills(nullptr, nullptr); };
-    void                    make_fills(FillAdaptive::Octree* adaptive_fill_octree, FillAdaptive::Octree* support_fill_octree);
+    void                    make_fills(FillAdaptive::Octree* adaptive_fill_octree, FillAdaptive::Octree* support_fill_octree, FillPatternCache* pattern_cache = nullptr);
     void 					make_ironing();
 
     void                    export_region_slices_to_svg(const char *path) const;
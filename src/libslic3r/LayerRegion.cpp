@@ -267,7 +267,7 @@ void LayerRegion::process_external_surfaces(const Layer *lower_layer, const Poly
                 printf("Processing bridge at layer %zu:\n", this->layer()->id());
                 #endif
 				double custom_angle = Geometry::deg2rad(this->region()->config().bridge_angle.value);
-				if (bd.detect_angle(custom_angle)) {
+				if (bd.detect_angle(this->layer()->object()->print()->execution_policy(), custom_angle)) {
                     bridges[idx_last].bridge_angle = bd.angle;
                     if (this->layer()->object()->config().support_material) {
                         polygons_append(this->bridged, bd.coverage());
@@ -1,6 +1,7 @@
 #ifndef slic3r_ObjectID_hpp_
 #define slic3r_ObjectID_hpp_
 
+#include <atomic>
 #include <cereal/access.hpp>
 
 namespace Slic3r {
@@ -44,8 +45,8 @@ private:
 // to synchronize the front end (UI) with the back end (BackgroundSlicingProcess / Print / PrintObject).
 // Also base for Print, PrintObject, SLAPrint, SLAPrintObject to provide a unique ID for matching Model / ModelObject
 // with their corresponding Print / PrintObject objects by the notification center at the UI when processing back-end warnings.
-// Achtung! The s_last_id counter is not thread safe, so it is expected, that the ObjectBase derived instances
-// are only instantiated from the main thread.
+// The s_last_id counter is atomic, so that models may be loaded and printed by multiple threads at once,
+// for example by the batch slicing of the command line interface.
 class ObjectBase
 {
 public:
@@ -81,7 +82,7 @@ private:
     ObjectID                m_id;
 
 	static inline ObjectID  generate_new_id() { return ObjectID(++ s_last_id); }
-    static size_t           s_last_id;
+    static std::atomic<size_t> s_last_id;
 	
 	friend ObjectID wipe_tower_object_id();
 	friend ObjectID wipe_tower_instance_id();
@@ -124,7 +125,7 @@ public:
 private:
 	// The first timestamp is non-zero, as zero timestamp means the timestamp is not reliable.
 	Timestamp 			m_timestamp { 1 };
-    static Timestamp    s_last_timestamp;
+    static std::atomic<Timestamp> s_last_timestamp;
 	
 	friend class cereal::access;
 	friend class Slic3r::UndoRedo::StackImpl;
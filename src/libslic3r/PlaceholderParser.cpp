@@ -1322,6 +1322,233 @@ std::string PlaceholderParser::process(const std::string &templ, unsigned int cu
     return process_macro(templ, context);
 }
 
+// Helpers of PlaceholderParser::compile(). The scanner is conservative: Whatever it does not understand is left
+// to the macro processor, or the complete template is left to the macro processor.
+static inline bool compiler_is_space(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r'; }
+static inline bool compiler_is_identifier_start(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; }
+// Non-ASCII characters are considered to be a part of an identifier, so that a keyword followed by such a character is not detected as a keyword.
+static inline bool compiler_is_identifier_char(char c) { return compiler_is_identifier_start(c) || (c >= '0' && c <= '9') || (unsigned char)c >= 0x80; }
+
+static bool compiler_is_keyword(const std::string &word)
+{
+    static const char *keywords[] = { "and", "if", "int", "else", "elsif", "endif", "false", "min", "max", "not", "or", "true" };
+    for (const char *keyword : keywords)
+        if (word == keyword)
+            return true;
+    return false;
+}
+
+// Find the end of a {} macro tag starting at templ[begin] == '{'. Returns the position after the closing '}'
+// or std::string::npos if the tag is not terminated.
+static size_t compiler_find_macro_tag_end(const std::string &templ, size_t begin)
+{
+    assert(templ[begin] == '{');
+    // A regular expression may only follow the =~ or !~ operators, otherwise '/' is a division.
+    bool regex_allowed = false;
+    for (size_t i = begin + 1; i < templ.size(); ++ i) {
+        char c = templ[i];
+        if (c == '}')
+            return i + 1;
+        if (c == '{')
+            return std::string::npos;
+        if (c == '"' || (c == '/' && regex_allowed)) {
+            // Skip a string literal or a regular expression, both may contain escaped characters.
+            for (++ i; i < templ.size() && templ[i] != c; ++ i)
+                if (templ[i] == '\\')
+                    ++ i;
+            if (i >= templ.size())
+                return std::string::npos;
+            regex_allowed = false;
+        } else if (c == '~')
+            regex_allowed = templ[i - 1] == '=' || templ[i - 1] == '!';
+        else if (! compiler_is_space(c))
+            regex_allowed = false;
+    }
+    return std::string::npos;
+}
+
+// Extract the leading word of a {} macro tag templ[begin, end). Sets is_identifier if the tag contains just a single identifier.
+static std::string compiler_macro_tag_word(const std::string &templ, size_t begin, size_t end, bool &is_identifier)
+{
+    assert(templ[begin] == '{' && templ[end - 1] == '}');
+    size_t i = begin + 1;
+    -- end;
+    while (i < end && compiler_is_space(templ[i]))
+        ++ i;
+    size_t word_begin = i;
+    while (i < end && compiler_is_identifier_char(templ[i]))
+        ++ i;
+    std::string word = templ.substr(word_begin, i - word_begin);
+    while (i < end && compiler_is_space(templ[i]))
+        ++ i;
+    is_identifier = i == end && ! word.empty() && compiler_is_identifier_start(word.front()) &&
+        std::find_if(word.begin(), word.end(), [](char c){ return (unsigned char)c >= 0x80; }) == word.end();
+    return word;
+}
+
+PlaceholderParser::CompiledTemplate PlaceholderParser::compile(const std::string &templ)
+{
+    CompiledTemplate out;
+    out.m_source = templ;
+    std::vector<CompiledTemplate::Block> &blocks = out.m_blocks;
+    // Returns false if the template could not be split into blocks.
+    auto split_into_blocks = [&templ, &blocks]() -> bool {
+        // The macro processor skips the leading white spaces of the template.
+        size_t i = 0;
+        while (i < templ.size() && compiler_is_space(templ[i]))
+            ++ i;
+        if (i < templ.size() && (unsigned char)templ[i] >= 0x80)
+            // Possibly an ISO-8859-1 white space, leave the complete template to the macro processor.
+            return false;
+        while (i < templ.size()) {
+            if (templ[i] == '[') {
+                size_t j = i + 1;
+                while (j < templ.size() && compiler_is_identifier_char(templ[j]))
+                    ++ j;
+                std::string name = templ.substr(i + 1, j - i - 1);
+                if (j < templ.size() && templ[j] == ']' && ! name.empty() && compiler_is_identifier_start(name.front()) && ! compiler_is_keyword(name) &&
+                    std::find_if(name.begin(), name.end(), [](char c){ return (unsigned char)c >= 0x80; }) == name.end()) {
+                    blocks.push_back({ CompiledTemplate::btLegacyVariable, templ.substr(i, j + 1 - i), std::move(name) });
+                    i = j + 1;
+                } else {
+                    // Legacy vector indexing [variable[index]], possibly with white spaces.
+                    int depth = 0;
+                    for (j = i; j < templ.size(); ++ j)
+                        if (templ[j] == '[')
+                            ++ depth;
+                        else if (templ[j] == ']' && -- depth == 0)
+                            break;
+                    if (j == templ.size())
+                        return false;
+                    blocks.push_back({ CompiledTemplate::btMacro, templ.substr(i, j + 1 - i), std::string() });
+                    i = j + 1;
+                }
+            } else if (templ[i] == '{') {
+                size_t end = compiler_find_macro_tag_end(templ, i);
+                if (end == std::string::npos)
+                    return false;
+                bool        is_identifier;
+                std::string word = compiler_macro_tag_word(templ, i, end, is_identifier);
+                if (word == "if") {
+                    // Find the matching {endif}, the complete {if} block is processed by the macro processor.
+                    int depth = 1;
+                    while (depth > 0 && end < templ.size()) {
+                        if (templ[end] == '{') {
+                            size_t tag_end = compiler_find_macro_tag_end(templ, end);
+                            if (tag_end == std::string::npos)
+                                return false;
+                            bool        dummy;
+                            std::string tag_word = compiler_macro_tag_word(templ, end, tag_end, dummy);
+                            if (tag_word == "if")
+                                ++ depth;
+                            else if (tag_word == "endif")
+                                -- depth;
+                            end = tag_end;
+                        } else
+                            ++ end;
+                    }
+                    if (depth > 0)
+                        return false;
+                    blocks.push_back({ CompiledTemplate::btMacro, templ.substr(i, end - i), std::string() });
+                } else if (word == "elsif" || word == "else" || word == "endif")
+                    // Unpaired {elsif}, {else} or {endif}. Let the macro processor report the error.
+                    return false;
+                else if (is_identifier && ! compiler_is_keyword(word))
+                    blocks.push_back({ CompiledTemplate::btVariable, templ.substr(i, end - i), std::move(word) });
+                else
+                    blocks.push_back({ CompiledTemplate::btMacro, templ.substr(i, end - i), std::string() });
+                i = end;
+            } else {
+                size_t j = std::min(templ.find_first_of("[{", i), templ.size());
+                blocks.push_back({ CompiledTemplate::btText, templ.substr(i, j - i), std::string() });
+                i = j;
+            }
+        }
+        return true;
+    };
+    if (! split_into_blocks())
+        // Leave the complete template to the macro processor.
+        blocks.assign(1, { CompiledTemplate::btMacro, templ, std::string() });
+    return out;
+}
+
+// Expand a legacy [variable] the same way as MyContext::legacy_variable_expansion() does.
+// Returns false if the variable has to be expanded by the macro processor, namely the legacy vector indexing [variable_index] or errors.
+static bool expand_legacy_variable(const client::MyContext &context, const std::string &opt_key, std::string &output)
+{
+    const ConfigOption *opt = context.resolve_symbol(opt_key);
+    if (opt == nullptr)
+        return false;
+    if (opt->is_scalar())
+        output += opt->serialize();
+    else {
+        const ConfigOptionVectorBase *vec = static_cast<const ConfigOptionVectorBase*>(opt);
+        if (vec->empty())
+            return false;
+        size_t idx = context.current_extruder_id;
+        output += vec->vserialize()[(idx >= vec->size()) ? 0 : idx];
+    }
+    return true;
+}
+
+// Expand a {variable} the same way as MyContext::scalar_variable_reference() followed by expr::to_string() does.
+// Returns false if the variable has to be expanded by the macro processor, namely the FloatOrPercent variables or errors.
+static bool expand_scalar_variable(const client::MyContext &context, const std::string &opt_key, std::string &output)
+{
+    const ConfigOption *opt = context.resolve_symbol(opt_key);
+    if (opt == nullptr || opt->is_vector())
+        return false;
+    switch (opt->type()) {
+    case coFloat:
+    case coPercent:
+    {
+        std::ostringstream ss;
+        ss << opt->getFloat();
+        output += ss.str();
+        break;
+    }
+    case coInt:     output += std::to_string(opt->getInt()); break;
+    case coString:  output += static_cast<const ConfigOptionString*>(opt)->value; break;
+    case coPoint:   output += opt->serialize(); break;
+    case coBool:    output += opt->getBool() ? "true" : "false"; break;
+    default:        return false;
+    }
+    return true;
+}
+
+std::string PlaceholderParser::process(const CompiledTemplate &templ, unsigned int current_extruder_id, const DynamicConfig *config_override) const
+{
+    client::MyContext context;
+    context.external_config 	= this->external_config();
+    context.config              = &this->config();
+    context.config_override     = config_override;
+    context.current_extruder_id = current_extruder_id;
+    std::string output;
+    try {
+        for (const CompiledTemplate::Block &block : templ.m_blocks)
+            switch (block.type) {
+            case CompiledTemplate::btText:
+                output += block.text;
+                break;
+            case CompiledTemplate::btLegacyVariable:
+                if (! expand_legacy_variable(context, block.name, output))
+                    output += process_macro(block.text, context);
+                break;
+            case CompiledTemplate::btVariable:
+                if (! expand_scalar_variable(context, block.name, output))
+                    output += process_macro(block.text, context);
+                break;
+            case CompiledTemplate::btMacro:
+                output += process_macro(block.text, context);
+                break;
+            }
+    } catch (const Slic3r::PlaceholderParserError &) {
+        // Process the complete template to report the error in the context of the complete template.
+        return this->process(templ.source(), current_extruder_id, config_override);
+    }
+    return output;
+}
+
 // Evaluate a boolean expression using the full expressive power of the PlaceholderParser boolean expression syntax.
 // Throws Slic3r::RuntimeError on syntax or runtime error.
 bool PlaceholderParser::evaluate_boolean_expression(const std::string &templ, const DynamicConfig &config, const DynamicConfig *config_override)
@@ -11,7 +11,43 @@ namespace Slic3r {
 
 class PlaceholderParser
 {
-public:    
+public:
+    // Template pre-processed into a sequence of verbatim text blocks, plain variable references and macros.
+    // When a compiled template is processed, only the macros (expressions, {if} blocks, indexed variables) are parsed
+    // by the macro processor, the verbatim text and the plain variable references are expanded without parsing.
+    // A template is compiled once and then processed repeatedly, for example the layer G-code for each layer.
+    class CompiledTemplate
+    {
+    public:
+        const std::string&  source() const { return m_source; }
+        bool                empty() const { return m_source.empty(); }
+
+    private:
+        friend class PlaceholderParser;
+
+        enum BlockType {
+            // Verbatim text.
+            btText,
+            // Legacy [variable] expansion.
+            btLegacyVariable,
+            // {variable} expansion.
+            btVariable,
+            // Anything else, to be processed by the macro processor.
+            btMacro,
+        };
+        struct Block {
+            BlockType       type;
+            // Source text of the block.
+            std::string     text;
+            // Name of the variable for btLegacyVariable and btVariable.
+            std::string     name;
+        };
+
+        std::string         m_source;
+        std::vector<Block>  m_blocks;
+    };
+
+
     PlaceholderParser(const DynamicConfig *external_config = nullptr);
     
     // Return a list of keys, which should be changed in m_config from rhs.
@@ -42,7 +78,13 @@ public:
     // Fill in the template using a macro processing language.
     // Throws Slic3r::PlaceholderParserError on syntax or runtime error.
     std::string process(const std::string &templ, unsigned int current_extruder_id = 0, const DynamicConfig *config_override = nullptr) const;
-    
+    // Split the template into blocks to be processed by process(const CompiledTemplate&) repeatedly.
+    // Syntax errors are not reported here, they are reported by process().
+    static CompiledTemplate compile(const std::string &templ);
+    // Fill in a compiled template. Produces the same output as process(templ.source(), ...), including the error messages.
+    // Throws Slic3r::PlaceholderParserError on syntax or runtime error.
+    std::string process(const CompiledTemplate &templ, unsigned int current_extruder_id = 0, const DynamicConfig *config_override = nullptr) const;
+
     // Evaluate a boolean expression using the full expressive power of the PlaceholderParser boolean expression syntax.
     // Throws Slic3r::PlaceholderParserError on syntax or runtime error.
     static bool evaluate_boolean_expression(const std::string &templ, const DynamicConfig &config, const DynamicConfig *config_override = nullptr);
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <set>
 #include <fstream>
+#include <sstream>
 #include <unordered_set>
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/clamp.hpp>
@@ -20,6 +21,11 @@
 #include <boost/property_tree/ptree.hpp>
 #include <boost/locale.hpp>
 #include <boost/log/trivial.hpp>
+#include <boost/crc.hpp>
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
 
 
 // Store the print/filament/printer presets into a "presets" subdirectory of the Slic3rPE config dir.
@@ -134,6 +140,7 @@ void PresetBundle::setup_directories()
         data_dir,
 		data_dir / "vendor",
         data_dir / "cache",
+        data_dir / "bundle_cache",
 #ifdef SLIC3R_PROFILE_USE_PRESETS_SUBDIR
         // Store the print/filament/printer presets into a "presets" directory.
         data_dir / "presets", 
@@ -1083,6 +1090,185 @@ static void flatten_configbundle_hierarchy(boost::property_tree::ptree &tree, co
     flatten_configbundle_hierarchy(tree, "printer",         preset_bundle ? preset_bundle->printers.system_preset_names()      : std::vector<std::string>());
 }
 
+static std::string load_file_content(const std::string &path)
+{
+    boost::nowide::ifstream ifs(path);
+    return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+}
+
+// Is it a section of a print, filament or printer preset?
+static bool is_preset_section(const std::string &section_name)
+{
+    return boost::starts_with(section_name, "print:")     || boost::starts_with(section_name, "filament:") ||
+           boost::starts_with(section_name, "sla_print:") || boost::starts_with(section_name, "sla_material:") ||
+           boost::starts_with(section_name, "printer:");
+}
+
+// Binary cache of a system config bundle.
+// Parsing of a vendor config bundle, flattening its inheritance hierarchy and deserializing its presets is expensive.
+// The deserialized presets are stored into the "bundle_cache" subdirectory of the data directory and they are reused
+// as long as the content of the config bundle, the version of PrusaSlicer and the configuration layer do not change.
+// The "cache" subdirectory is not used, it belongs to the PresetUpdater.
+struct ConfigBundleCache
+{
+    struct CachedPreset {
+        Preset::Type             type;
+        std::string              section;
+        std::string              name;
+        std::string              alias;
+        std::vector<std::string> renamed_from;
+        DynamicPrintConfig       config;
+
+        template<class Archive> void serialize(Archive &ar) { ar(type, section, name, alias, renamed_from, config); }
+    };
+
+    // Sections not containing presets (vendor, printer models, obsolete presets) in the INI format.
+    std::string                 other_sections;
+    // Presets after flattening and deserialization, before being filtered by the vendor profile.
+    std::vector<CachedPreset>   presets;
+
+    // Load the cache of a config bundle, return false if there is no valid cache.
+    bool load(const std::string &bundle_path, const std::string &bundle_data);
+    void save(const std::string &bundle_path, const std::string &bundle_data) const;
+
+private:
+    // Version of the binary format of the cache, to be incremented if the layout of the cache changes.
+    static constexpr const uint32_t VERSION = 3;
+
+    // Everything the validity of the cache depends on.
+    struct Key {
+        uint32_t                version             = VERSION;
+        std::string             slic3r_version      = SLIC3R_VERSION;
+        // The binary serialization of DynamicPrintConfig refers to the options by their ordinal numbers.
+        size_t                  num_config_options  = print_config_def.options.size();
+        // The presets are parsed over the default values of the config options.
+        uint32_t                defaults_crc        = config_defaults_crc();
+        size_t                  bundle_size         = 0;
+        uint32_t                bundle_crc          = 0;
+
+        explicit Key(const std::string &bundle_data) : bundle_size(bundle_data.size()) {
+            boost::crc_32_type crc;
+            crc.process_bytes(bundle_data.data(), bundle_data.size());
+            bundle_crc = crc.checksum();
+        }
+        bool operator==(const Key &rhs) const {
+            return version == rhs.version && slic3r_version == rhs.slic3r_version && num_config_options == rhs.num_config_options &&
+                   defaults_crc == rhs.defaults_crc && bundle_size == rhs.bundle_size && bundle_crc == rhs.bundle_crc;
+        }
+        template<class Archive> void serialize(Archive &ar) { ar(version, slic3r_version, num_config_options, defaults_crc, bundle_size, bundle_crc); }
+    };
+
+    // CRC32 of the keys and the default values of all the config options.
+    static uint32_t config_defaults_crc()
+    {
+        static const uint32_t crc = []() {
+            boost::crc_32_type crc;
+            for (const auto &opt : print_config_def.options) {
+                std::string line = opt.first + "=" + (opt.second.default_value ? opt.second.default_value->serialize() : std::string()) + "\n";
+                crc.process_bytes(line.data(), line.size());
+            }
+            return uint32_t(crc.checksum());
+        }();
+        return crc;
+    }
+
+    // Bundles of the same name are installed in multiple directories (resources, vendor), therefore the name
+    // of the cache contains a hash of the full path of the bundle.
+    static boost::filesystem::path cache_path(const std::string &bundle_path)
+    {
+        boost::filesystem::path path(bundle_path);
+        std::string             full_path = boost::filesystem::absolute(path).generic_string();
+        boost::crc_32_type      crc;
+        crc.process_bytes(full_path.data(), full_path.size());
+        char                    hash[16];
+        sprintf(hash, "-%08x", unsigned(crc.checksum()));
+        return (boost::filesystem::path(data_dir()) / "bundle_cache" / (path.stem().string() + hash + ".bundle_cache")).make_preferred();
+    }
+};
+
+// Layout of the cache file: the serialized Key, the size and the CRC32 of the payload, the payload.
+// The payload (other_sections, presets) is only deserialized after its size and CRC32 were verified,
+// so that a truncated or corrupted cache is never passed to the deserializers of the presets.
+bool ConfigBundleCache::load(const std::string &bundle_path, const std::string &bundle_data)
+{
+    boost::filesystem::path path = cache_path(bundle_path);
+    if (! boost::filesystem::exists(path))
+        return false;
+    try {
+        std::string data;
+        {
+            boost::nowide::ifstream ifs(path.string(), std::ios::binary);
+            data.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        }
+        std::istringstream iss(data, std::ios::binary);
+        uint64_t payload_size = 0;
+        uint32_t payload_crc  = 0;
+        {
+            cereal::BinaryInputArchive iarchive(iss);
+            Key key(std::string{});
+            iarchive(key);
+            if (! (key == Key(bundle_data))) {
+                BOOST_LOG_TRIVIAL(info) << "Config bundle cache " << path.string() << " is outdated";
+                return false;
+            }
+            iarchive(payload_size, payload_crc);
+        }
+        size_t payload_begin = size_t(iss.tellg());
+        if (payload_begin > data.size() || data.size() - payload_begin != payload_size)
+            throw Slic3r::RuntimeError("Truncated cache file");
+        boost::crc_32_type crc;
+        crc.process_bytes(data.data() + payload_begin, payload_size);
+        if (crc.checksum() != payload_crc)
+            throw Slic3r::RuntimeError("Corrupted cache file");
+        cereal::BinaryInputArchive iarchive(iss);
+        iarchive(other_sections, presets);
+    } catch (const std::exception &err) {
+        BOOST_LOG_TRIVIAL(error) << "Failed loading config bundle cache " << path.string() << ": " << err.what();
+        other_sections.clear();
+        presets.clear();
+        return false;
+    }
+    BOOST_LOG_TRIVIAL(info) << "Loaded " << presets.size() << " presets of config bundle " << bundle_path << " from cache";
+    return true;
+}
+
+void ConfigBundleCache::save(const std::string &bundle_path, const std::string &bundle_data) const
+{
+    boost::filesystem::path path     = cache_path(bundle_path);
+    boost::filesystem::path path_tmp = path;
+    path_tmp += ".tmp";
+    try {
+        std::string payload;
+        {
+            std::ostringstream oss(std::ios::binary);
+            {
+                cereal::BinaryOutputArchive oarchive(oss);
+                oarchive(other_sections, presets);
+            }
+            payload = oss.str();
+        }
+        boost::crc_32_type crc;
+        crc.process_bytes(payload.data(), payload.size());
+        {
+            boost::nowide::ofstream ofs(path_tmp.string(), std::ios::binary);
+            if (! ofs)
+                // The cache directory may not exist, for example when running from the command line.
+                return;
+            {
+                cereal::BinaryOutputArchive oarchive(ofs);
+                oarchive(Key(bundle_data), uint64_t(payload.size()), uint32_t(crc.checksum()));
+            }
+            ofs.write(payload.data(), payload.size());
+        }
+        // Replace the cache atomically, so that a concurrently starting instance never reads a partially written cache.
+        boost::filesystem::rename(path_tmp, path);
+    } catch (const std::exception &err) {
+        BOOST_LOG_TRIVIAL(error) << "Failed saving config bundle cache " << path.string() << ": " << err.what();
+        boost::system::error_code ec;
+        boost::filesystem::remove(path_tmp, ec);
+    }
+}
+
 // Load a config bundle file, into presets and store the loaded presets into separate files
 // of the local configuration directory.
 size_t PresetBundle::load_configbundle(const std::string &path, unsigned int flags)
@@ -1092,10 +1278,24 @@ size_t PresetBundle::load_configbundle(const std::string &path, unsigned int fla
         this->reset(flags & LOAD_CFGBNDLE_SAVE);
 
     // 1) Read the complete config file into a boost::property_tree.
+    // A system config bundle may have been parsed, flattened and deserialized already by a previous run,
+    // then only the sections not containing presets are read from the cache.
     namespace pt = boost::property_tree;
     pt::ptree tree;
-    boost::nowide::ifstream ifs(path);
-    pt::read_ini(ifs, tree);
+    std::string                          bundle_data = load_file_content(path);
+    ConfigBundleCache                    cache;
+    std::unique_ptr<ConfigBundleCache>   cache_out;
+    bool                                 cache_valid = false;
+    if ((flags & LOAD_CFGBNDLE_SYSTEM) && (flags & LOAD_CFGBUNDLE_VENDOR_ONLY) == 0) {
+        cache_valid = cache.load(path, bundle_data);
+        if (! cache_valid)
+            // Collect the parsed presets to be stored into the cache.
+            cache_out = std::make_unique<ConfigBundleCache>();
+    }
+    {
+        std::istringstream iss(cache_valid ? cache.other_sections : bundle_data);
+        pt::read_ini(iss, tree);
+    }
 
     const VendorProfile *vendor_profile = nullptr;
     if (flags & (LOAD_CFGBNDLE_SYSTEM | LOAD_CFGBUNDLE_VENDOR_ONLY)) {
@@ -1114,9 +1314,21 @@ size_t PresetBundle::load_configbundle(const std::string &path, unsigned int fla
         return 0;
     }
 
+    if (cache_out) {
+        // Store the sections not containing presets (vendor, printer models, obsolete presets) in the INI format.
+        pt::ptree other_sections;
+        for (const auto &section : tree)
+            if (! is_preset_section(section.first))
+                other_sections.push_back(section);
+        std::ostringstream oss;
+        pt::write_ini(oss, other_sections);
+        cache_out->other_sections = oss.str();
+    }
+
     // 1.5) Flatten the config bundle by applying the inheritance rules. Internal profiles (with names starting with '*') are removed.
     // If loading a user config bundle, do not flatten with the system profiles, but keep the "inherits" flag intact.
-    flatten_configbundle_hierarchy(tree, ((flags & LOAD_CFGBNDLE_SYSTEM) == 0) ? this : nullptr);
+    if (! cache_valid)
+        flatten_configbundle_hierarchy(tree, ((flags & LOAD_CFGBNDLE_SYSTEM) == 0) ? this : nullptr);
 
     // 2) Parse the property_tree, extract the active preset names and the profiles, save them into local config files.
     // Parse the obsolete preset names, to be deleted when upgrading from the old configuration structure.
@@ -1135,6 +1347,100 @@ size_t PresetBundle::load_configbundle(const std::string &path, unsigned int fla
     size_t                   presets_loaded = 0;
     size_t                   ph_printers_loaded = 0;
 
+    // Load a parsed print, filament or printer preset into its PresetCollection. Returns false if the preset was ignored.
+    auto load_preset = [this, flags, &path, &vendor_profile](PresetCollection *presets, const std::string &section_name, const std::string &preset_name,
+        DynamicPrintConfig &&config, std::string &&alias_name, std::vector<std::string> &&renamed_from) -> bool {
+        if ((flags & LOAD_CFGBNDLE_SYSTEM) && presets == &printers) {
+            // Filter out printer presets, which are not mentioned in the vendor profile.
+            // These presets are considered not installed.
+            auto printer_model   = config.opt_string("printer_model");
+            if (printer_model.empty()) {
+                BOOST_LOG_TRIVIAL(error) << "Error in a Vendor Config Bundle \"" << path << "\": The printer preset \"" << 
+                    section_name << "\" defines no printer model, it will be ignored.";
+                return false;
+            }
+            auto printer_variant = config.opt_string("printer_variant");
+            if (printer_variant.empty()) {
+                BOOST_LOG_TRIVIAL(error) << "Error in a Vendor Config Bundle \"" << path << "\": The printer preset \"" << 
+                    section_name << "\" defines no printer variant, it will be ignored.";
+                return false;
+            }
+            auto it_model = std::find_if(vendor_profile->models.cbegin(), vendor_profile->models.cend(),
+                [&](const VendorProfile::PrinterModel &m) { return m.id == printer_model; }
+            );
+            if (it_model == vendor_profile->models.end()) {
+                BOOST_LOG_TRIVIAL(error) << "Error in a Vendor Config Bundle \"" << path << "\": The printer preset \"" << 
+                    section_name << "\" defines invalid printer model \"" << printer_model << "\", it will be ignored.";
+                return false;
+            }
+            auto it_variant = it_model->variant(printer_variant);
+            if (it_variant == nullptr) {
+                BOOST_LOG_TRIVIAL(error) << "Error in a Vendor Config Bundle \"" << path << "\": The printer preset \"" << 
+                    section_name << "\" defines invalid printer variant \"" << printer_variant << "\", it will be ignored.";
+                return false;
+            }
+            const Preset *preset_existing = presets->find_preset(section_name, false);
+            if (preset_existing != nullptr) {
+                BOOST_LOG_TRIVIAL(error) << "Error in a Vendor Config Bundle \"" << path << "\": The printer preset \"" << 
+                    section_name << "\" has already been loaded from another Confing Bundle.";
+                return false;
+            }
+        } else if ((flags & LOAD_CFGBNDLE_SYSTEM) == 0) {
+            // This is a user config bundle.
+            const Preset *existing = presets->find_preset(preset_name, false);
+            if (existing != nullptr) {
+                if (existing->is_system) {
+                    assert(existing->vendor != nullptr);
+                    BOOST_LOG_TRIVIAL(error) << "Error in a user provided Config Bundle \"" << path << "\": The " << presets->name() << " preset \"" << 
+                        existing->name << "\" is a system preset of vendor " << existing->vendor->name << " and it will be ignored.";
+                    return false;
+                } else {
+                    assert(existing->vendor == nullptr);
+                    BOOST_LOG_TRIVIAL(trace) << "A " << presets->name() << " preset \"" << existing->name << "\" was overwritten with a preset from user Config Bundle \"" << path << "\"";
+                }
+            } else {
+                BOOST_LOG_TRIVIAL(trace) << "A new " << presets->name() << " preset \"" << preset_name << "\" was imported from user Config Bundle \"" << path << "\"";
+            }
+        }
+        // Decide a full path to this .ini file.
+        auto file_name = boost::algorithm::iends_with(preset_name, ".ini") ? preset_name : preset_name + ".ini";
+        auto file_path = (boost::filesystem::path(data_dir()) 
+#ifdef SLIC3R_PROFILE_USE_PRESETS_SUBDIR
+            // Store the print/filament/printer presets into a "presets" directory.
+            / "presets" 
+#else
+            // Store the print/filament/printer presets at the same location as the upstream Slic3r.
+#endif
+            / presets->section_name() / file_name).make_preferred();
+        // Load the preset into the list of presets, save it to disk.
+        Preset &loaded = presets->load_preset(file_path.string(), preset_name, std::move(config), false);
+        if (flags & LOAD_CFGBNDLE_SAVE)
+            loaded.save();
+        if (flags & LOAD_CFGBNDLE_SYSTEM) {
+            loaded.is_system = true;
+            loaded.vendor = vendor_profile;
+        }
+
+        // Derive the profile logical name aka alias from the preset name if the alias was not stated explicitely.
+        if (alias_name.empty()) {
+            size_t end_pos = preset_name.find_first_of("@");
+            if (end_pos != std::string::npos) {
+                alias_name = preset_name.substr(0, end_pos);
+                if (renamed_from.empty())
+                    // Add the preset name with the '@' character removed into the "renamed_from" list.
+                    renamed_from.emplace_back(alias_name + preset_name.substr(end_pos + 1));
+                boost::trim_right(alias_name);
+            }
+        }
+        if (alias_name.empty())
+            loaded.alias = preset_name;
+        else 
+            loaded.alias = std::move(alias_name);
+        loaded.renamed_from = std::move(renamed_from);
+
+        return true;
+    };
+
     for (const auto &section : tree) {
         PresetCollection         *presets = nullptr;
         std::vector<std::string> *loaded  = nullptr;
@@ -1251,95 +1557,10 @@ size_t PresetBundle::load_configbundle(const std::string &path, unsigned int fla
             if (! incorrect_keys.empty())
                 BOOST_LOG_TRIVIAL(error) << "Error in a Vendor Config Bundle \"" << path << "\": The printer preset \"" << 
                     section.first << "\" contains the following incorrect keys: " << incorrect_keys << ", which were removed";
-            if ((flags & LOAD_CFGBNDLE_SYSTEM) && presets == &printers) {
-                // Filter out printer presets, which are not mentioned in the vendor profile.
-                // These presets are considered not installed.
-                auto printer_model   = config.opt_string("printer_model");
-                if (printer_model.empty()) {
-                    BOOST_LOG_TRIVIAL(error) << "Error in a Vendor Config Bundle \"" << path << "\": The printer preset \"" << 
-                        section.first << "\" defines no printer model, it will be ignored.";
-                    continue;
-                }
-                auto printer_variant = config.opt_string("printer_variant");
-                if (printer_variant.empty()) {
-                    BOOST_LOG_TRIVIAL(error) << "Error in a Vendor Config Bundle \"" << path << "\": The printer preset \"" << 
-                        section.first << "\" defines no printer variant, it will be ignored.";
-                    continue;
-                }
-                auto it_model = std::find_if(vendor_profile->models.cbegin(), vendor_profile->models.cend(),
-                    [&](const VendorProfile::PrinterModel &m) { return m.id == printer_model; }
-                );
-                if (it_model == vendor_profile->models.end()) {
-                    BOOST_LOG_TRIVIAL(error) << "Error in a Vendor Config Bundle \"" << path << "\": The printer preset \"" << 
-                        section.first << "\" defines invalid printer model \"" << printer_model << "\", it will be ignored.";
-                    continue;
-                }
-                auto it_variant = it_model->variant(printer_variant);
-                if (it_variant == nullptr) {
-                    BOOST_LOG_TRIVIAL(error) << "Error in a Vendor Config Bundle \"" << path << "\": The printer preset \"" << 
-                        section.first << "\" defines invalid printer variant \"" << printer_variant << "\", it will be ignored.";
-                    continue;
-                }
-                const Preset *preset_existing = presets->find_preset(section.first, false);
-                if (preset_existing != nullptr) {
-                    BOOST_LOG_TRIVIAL(error) << "Error in a Vendor Config Bundle \"" << path << "\": The printer preset \"" << 
-                        section.first << "\" has already been loaded from another Confing Bundle.";
-                    continue;
-                }
-            } else if ((flags & LOAD_CFGBNDLE_SYSTEM) == 0) {
-                // This is a user config bundle.
-                const Preset *existing = presets->find_preset(preset_name, false);
-                if (existing != nullptr) {
-                    if (existing->is_system) {
-    					assert(existing->vendor != nullptr);
-                        BOOST_LOG_TRIVIAL(error) << "Error in a user provided Config Bundle \"" << path << "\": The " << presets->name() << " preset \"" << 
-    						existing->name << "\" is a system preset of vendor " << existing->vendor->name << " and it will be ignored.";
-                        continue;
-                    } else {
-                        assert(existing->vendor == nullptr);
-                        BOOST_LOG_TRIVIAL(trace) << "A " << presets->name() << " preset \"" << existing->name << "\" was overwritten with a preset from user Config Bundle \"" << path << "\"";
-                    }
-                } else {
-					BOOST_LOG_TRIVIAL(trace) << "A new " << presets->name() << " preset \"" << preset_name << "\" was imported from user Config Bundle \"" << path << "\"";
-                }
-            }
-            // Decide a full path to this .ini file.
-            auto file_name = boost::algorithm::iends_with(preset_name, ".ini") ? preset_name : preset_name + ".ini";
-            auto file_path = (boost::filesystem::path(data_dir()) 
-#ifdef SLIC3R_PROFILE_USE_PRESETS_SUBDIR
-                // Store the print/filament/printer presets into a "presets" directory.
-                / "presets" 
-#else
-                // Store the print/filament/printer presets at the same location as the upstream Slic3r.
-#endif
-                / presets->section_name() / file_name).make_preferred();
-            // Load the preset into the list of presets, save it to disk.
-            Preset &loaded = presets->load_preset(file_path.string(), preset_name, std::move(config), false);
-            if (flags & LOAD_CFGBNDLE_SAVE)
-                loaded.save();
-            if (flags & LOAD_CFGBNDLE_SYSTEM) {
-                loaded.is_system = true;
-                loaded.vendor = vendor_profile;
-            }
-
-            // Derive the profile logical name aka alias from the preset name if the alias was not stated explicitely.
-            if (alias_name.empty()) {
-                size_t end_pos = preset_name.find_first_of("@");
-	            if (end_pos != std::string::npos) {
-	                alias_name = preset_name.substr(0, end_pos);
-	                if (renamed_from.empty())
-	                	// Add the preset name with the '@' character removed into the "renamed_from" list.
-	                	renamed_from.emplace_back(alias_name + preset_name.substr(end_pos + 1));
-                    boost::trim_right(alias_name);
-	            }
-	        }
-	        if (alias_name.empty())
-	        	loaded.alias = preset_name;
-	        else 
-	         	loaded.alias = std::move(alias_name);
-	        loaded.renamed_from = std::move(renamed_from);
-
-            ++ presets_loaded;
+            if (cache_out)
+                cache_out->presets.push_back({ presets->type(), section.first, preset_name, alias_name, renamed_from, config });
+            if (load_preset(presets, section.first, preset_name, std::move(config), std::move(alias_name), std::move(renamed_from)))
+                ++ presets_loaded;
         }
 
         if (ph_printers != nullptr) {
@@ -1380,6 +1601,25 @@ size_t PresetBundle::load_configbundle(const std::string &path, unsigned int fla
         }
     }
 
+    if (cache_valid) {
+        // Load the presets parsed, flattened and deserialized by a previous run.
+        auto presets_by_type = [this](Preset::Type type) -> PresetCollection* {
+            switch (type) {
+            case Preset::TYPE_PRINT:        return &this->prints;
+            case Preset::TYPE_SLA_PRINT:    return &this->sla_prints;
+            case Preset::TYPE_FILAMENT:     return &this->filaments;
+            case Preset::TYPE_SLA_MATERIAL: return &this->sla_materials;
+            case Preset::TYPE_PRINTER:      return &this->printers;
+            default:                        return nullptr;
+            }
+        };
+        for (ConfigBundleCache::CachedPreset &cached : cache.presets)
+            if (PresetCollection *presets = presets_by_type(cached.type); presets != nullptr &&
+                load_preset(presets, cached.section, cached.name, std::move(cached.config), std::move(cached.alias), std::move(cached.renamed_from)))
+                ++ presets_loaded;
+    } else if (cache_out)
+        cache_out->save(path, bundle_data);
+
     // 3) Activate the presets and physical printer if any exists.
     if ((flags & LOAD_CFGBNDLE_SYSTEM) == 0) {
         if (! active_print.empty()) 
@@ -20,12 +20,16 @@
 #include <float.h>
 
 #include <algorithm>
+#include <exception>
 #include <limits>
+#include <mutex>
 #include <unordered_set>
 #include <boost/filesystem/path.hpp>
 #include <boost/format.hpp>
 #include <boost/log/trivial.hpp>
 
+#include <tbb/task_group.h>
+
 // Mark string for localization and translate.
 #define L(s) Slic3r::I18N::translate(s)
 
@@ -861,10 +865,11 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
         bool modifiers_differ           = model_volume_list_changed(model_object, model_object_new, ModelVolumeType::PARAMETER_MODIFIER);
         bool supports_differ            = model_volume_list_changed(model_object, model_object_new, ModelVolumeType::SUPPORT_BLOCKER) ||
                                           model_volume_list_changed(model_object, model_object_new, ModelVolumeType::SUPPORT_ENFORCER);
+        bool layer_heights_differ       = ! model_object.layer_height_profile.timestamp_matches(model_object_new.layer_height_profile) ||
+                                          ! layer_height_ranges_equal(model_object.layer_config_ranges, model_object_new.layer_config_ranges, model_object_new.layer_height_profile.empty());
         if (model_parts_differ || modifiers_differ || 
             model_object.origin_translation != model_object_new.origin_translation   ||
-            ! model_object.layer_height_profile.timestamp_matches(model_object_new.layer_height_profile) ||
-            ! layer_height_ranges_equal(model_object.layer_config_ranges, model_object_new.layer_config_ranges, model_object_new.layer_height_profile.empty())) {
+            ! layer_height_ranges_equal(model_object.layer_config_ranges, model_object_new.layer_config_ranges, false)) {
             // The very first step (the slicing step) is invalidated. One may freely remove all associated PrintObjects.
             auto range = print_object_status.equal_range(PrintObjectStatus(model_object.id()));
             for (auto it = range.first; it != range.second; ++ it) {
@@ -873,6 +878,19 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
             }
             // Copy content of the ModelObject including its ID, do not change the parent.
             model_object.assign_copy(model_object_new);
+        } else if (layer_heights_differ) {
+            // Just the layer heights changed. Keep the PrintObjects, they will reslice and reprocess just the layers affected by the change.
+            // First stop background processing before modifying the ModelObject.
+            this->call_cancel_callback();
+            update_apply_status(false);
+            auto range = print_object_status.equal_range(PrintObjectStatus(model_object.id()));
+            for (auto it = range.first; it != range.second; ++ it)
+                update_apply_status(it->print_object->invalidate_layer_heights());
+            // Copy the layer height profile. The layer heights of the layer ranges are copied together with their configs below.
+            model_object.layer_height_profile.assign(model_object_new.layer_height_profile);
+            if (supports_differ)
+                // The supports have been invalidated together with the slicing, copy just the support volumes.
+                model_volume_list_update_supports(model_object, model_object_new);
         } else if (supports_differ || model_custom_supports_data_changed(model_object, model_object_new)) {
             // First stop background processing before shuffling or deleting the ModelVolumes in the ModelObject's list.
             if (supports_differ) {
@@ -1612,16 +1630,47 @@ void Print::process()
 {
     name_tbb_thread_pool_threads();
 
+    // All the parallel algorithms of the job share the thread limit of the execution policy.
+    execution::run(this->execution_policy(), [this]() { this->_process(); });
+}
+
+void Print::_process()
+{
     BOOST_LOG_TRIVIAL(info) << "Starting the slicing process." << log_memory_info();
-    for (PrintObject *obj : m_objects)
+    // The PrintObjectSteps of a single object depend on each other, while the objects are independent.
+    // Thus the chains of steps of the particular objects are executed concurrently, so that a plate with many
+    // small objects keeps all the cores busy instead of synchronizing all the objects after each step.
+    std::once_flag infill_status_once;
+    auto process_object = [this, &infill_status_once](PrintObject *obj) {
         obj->make_perimeters();
-    this->set_status(70, L("Infilling layers"));
-    for (PrintObject *obj : m_objects)
+        std::call_once(infill_status_once, [this]() { this->set_status(70, L("Infilling layers")); });
         obj->infill();
-    for (PrintObject *obj : m_objects)
         obj->ironing();
-    for (PrintObject *obj : m_objects)
         obj->generate_support_material();
+    };
+    if (m_objects.size() == 1)
+        process_object(m_objects.front());
+    else if (! m_objects.empty()) {
+        // The exceptions (including the CanceledException) are caught and rethrown after all the objects finish.
+        // If an exception escaped a task, the task group would cancel the TBB algorithms of the other objects
+        // and these objects would mark their partially processed steps as done.
+        std::exception_ptr  exception;
+        std::mutex          exception_mutex;
+        tbb::task_group     task_group;
+        for (PrintObject *obj : m_objects)
+            task_group.run([obj, &process_object, &exception, &exception_mutex]() {
+                try {
+                    process_object(obj);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(exception_mutex);
+                    if (! exception)
+                        exception = std::current_exception();
+                }
+            });
+        task_group.wait();
+        if (exception)
+            std::rethrow_exception(exception);
+    }
     if (this->set_started(psWipeTower)) {
         m_wipe_tower_data.clear();
         m_tool_ordering.clear();
@@ -1682,7 +1731,9 @@ std::string Print::export_gcode(const std::string& path_template, GCodeProcessor
 
     // The following line may die for multiple reasons.
     GCode gcode;
-    gcode.do_export(this, path.c_str(), result, thumbnail_cb);
+    execution::run(this->execution_policy(), [this, &gcode, &path, result, &thumbnail_cb]() {
+        gcode.do_export(this, path.c_str(), result, thumbnail_cb);
+    });
     return path.c_str();
 }
 
@@ -2138,38 +2189,74 @@ void Print::_make_wipe_tower()
     // Lets go through the wipe tower layers and determine pairs of extruder changes for each
     // to pass to wipe_tower (so that it can use it for planning the layout of the tower)
     {
+        // Tool change planned at a wipe tower layer, the volume to be purged is reduced by the wiping into infills / objects.
+        struct PlannedToolChange {
+            unsigned int old_extruder_id;
+            unsigned int new_extruder_id;
+            bool         brim;
+            float        volume_to_wipe;
+        };
+        std::vector<LayerTools> &layer_tools_vec = m_wipe_tower_data.tool_ordering.layer_tools();
+        std::vector<std::vector<PlannedToolChange>> tool_changes(layer_tools_vec.size());
+        // The sequence of extruders does not depend on the wiping, collect the tool changes of all wipe tower layers first.
+        size_t       num_layers          = 0;
         unsigned int current_extruder_id = m_wipe_tower_data.tool_ordering.all_extruders().back();
-        for (auto &layer_tools : m_wipe_tower_data.tool_ordering.layer_tools()) { // for all layers
+        for (const LayerTools &layer_tools : layer_tools_vec) { // for all layers
+            ++ num_layers;
             if (!layer_tools.has_wipe_tower) continue;
             bool first_layer = &layer_tools == &m_wipe_tower_data.tool_ordering.front();
-            wipe_tower.plan_toolchange((float)layer_tools.print_z, (float)layer_tools.wipe_tower_layer_height, current_extruder_id, current_extruder_id, false);
             for (const auto extruder_id : layer_tools.extruders) {
                 if ((first_layer && extruder_id == m_wipe_tower_data.tool_ordering.all_extruders().back()) || extruder_id != current_extruder_id) {
-                    float volume_to_wipe = wipe_volumes[current_extruder_id][extruder_id];             // total volume to wipe after this toolchange
+                    tool_changes[&layer_tools - layer_tools_vec.data()].push_back({ current_extruder_id, extruder_id,
+                        first_layer && extruder_id == m_wipe_tower_data.tool_ordering.all_extruders().back(),
+                        // total volume to wipe after this toolchange
+                        wipe_volumes[current_extruder_id][extruder_id] });
+                    current_extruder_id = extruder_id;
+                }
+            }
+            if (&layer_tools == &m_wipe_tower_data.tool_ordering.back() || (&layer_tools + 1)->wipe_tower_partitions == 0)
+                break;
+        }
+
+        // Assign the infills / objects for wiping. Each layer only marks its own extrusions, thus the layers are processed in parallel.
+        execution::parallel_for(this->execution_policy(), tbb::blocked_range<size_t>(0, num_layers),
+            [this, &layer_tools_vec, &tool_changes](const tbb::blocked_range<size_t> &range) {
+            for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
+                LayerTools &layer_tools = layer_tools_vec[layer_idx];
+                if (! layer_tools.has_wipe_tower)
+                    continue;
+                for (PlannedToolChange &tool_change : tool_changes[layer_idx]) {
                     // Not all of that can be used for infill purging:
-                    volume_to_wipe -= (float)m_config.filament_minimal_purge_on_wipe_tower.get_at(extruder_id);
+                    tool_change.volume_to_wipe -= (float)m_config.filament_minimal_purge_on_wipe_tower.get_at(tool_change.new_extruder_id);
 
                     // try to assign some infills/objects for the wiping:
-                    volume_to_wipe = layer_tools.wiping_extrusions().mark_wiping_extrusions(*this, current_extruder_id, extruder_id, volume_to_wipe);
+                    tool_change.volume_to_wipe = layer_tools.wiping_extrusions().mark_wiping_extrusions(*this, tool_change.old_extruder_id, tool_change.new_extruder_id, tool_change.volume_to_wipe);
 
                     // add back the minimal amount toforce on the wipe tower:
-                    volume_to_wipe += (float)m_config.filament_minimal_purge_on_wipe_tower.get_at(extruder_id);
-
-                    // request a toolchange at the wipe tower with at least volume_to_wipe purging amount
-                    wipe_tower.plan_toolchange((float)layer_tools.print_z, (float)layer_tools.wipe_tower_layer_height, current_extruder_id, extruder_id,
-                                               first_layer && extruder_id == m_wipe_tower_data.tool_ordering.all_extruders().back(), volume_to_wipe);
-                    current_extruder_id = extruder_id;
+                    tool_change.volume_to_wipe += (float)m_config.filament_minimal_purge_on_wipe_tower.get_at(tool_change.new_extruder_id);
                 }
+                layer_tools.wiping_extrusions().ensure_perimeters_infills_order(*this);
+            }
+        });
+        this->throw_if_canceled();
+
+        // Request the toolchanges at the wipe tower with at least volume_to_wipe purging amount, ordered by print_z.
+        current_extruder_id = m_wipe_tower_data.tool_ordering.all_extruders().back();
+        for (size_t layer_idx = 0; layer_idx < num_layers; ++ layer_idx) {
+            const LayerTools &layer_tools = layer_tools_vec[layer_idx];
+            if (! layer_tools.has_wipe_tower) continue;
+            wipe_tower.plan_toolchange((float)layer_tools.print_z, (float)layer_tools.wipe_tower_layer_height, current_extruder_id, current_extruder_id, false);
+            for (const PlannedToolChange &tool_change : tool_changes[layer_idx]) {
+                wipe_tower.plan_toolchange((float)layer_tools.print_z, (float)layer_tools.wipe_tower_layer_height, tool_change.old_extruder_id, tool_change.new_extruder_id,
+                                           tool_change.brim, tool_change.volume_to_wipe);
+                current_extruder_id = tool_change.new_extruder_id;
             }
-            layer_tools.wiping_extrusions().ensure_perimeters_infills_order(*this);
-            if (&layer_tools == &m_wipe_tower_data.tool_ordering.back() || (&layer_tools + 1)->wipe_tower_partitions == 0)
-                break;
         }
     }
 
     // Generate the wipe tower layers.
     m_wipe_tower_data.tool_changes.reserve(m_wipe_tower_data.tool_ordering.layer_tools().size());
-    wipe_tower.generate(m_wipe_tower_data.tool_changes);
+    wipe_tower.generate(m_wipe_tower_data.tool_changes, this->execution_policy());
     m_wipe_tower_data.depth = wipe_tower.get_depth();
     m_wipe_tower_data.brim_width = wipe_tower.get_brim_width();
 
@@ -24,6 +24,7 @@ class GCode;
 enum class SlicingMode : uint32_t;
 class Layer;
 class SupportLayer;
+class Surface;
 
 namespace FillAdaptive {
     struct Octree;
@@ -211,6 +212,8 @@ private:
     bool                    invalidate_step(PrintObjectStep step);
     // Invalidates all PrintObject and Print steps.
     bool                    invalidate_all_steps();
+    // Invalidates the slicing after just the layer heights changed, the next slicing pass reslices only the layers affected by the change.
+    bool                    invalidate_layer_heights();
     // Invalidate steps based on a set of parameters changed.
     bool                    invalidate_state_by_config_options(const std::vector<t_config_option_key> &opt_keys);
     // If ! m_slicing_params.valid, recalculate.
@@ -227,10 +230,23 @@ private:
     void generate_support_material();
 
     void _slice(const std::vector<coordf_t> &layer_height_profile);
+    // Reuses the layers not affected by a layer height change and creates the new layers in between, returning the index range
+    // of the new layers to be sliced. Returns false if the object is to be resliced completely.
+    bool reuse_unchanged_layers(const std::vector<coordf_t> &object_layers, std::pair<size_t, size_t> &layers_to_slice);
+    // Index range of the layers with print_z inside z_range.
+    std::pair<size_t, size_t> layers_in_z_range(const std::pair<coordf_t, coordf_t> &z_range) const;
+    // Layers to be processed by make_perimeters() and prepare_infill() including the resliced copies of the guard layers,
+    // and layers to be processed by infill() and ironing().
+    std::pair<size_t, size_t> layers_to_process() const;
+    std::pair<size_t, size_t> layers_to_fill()    const { return this->layers_in_z_range(m_fill_z_range); }
+    void                      process_all_layers();
+    // Puts the guard layers back in place of their resliced copies.
+    void                      restore_guard_layers();
     std::string _fix_slicing_errors();
     void simplify_slices(double distance);
     bool has_support_material() const;
     void detect_surfaces_type();
+    void detect_surfaces_type(size_t idx_layer, size_t idx_region, bool interface_shells, std::vector<Surface> &surfaces_out);
     void process_external_surfaces();
     void discover_vertical_shells();
     void bridge_over_infill();
@@ -238,7 +254,8 @@ private:
     void discover_horizontal_shells();
     void combine_infill();
     void _generate_support_material();
-    std::pair<FillAdaptive::OctreePtr, FillAdaptive::OctreePtr> prepare_adaptive_infill_data();
+    // Returns the octrees of the adaptive cubic and of the support cubic infill, owned by this PrintObject.
+    std::pair<FillAdaptive::Octree*, FillAdaptive::Octree*> prepare_adaptive_infill_data();
 
     // XYZ in scaled coordinates
     Vec3crd									m_size;
@@ -258,6 +275,29 @@ private:
     // this is set to true when LayerRegion->slices is split in top/internal/bottom
     // so that next call to make_perimeters() performs a union() before computing loops
     bool                    				m_typed_slices = false;
+    // Set by make_perimeters() if it classified the slices of each layer right after generating its perimeters,
+    // then prepare_infill() does not call detect_surfaces_type().
+    bool                                    m_surfaces_type_detected = false;
+
+    // Set by invalidate_layer_heights(): The next slicing pass reuses the layers, which were not affected by the change of layer heights.
+    bool                                    m_reslice_changed_layers_only = false;
+    // Range of print_z of the layers to be (re)processed by make_perimeters() and prepare_infill(). All layers are processed,
+    // unless just the layers around a layer height change were resliced.
+    std::pair<coordf_t, coordf_t>           m_process_z_range { - std::numeric_limits<coordf_t>::max(), std::numeric_limits<coordf_t>::max() };
+    // Range of print_z of the layers to be (re)processed by infill() and ironing(), a superset of m_process_z_range.
+    // It extends up to the top of the object if the ids of the layers above the resliced layers changed, as the infill direction alternates with the layer id.
+    std::pair<coordf_t, coordf_t>           m_fill_z_range    { - std::numeric_limits<coordf_t>::max(), std::numeric_limits<coordf_t>::max() };
+    // Layers of the last slicing pass just below and just above m_process_z_range, sorted by print_z. They keep their results,
+    // while their resliced copies are processed until prepare_infill() is done, so that the layers inside m_process_z_range
+    // see the same neighbors as if all the layers were processed. Empty unless just the layers around a layer height change were resliced.
+    LayerPtrs                               m_guard_layers;
+
+    // Octrees of the adaptive cubic and of the support cubic infill with the line spacing they were built for.
+    // Reused by the next run of posInfill, released by prepare_infill() as they are built over the internal bridges.
+    std::shared_ptr<FillAdaptive::Octree>   m_adaptive_fill_octree;
+    std::shared_ptr<FillAdaptive::Octree>   m_support_fill_octree;
+    double                                  m_adaptive_fill_line_spacing = 0.;
+    double                                  m_support_fill_line_spacing  = 0.;
 
     std::vector<ExPolygons> slice_region(size_t region_id, const std::vector<float> &z, SlicingMode mode) const;
     std::vector<ExPolygons> slice_modifiers(size_t region_id, const std::vector<float> &z) const;
@@ -451,6 +491,7 @@ private:
 
     bool                invalidate_state_by_config_options(const std::vector<t_config_option_key> &opt_keys);
 
+    void                _process();
     void                _make_skirt();
     void                _make_brim();
     void                _make_wipe_tower();
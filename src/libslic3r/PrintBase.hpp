@@ -13,6 +13,7 @@
 #endif
 #include "tbb/mutex.h"
 
+#include "Execution.hpp"
 #include "ObjectID.hpp"
 #include "Model.hpp"
 #include "PlaceholderParser.hpp"
@@ -338,7 +339,7 @@ protected:
 class PrintBase : public ObjectBase
 {
 public:
-	PrintBase() : m_placeholder_parser(&m_full_print_config) { this->restart(); }
+	PrintBase() : m_placeholder_parser(&m_full_print_config) { this->restart(); this->set_execution_policy(default_execution_policy()); }
     inline virtual ~PrintBase() {}
 
     virtual PrinterTechnology technology() const noexcept = 0;
@@ -449,6 +450,14 @@ public:
     // Returns true if the last step was finished with success.
     virtual bool               finished() const = 0;
 
+    // Policy of the parallel algorithms executed by process() and by the export.
+    // The cancellation token of the policy is bound to this print.
+    const ExecutionPolicy&     execution_policy() const { return m_execution_policy; }
+    void                       set_execution_policy(const ExecutionPolicy &policy) {
+        m_execution_policy        = policy;
+        m_execution_policy.cancel = CancellationToken([this]() { this->throw_if_canceled(); });
+    }
+
     const PlaceholderParser&   placeholder_parser() const { return m_placeholder_parser; }
     const DynamicPrintConfig&  full_print_config() const { return m_full_print_config; }
 
@@ -491,6 +500,8 @@ private:
     // Callback to be evoked to stop the background processing before a state is updated.
     cancel_callback_type                    m_cancel_callback = [](){};
 
+    ExecutionPolicy                         m_execution_policy;
+
     // Mutex used for synchronization of the worker thread with the UI thread:
     // The mutex will be used to guard the worker thread against entering a stage
     // while the data influencing the stage is modified.
@@ -3656,6 +3656,14 @@ CLIActionsConfigDef::CLIActionsConfigDef()
     def->label = L("Save config file");
     def->tooltip = L("Save configuration to the specified file.");
     def->set_default_value(new ConfigOptionString());
+
+    def = this->add("batch", coString);
+    def->label = L("Batch slicing");
+    def->tooltip = L("Slice the jobs listed in the specified manifest file in a single process and report the time spent on each job. "
+                     "Each [job] section of the manifest names the model to slice, optionally the config files to load "
+                     "(separated by a semicolon), the output file name template and print options overriding the loaded ones. "
+                     "The print options given on the command line are shared by all the jobs.");
+    def->set_default_value(new ConfigOptionString());
 }
 
 CLITransformConfigDef::CLITransformConfigDef()
@@ -3780,6 +3788,23 @@ CLIMiscConfigDef::CLIMiscConfigDef()
     def->label = L("Data directory");
     def->tooltip = L("Load and store settings at the given directory. This is useful for maintaining different profiles or including configurations from a network storage.");
 
+    def = this->add("max_threads", coInt);
+    def->label = L("Maximum number of threads");
+    def->tooltip = L("Limits the number of threads used by this process for slicing and G-code export. "
+                     "Zero uses all the hardware threads.");
+    def->min = 0;
+
+    def = this->add("batch_jobs", coInt);
+    def->label = L("Concurrent batch jobs");
+    def->tooltip = L("Number of jobs of the batch manifest sliced at the same time. The threads are divided evenly between the jobs. "
+                     "Zero slices one job per four threads.");
+    def->min = 0;
+
+    def = this->add("deterministic", coBool);
+    def->label = L("Deterministic parallel execution");
+    def->tooltip = L("Partition the parallel computations independently of the number of threads and merge "
+                     "their results in a fixed order, so that repeated runs produce the same results.");
+
     def = this->add("loglevel", coInt);
     def->label = L("Logging level");
     def->tooltip = L("Sets logging sensitivity. 0:fatal, 1:error, 2:warning, 3:info, 4:debug, 5:trace\n"
@@ -3809,7 +3834,7 @@ void DynamicPrintAndCLIConfig::handle_legacy(t_config_option_key &opt_key, std::
     }
 }
 
-uint64_t ModelConfig::s_last_timestamp = 1;
+std::atomic<uint64_t> ModelConfig::s_last_timestamp(1);
 
 static Points to_points(const std::vector<Vec2d> &dpts)
 {
@@ -19,6 +19,8 @@
 #include "libslic3r.h"
 #include "Config.hpp"
 
+#include <atomic>
+
 // #define HAS_PRESSURE_EQUALIZER
 
 namespace Slic3r {
@@ -1442,7 +1444,6 @@ public:
     // from the timestmap of the object at the top of the Undo / Redo stack.
     virtual uint64_t    timestamp() const throw() { return m_timestamp; }
     bool                timestamp_matches(const ModelConfig &rhs) const throw() { return m_timestamp == rhs.m_timestamp; }
-    // Not thread safe! Should not be called from other than the main thread!
     void                touch() { m_timestamp = ++ s_last_timestamp; }
 
 private:
@@ -1452,7 +1453,8 @@ private:
     uint64_t                    m_timestamp { 1 };
     DynamicPrintConfig          m_data;
 
-    static uint64_t             s_last_timestamp;
+    // Atomic, as models may be loaded by multiple threads at once, for example by the batch slicing of the command line interface.
+    static std::atomic<uint64_t> s_last_timestamp;
 };
 
 } // namespace Slic3r
@@ -1470,9 +1472,9 @@ namespace cereal {
         for (size_t i = 0; i < cnt; ++ i) {
             size_t serialization_key_ordinal;
             archive(serialization_key_ordinal);
-            assert(serialization_key_ordinal > 0);
             auto it = Slic3r::print_config_def.by_serialization_key_ordinal.find(serialization_key_ordinal);
-            assert(it != Slic3r::print_config_def.by_serialization_key_ordinal.end());
+            if (it == Slic3r::print_config_def.by_serialization_key_ordinal.end())
+                throw Slic3r::RuntimeError("DynamicPrintConfig deserialization: Unknown option ordinal " + std::to_string(serialization_key_ordinal));
             config.set_key_value(it->second->opt_key, it->second->load_option_from_archive(archive));
         }
     }
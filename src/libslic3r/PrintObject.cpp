@@ -12,8 +12,10 @@
 #include "Tesselate.hpp"
 #include "Utils.hpp"
 #include "Fill/FillAdaptive.hpp"
+#include "Fill/FillRectilinear.hpp"
 #include "Format/STL.hpp"
 
+#include <atomic>
 #include <utility>
 #include <boost/log/trivial.hpp>
 #include <float.h>
@@ -45,6 +47,36 @@
 
 namespace Slic3r {
 
+// Ranges of print_z of all layers and of no layer, see PrintObject::m_process_z_range.
+static const std::pair<coordf_t, coordf_t> all_layers_z_range { - std::numeric_limits<coordf_t>::max(), std::numeric_limits<coordf_t>::max() };
+static const std::pair<coordf_t, coordf_t> no_layers_z_range  { std::numeric_limits<coordf_t>::max(), - std::numeric_limits<coordf_t>::max() };
+
+// Extends the range [begin, end) of layers given by the bottom and top Z of each layer (as produced by generate_object_layers())
+// by the layers closer to the range than num_layers or than thickness.
+static std::pair<size_t, size_t> extend_layer_range(const std::vector<coordf_t> &layers_z, const std::pair<size_t, size_t> &range, size_t num_layers, coordf_t thickness)
+{
+    if (range.first >= range.second)
+        return range;
+    size_t begin = range.first;
+    size_t end   = range.second;
+    while (begin > 0 && (range.first - begin < num_layers || layers_z[2 * range.first] - layers_z[2 * begin - 1] < thickness - EPSILON))
+        -- begin;
+    while (2 * end < layers_z.size() && (end - range.second < num_layers || layers_z[2 * end] - layers_z[2 * range.second - 1] < thickness - EPSILON))
+        ++ end;
+    return { begin, end };
+}
+
+static std::pair<size_t, size_t> extend_layer_range(const LayerPtrs &layers, const std::pair<size_t, size_t> &range, size_t num_layers, coordf_t thickness)
+{
+    std::vector<coordf_t> layers_z;
+    layers_z.reserve(2 * layers.size());
+    for (const Layer *layer : layers) {
+        layers_z.emplace_back(layer->bottom_z());
+        layers_z.emplace_back(layer->print_z);
+    }
+    return extend_layer_range(layers_z, range, num_layers, thickness);
+}
+
 // Constructor is called from the main thread, therefore all Model / ModelObject / ModelIntance data are valid.
 PrintObject::PrintObject(Print* print, ModelObject* model_object, const Transform3d& trafo, PrintInstances&& instances) :
     PrintObjectBaseWithState(print, model_object),
@@ -125,9 +157,11 @@ void PrintObject::slice()
     // Simplify slices if required.
     if (m_print->config().resolution)
         this->simplify_slices(scale_(this->print()->config().resolution));
-    // Update bounding boxes
-    tbb::parallel_for(
-        tbb::blocked_range<size_t>(0, m_layers.size()),
+    // Update bounding boxes of the layers just sliced.
+    auto [layer_begin, layer_end] = this->layers_to_process();
+    execution::parallel_for(
+        this->print()->execution_policy(),
+        tbb::blocked_range<size_t>(layer_begin, layer_end),
         [this](const tbb::blocked_range<size_t>& range) {
             for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
                 m_print->throw_if_canceled();
@@ -157,13 +191,17 @@ void PrintObject::make_perimeters()
     m_print->set_status(20, L("Generating perimeters"));
     BOOST_LOG_TRIVIAL(info) << "Generating perimeters..." << log_memory_info();
     
+    // Layers to be processed, all of them unless just the layers around a layer height change were resliced.
+    auto [layer_begin, layer_end] = this->layers_to_process();
+
     // merge slices if they were split into types
     if (m_typed_slices) {
-        for (Layer *layer : m_layers) {
-            layer->merge_slices();
+        for (size_t layer_idx = layer_begin; layer_idx < layer_end; ++ layer_idx) {
+            m_layers[layer_idx]->merge_slices();
             m_print->throw_if_canceled();
         }
-        m_typed_slices = false;
+        // The slices of the layers not processed stay split into types.
+        m_typed_slices = layer_begin > 0 || layer_end < m_layers.size();
     }
     
     // compare each layer to the one below, and mark those slices needing
@@ -173,82 +211,104 @@ void PrintObject::make_perimeters()
     // but we don't generate any extra perimeter if fill density is zero, as they would be floating
     // inside the object - infill_only_where_needed should be the method of choice for printing
     // hollow objects
+    std::vector<size_t> extra_perimeters_regions;
     for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id) {
         const PrintRegion &region = *m_print->regions()[region_id];
-        if (! region.config().extra_perimeters || region.config().perimeters == 0 || region.config().fill_density == 0 || this->layer_count() < 2)
-            continue;
-
-        BOOST_LOG_TRIVIAL(debug) << "Generating extra perimeters for region " << region_id << " in parallel - start";
-        tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, m_layers.size() - 1),
-            [this, &region, region_id](const tbb::blocked_range<size_t>& range) {
-                for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
-                    m_print->throw_if_canceled();
-                    LayerRegion &layerm                     = *m_layers[layer_idx]->m_regions[region_id];
-                    const LayerRegion &upper_layerm         = *m_layers[layer_idx+1]->m_regions[region_id];
-                    const Polygons upper_layerm_polygons    = upper_layerm.slices;
-                    // Filter upper layer polygons in intersection_ppl by their bounding boxes?
-                    // my $upper_layerm_poly_bboxes= [ map $_->bounding_box, @{$upper_layerm_polygons} ];
-                    const double total_loop_length      = total_length(upper_layerm_polygons);
-                    const coord_t perimeter_spacing     = layerm.flow(frPerimeter).scaled_spacing();
-                    const Flow ext_perimeter_flow       = layerm.flow(frExternalPerimeter);
-                    const coord_t ext_perimeter_width   = ext_perimeter_flow.scaled_width();
-                    const coord_t ext_perimeter_spacing = ext_perimeter_flow.scaled_spacing();
-
-                    for (Surface &slice : layerm.slices.surfaces) {
-                        for (;;) {
-                            // compute the total thickness of perimeters
-                            const coord_t perimeters_thickness = ext_perimeter_width/2 + ext_perimeter_spacing/2
-                                + (region.config().perimeters-1 + slice.extra_perimeters) * perimeter_spacing;
-                            // define a critical area where we don't want the upper slice to fall into
-                            // (it should either lay over our perimeters or outside this area)
-                            const coord_t critical_area_depth = coord_t(perimeter_spacing * 1.5);
-                            const Polygons critical_area = diff(
-                                offset(slice.expolygon, float(- perimeters_thickness)),
-                                offset(slice.expolygon, float(- perimeters_thickness - critical_area_depth))
-                            );
-                            // check whether a portion of the upper slices falls inside the critical area
-                            const Polylines intersection = intersection_pl(to_polylines(upper_layerm_polygons), critical_area);
-                            // only add an additional loop if at least 30% of the slice loop would benefit from it
-                            if (total_length(intersection) <=  total_loop_length*0.3)
-                                break;
-                            /*
-                            if (0) {
-                                require "Slic3r/SVG.pm";
-                                Slic3r::SVG::output(
-                                    "extra.svg",
-                                    no_arrows   => 1,
-                                    expolygons  => union_ex($critical_area),
-                                    polylines   => [ map $_->split_at_first_point, map $_->p, @{$upper_layerm->slices} ],
-                                );
-                            }
-                            */
-                            ++ slice.extra_perimeters;
-                        }
-                        #ifdef DEBUG
-                            if (slice.extra_perimeters > 0)
-                                printf("  adding %d more perimeter(s) at layer %zu\n", slice.extra_perimeters, layer_idx);
-                        #endif
-                    }
-                }
-            });
-        m_print->throw_if_canceled();
-        BOOST_LOG_TRIVIAL(debug) << "Generating extra perimeters for region " << region_id << " in parallel - end";
+        if (region.config().extra_perimeters && region.config().perimeters > 0 && region.config().fill_density > 0 && this->layer_count() >= 2)
+            extra_perimeters_regions.emplace_back(region_id);
     }
+    auto make_extra_perimeters = [](const PrintRegion &region, LayerRegion &layerm, const Polygons &upper_layerm_polygons) {
+        // Filter upper layer polygons in intersection_ppl by their bounding boxes?
+        // my $upper_layerm_poly_bboxes= [ map $_->bounding_box, @{$upper_layerm_polygons} ];
+        const double total_loop_length      = total_length(upper_layerm_polygons);
+        const coord_t perimeter_spacing     = layerm.flow(frPerimeter).scaled_spacing();
+        const Flow ext_perimeter_flow       = layerm.flow(frExternalPerimeter);
+        const coord_t ext_perimeter_width   = ext_perimeter_flow.scaled_width();
+        const coord_t ext_perimeter_spacing = ext_perimeter_flow.scaled_spacing();
+
+        for (Surface &slice : layerm.slices.surfaces) {
+            for (;;) {
+                // compute the total thickness of perimeters
+                const coord_t perimeters_thickness = ext_perimeter_width/2 + ext_perimeter_spacing/2
+                    + (region.config().perimeters-1 + slice.extra_perimeters) * perimeter_spacing;
+                // define a critical area where we don't want the upper slice to fall into
+                // (it should either lay over our perimeters or outside this area)
+                const coord_t critical_area_depth = coord_t(perimeter_spacing * 1.5);
+                const Polygons critical_area = diff(
+                    offset(slice.expolygon, float(- perimeters_thickness)),
+                    offset(slice.expolygon, float(- perimeters_thickness - critical_area_depth))
+                );
+                // check whether a portion of the upper slices falls inside the critical area
+                const Polylines intersection = intersection_pl(to_polylines(upper_layerm_polygons), critical_area);
+                // only add an additional loop if at least 30% of the slice loop would benefit from it
+                if (total_length(intersection) <=  total_loop_length*0.3)
+                    break;
+                /*
+                if (0) {
+                    require "Slic3r/SVG.pm";
+                    Slic3r::SVG::output(
+                        "extra.svg",
+                        no_arrows   => 1,
+                        expolygons  => union_ex($critical_area),
+                        polylines   => [ map $_->split_at_first_point, map $_->p, @{$upper_layerm->slices} ],
+                    );
+                }
+                */
+                ++ slice.extra_perimeters;
+            }
+        }
+    };
+
+    // Without interface shells and outside of the spiral vase mode, the surface types of a layer region depend on the slices
+    // of the region and on the islands of the layers above and below only, see detect_surfaces_type(). Then the first pass
+    // of prepare_infill() over the layers is run here: The slices of a layer are classified as soon as the perimeters of the layer
+    // and of the layer below are generated, as the extra perimeters of the layer below read the unclassified slices of the layer.
+    // The layers advance from the perimeters to the surface types in a wavefront, each layer is pulled through the cache once.
+    const bool classify_slices = ! m_print->config().spiral_vase.value && ! m_config.interface_shells.value;
+    // Number of layers, whose perimeters are to be generated before the slices of a layer are classified.
+    // The layer below the processed layers keeps its perimeters.
+    std::vector<std::atomic<int>> perimeters_pending(classify_slices ? layer_end : 0);
+    for (size_t layer_idx = layer_begin; layer_idx < perimeters_pending.size(); ++ layer_idx)
+        perimeters_pending[layer_idx] = (layer_idx == layer_begin) ? 1 : 2;
+    // The layer above the processed layers may still have its slices split into types, merge them on the fly.
+    size_t layer_typed = m_typed_slices ? layer_end : size_t(-1);
+    if (classify_slices)
+        // Set before the slices are classified, so that the next run merges them back if this one is canceled.
+        m_typed_slices = true;
 
     BOOST_LOG_TRIVIAL(debug) << "Generating perimeters in parallel - start";
-    tbb::parallel_for(
-        tbb::blocked_range<size_t>(0, m_layers.size()),
-        [this](const tbb::blocked_range<size_t>& range) {
+    // The extra perimeters of a layer depend on the slices of the layer above only, which are not modified by this step.
+    // Therefore the extra perimeters and the perimeters of a layer are generated in a single pass over the layers
+    // and the slices of each layer are pulled through the cache once.
+    execution::parallel_for(
+        this->print()->execution_policy(),
+        tbb::blocked_range<size_t>(layer_begin, layer_end),
+        [this, layer_typed, &extra_perimeters_regions, &make_extra_perimeters, &perimeters_pending](const tbb::blocked_range<size_t>& range) {
             for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
                 m_print->throw_if_canceled();
+                if (layer_idx + 1 < m_layers.size())
+                    for (size_t region_id : extra_perimeters_regions) {
+                        const SurfaceCollection &upper_slices = m_layers[layer_idx + 1]->m_regions[region_id]->slices;
+                        make_extra_perimeters(*m_print->regions()[region_id], *m_layers[layer_idx]->m_regions[region_id],
+                            layer_idx + 1 == layer_typed ? to_polygons(union_ex(to_polygons(upper_slices.surfaces), true)) : Polygons(upper_slices));
+                    }
                 m_layers[layer_idx]->make_perimeters();
+                // Classify this layer and the layer above, if their perimeters and the perimeters of the layers below them are done.
+                for (size_t i = layer_idx; i < std::min(layer_idx + 2, perimeters_pending.size()); ++ i)
+                    if (-- perimeters_pending[i] == 0)
+                        for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id) {
+                            LayerRegion *layerm = m_layers[i]->m_regions[region_id];
+                            this->detect_surfaces_type(i, region_id, false, layerm->slices.surfaces);
+                            layerm->slices_to_fill_surfaces_clipped();
+                            layerm->prepare_fill_surfaces();
+                        }
             }
         }
     );
     m_print->throw_if_canceled();
     BOOST_LOG_TRIVIAL(debug) << "Generating perimeters in parallel - end";
 
+    m_surfaces_type_detected = classify_slices;
     this->set_done(posPerimeters);
 }
 
@@ -257,25 +317,22 @@ void PrintObject::prepare_infill()
     if (! this->set_started(posPrepareInfill))
         return;
 
+    // The adaptive infill octrees are built over the internal bridges of the fill surfaces, which are going to be recalculated.
+    m_adaptive_fill_octree.reset();
+    m_support_fill_octree.reset();
+
     m_print->set_status(30, L("Preparing infill"));
 
     // This will assign a type (top/bottom/internal) to $layerm->slices.
     // Then the classifcation of $layerm->slices is transfered onto 
     // the $layerm->fill_surfaces by clipping $layerm->fill_surfaces
     // by the cummulative area of the previous $layerm->fill_surfaces.
-    this->detect_surfaces_type();
+    // Finally it decides what surfaces are to be filled, see LayerRegion::prepare_fill_surfaces().
+    // Usually done by make_perimeters() already.
+    if (! m_surfaces_type_detected)
+        this->detect_surfaces_type();
     m_print->throw_if_canceled();
     
-    // Decide what surfaces are to be filled.
-    // Here the stTop / stBottomBridge / stBottom infill is turned to just stInternal if zero top / bottom infill layers are configured.
-    // Also tiny stInternal surfaces are turned to stInternalSolid.
-    BOOST_LOG_TRIVIAL(info) << "Preparing fill surfaces..." << log_memory_info();
-    for (auto *layer : m_layers)
-        for (auto *region : layer->m_regions) {
-            region->prepare_fill_surfaces();
-            m_print->throw_if_canceled();
-        }
-
     // this will detect bridges and reverse bridges
     // and rearrange top/bottom/internal surfaces
     // It produces enlarged overlapping bridging areas.
@@ -364,6 +421,10 @@ void PrintObject::prepare_infill()
     } // for each layer
 #endif /* SLIC3R_DEBUG_SLICE_PROCESSING */
 
+    // The copies of the guard layers were processed just to provide the layers around a layer height change with their neighbors,
+    // the guard layers themselves kept their results.
+    this->restore_guard_layers();
+
     this->set_done(posPrepareInfill);
 }
 
@@ -376,17 +437,31 @@ void PrintObject::infill()
         auto [adaptive_fill_octree, support_fill_octree] = this->prepare_adaptive_infill_data();
 
         BOOST_LOG_TRIVIAL(debug) << "Filling layers in parallel - start";
-        tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, m_layers.size()),
-            [this, &adaptive_fill_octree = adaptive_fill_octree, &support_fill_octree = support_fill_octree](const tbb::blocked_range<size_t>& range) {
+        MonotonicOrderingStatistics monotonic_stats_start = monotonic_ordering_statistics();
+        // The unclipped infill patterns are shared by the layers of this object.
+        FillPatternCache pattern_cache;
+        // Layers to be filled, all of them unless just the layers around a layer height change were resliced.
+        auto [layer_begin, layer_end] = this->layers_to_fill();
+        execution::parallel_for(
+            this->print()->execution_policy(),
+            tbb::blocked_range<size_t>(layer_begin, layer_end),
+            [this, &adaptive_fill_octree = adaptive_fill_octree, &support_fill_octree = support_fill_octree, &pattern_cache](const tbb::blocked_range<size_t>& range) {
                 for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
                     m_print->throw_if_canceled();
-                    m_layers[layer_idx]->make_fills(adaptive_fill_octree.get(), support_fill_octree.get());
+                    m_layers[layer_idx]->make_fills(adaptive_fill_octree, support_fill_octree, &pattern_cache);
                 }
             }
         );
         m_print->throw_if_canceled();
-        BOOST_LOG_TRIVIAL(debug) << "Filling layers in parallel - end";
+        BOOST_LOG_TRIVIAL(debug) << "Filling layers in parallel - end, infill pattern cache hits: " << pattern_cache.hits() << ", misses: " << pattern_cache.misses();
+        {
+            // The counters are process wide, thus they include the monotonic infills of the objects processed concurrently.
+            MonotonicOrderingStatistics monotonic_stats = monotonic_ordering_statistics() - monotonic_stats_start;
+            for (const auto &[name, engine] : { std::make_pair("ant colony", monotonic_stats.ant_colony), std::make_pair("local search", monotonic_stats.local_search) })
+                if (engine.calls > 0)
+                    BOOST_LOG_TRIVIAL(info) << "Monotonic infill ordering by " << name << ": " << engine.calls << " islands, " << engine.regions << " regions, " <<
+                        "links length " << engine.links_length << "mm, " << engine.time << "s";
+        }
         /*  we could free memory now, but this would make this step not idempotent
         ### $_->fill_surfaces->clear for map @{$_->regions}, @{$object->layers};
         */
@@ -398,8 +473,10 @@ void PrintObject::ironing()
 {
     if (this->set_started(posIroning)) {
         BOOST_LOG_TRIVIAL(debug) << "Ironing in parallel - start";
-        tbb::parallel_for(
-            tbb::blocked_range<size_t>(1, m_layers.size()),
+        auto [layer_begin, layer_end] = this->layers_to_fill();
+        execution::parallel_for(
+            this->print()->execution_policy(),
+            tbb::blocked_range<size_t>(std::max(layer_begin, size_t(1)), std::max(layer_end, size_t(1))),
             [this](const tbb::blocked_range<size_t>& range) {
                 for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
                     m_print->throw_if_canceled();
@@ -434,13 +511,27 @@ void PrintObject::generate_support_material()
     }
 }
 
-std::pair<FillAdaptive::OctreePtr, FillAdaptive::OctreePtr> PrintObject::prepare_adaptive_infill_data()
+std::pair<FillAdaptive::Octree*, FillAdaptive::Octree*> PrintObject::prepare_adaptive_infill_data()
 {
     using namespace FillAdaptive;
 
     auto [adaptive_line_spacing, support_line_spacing] = adaptive_fill_line_spacing(*this);
-    if ((adaptive_line_spacing == 0. && support_line_spacing == 0.) || this->layers().empty())
-        return std::make_pair(OctreePtr(), OctreePtr());
+    if (this->layers().empty())
+        adaptive_line_spacing = support_line_spacing = 0.;
+    // Release the octrees, which are no more needed or which were built for a different line spacing.
+    if (adaptive_line_spacing != m_adaptive_fill_line_spacing)
+        m_adaptive_fill_octree.reset();
+    if (support_line_spacing != m_support_fill_line_spacing)
+        m_support_fill_octree.reset();
+    m_adaptive_fill_line_spacing = adaptive_line_spacing;
+    m_support_fill_line_spacing  = support_line_spacing;
+    bool build_adaptive = adaptive_line_spacing != 0. && ! m_adaptive_fill_octree;
+    bool build_support  = support_line_spacing  != 0. && ! m_support_fill_octree;
+    if (! build_adaptive && ! build_support) {
+        if (m_adaptive_fill_octree || m_support_fill_octree)
+            BOOST_LOG_TRIVIAL(debug) << "Reusing the adaptive infill octrees";
+        return std::make_pair(m_adaptive_fill_octree.get(), m_support_fill_octree.get());
+    }
 
     indexed_triangle_set mesh = this->model_object()->raw_indexed_triangle_set();
     // Rotate mesh and build octree on it with axis-aligned (standart base) cubes.
@@ -451,7 +542,8 @@ std::pair<FillAdaptive::OctreePtr, FillAdaptive::OctreePtr> PrintObject::prepare
 
     // Triangulate internal bridging surfaces.
     std::vector<std::vector<Vec3d>> overhangs(this->layers().size());
-    tbb::parallel_for(
+    execution::parallel_for(
+        this->print()->execution_policy(),
         tbb::blocked_range<int>(0, int(m_layers.size()) - 1),
         [this, &to_octree, &overhangs](const tbb::blocked_range<int> &range) {
             std::vector<Vec3d> &out = overhangs[range.begin()];
@@ -470,9 +562,11 @@ std::pair<FillAdaptive::OctreePtr, FillAdaptive::OctreePtr> PrintObject::prepare
     for (size_t i = 1; i < overhangs.size(); ++ i)
         append(overhangs.front(), std::move(overhangs[i]));
 
-    return std::make_pair(
-        adaptive_line_spacing ? build_octree(mesh, overhangs.front(), adaptive_line_spacing, false) : OctreePtr(),
-        support_line_spacing  ? build_octree(mesh, overhangs.front(), support_line_spacing, true) : OctreePtr());
+    if (build_adaptive)
+        m_adaptive_fill_octree = build_octree(mesh, overhangs.front(), adaptive_line_spacing, false, this->print()->execution_policy());
+    if (build_support)
+        m_support_fill_octree  = build_octree(mesh, overhangs.front(), support_line_spacing, true, this->print()->execution_policy());
+    return std::make_pair(m_adaptive_fill_octree.get(), m_support_fill_octree.get());
 }
 
 void PrintObject::clear_layers()
@@ -480,6 +574,9 @@ void PrintObject::clear_layers()
     for (Layer *l : m_layers)
         delete l;
     m_layers.clear();
+    for (Layer *l : m_guard_layers)
+        delete l;
+    m_guard_layers.clear();
 }
 
 Layer* PrintObject::add_layer(int id, coordf_t height, coordf_t print_z, coordf_t slice_z)
@@ -647,6 +744,14 @@ bool PrintObject::invalidate_state_by_config_options(const std::vector<t_config_
 bool PrintObject::invalidate_step(PrintObjectStep step)
 {
 	bool invalidated = Inherited::invalidate_step(step);
+
+    // The surface types detected together with the perimeters are to be detected again.
+    // If just the layers around a layer height change were being reprocessed, process all of them again.
+    if (step == posSlice || step == posPerimeters || step == posPrepareInfill) {
+        m_surfaces_type_detected = false;
+        this->process_all_layers();
+    } else if (step == posInfill || step == posIroning)
+        m_fill_z_range = all_layers_z_range;
     
     // propagate to dependent steps
     if (step == posPerimeters) {
@@ -681,9 +786,83 @@ bool PrintObject::invalidate_all_steps()
 	// Then reset some of the depending values.
 	this->m_slicing_params.valid = false;
 	this->region_volumes.clear();
+	this->m_surfaces_type_detected = false;
+    this->process_all_layers();
 	return result;
 }
 
+// Called by Print::apply() if just the layer height profile or the layer heights of the layer ranges of the object changed.
+bool PrintObject::invalidate_layer_heights()
+{
+    // The layers may be reused if all of them were processed, or if just the layers around the last layer height change
+    // were being reprocessed. In the latter case the layers to be reprocessed are remembered, they will be reprocessed together
+    // with the layers affected by this change.
+    bool processed = this->is_step_done(posSlice) && this->is_step_done(posPerimeters) && this->is_step_done(posPrepareInfill) &&
+                     this->is_step_done(posInfill) && this->is_step_done(posIroning);
+    bool pending   = m_reslice_changed_layers_only || m_process_z_range != all_layers_z_range || m_fill_z_range != all_layers_z_range;
+    bool reuse     = ! m_layers.empty() && (processed || pending);
+    // The guard layers keep the results of the last full run, while their copies may have been processed partially.
+    this->restore_guard_layers();
+    std::pair<coordf_t, coordf_t> process_z_range = processed ? no_layers_z_range : m_process_z_range;
+    std::pair<coordf_t, coordf_t> fill_z_range    = processed ? no_layers_z_range : m_fill_z_range;
+    bool invalidated = this->invalidate_step(posSlice);
+    if (reuse) {
+        m_reslice_changed_layers_only = true;
+        m_process_z_range             = process_z_range;
+        m_fill_z_range                = fill_z_range;
+    }
+    return invalidated;
+}
+
+void PrintObject::process_all_layers()
+{
+    this->restore_guard_layers();
+    m_reslice_changed_layers_only = false;
+    m_process_z_range             = all_layers_z_range;
+    m_fill_z_range                = all_layers_z_range;
+}
+
+void PrintObject::restore_guard_layers()
+{
+    for (Layer *layer : m_guard_layers) {
+        auto it = std::lower_bound(m_layers.begin(), m_layers.end(), layer->print_z - EPSILON, [](const Layer *l, coordf_t z) { return l->print_z < z; });
+        assert(it != m_layers.end() && std::abs((*it)->print_z - layer->print_z) < EPSILON);
+        Layer *copy = *it;
+        layer->set_id(copy->id());
+        layer->lower_layer = copy->lower_layer;
+        layer->upper_layer = copy->upper_layer;
+        if (layer->lower_layer != nullptr)
+            layer->lower_layer->upper_layer = layer;
+        if (layer->upper_layer != nullptr)
+            layer->upper_layer->lower_layer = layer;
+        *it = layer;
+        delete copy;
+    }
+    if (! m_guard_layers.empty())
+        // The slices of the guard layers are classified.
+        m_typed_slices = true;
+    m_guard_layers.clear();
+}
+
+std::pair<size_t, size_t> PrintObject::layers_to_process() const
+{
+    std::pair<size_t, size_t> range = this->layers_in_z_range(m_process_z_range);
+    // The copies of the guard layers are processed together with the layers they guard.
+    for (const Layer *layer : m_guard_layers)
+        if (layer->print_z < m_process_z_range.first)
+            -- range.first;
+        else
+            ++ range.second;
+    return range;
+}
+
+std::pair<size_t, size_t> PrintObject::layers_in_z_range(const std::pair<coordf_t, coordf_t> &z_range) const
+{
+    auto begin = std::lower_bound(m_layers.begin(), m_layers.end(), z_range.first - EPSILON, [](const Layer *layer, coordf_t z) { return layer->print_z < z; });
+    auto end   = std::upper_bound(begin, m_layers.end(), z_range.second + EPSILON, [](coordf_t z, const Layer *layer) { return z < layer->print_z; });
+    return { size_t(begin - m_layers.begin()), size_t(end - m_layers.begin()) };
+}
+
 bool PrintObject::has_support_material() const
 {
     return m_config.support_material
@@ -720,6 +899,8 @@ void PrintObject::detect_surfaces_type()
     bool spiral_vase      = this->print()->config().spiral_vase.value;
     bool interface_shells = ! spiral_vase && m_config.interface_shells.value;
     size_t num_layers     = spiral_vase ? first_printing_region(*this)->config().bottom_solid_layers : m_layers.size();
+    // Layers to be processed, all of them unless just the layers around a layer height change were resliced (never in spiral vase mode).
+    auto [layer_begin, layer_end] = this->layers_to_process();
 
     for (size_t idx_region = 0; idx_region < this->region_volumes.size(); ++ idx_region) {
         BOOST_LOG_TRIVIAL(debug) << "Detecting solid surfaces for region " << idx_region << " in parallel - start";
@@ -734,146 +915,19 @@ void PrintObject::detect_surfaces_type()
         if (interface_shells)
             surfaces_new.assign(num_layers, Surfaces());
 
-        tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, 
-            	spiral_vase ?
-            		// In spiral vase mode, reserve the last layer for the top surface if more than 1 layer is planned for the vase bottom.
-            		((num_layers > 1) ? num_layers - 1 : num_layers) :
-            		// In non-spiral vase mode, go over all layers.
-            		m_layers.size()),
+        execution::parallel_for(
+            this->print()->execution_policy(),
+            spiral_vase ?
+                // In spiral vase mode, reserve the last layer for the top surface if more than 1 layer is planned for the vase bottom.
+            	tbb::blocked_range<size_t>(0, (num_layers > 1) ? num_layers - 1 : num_layers) :
+            	// In non-spiral vase mode, go over all layers to be processed.
+            	tbb::blocked_range<size_t>(layer_begin, layer_end),
             [this, idx_region, interface_shells, &surfaces_new](const tbb::blocked_range<size_t>& range) {
-                // If we have raft layers, consider bottom layer as a bridge just like any other bottom surface lying on the void.
-                SurfaceType surface_type_bottom_1st =
-                    (m_config.raft_layers.value > 0 && m_config.support_material_contact_distance.value > 0) ?
-                    stBottomBridge : stBottom;
-                // If we have soluble support material, don't bridge. The overhang will be squished against a soluble layer separating
-                // the support from the print.
-                SurfaceType surface_type_bottom_other =
-                    (m_config.support_material.value && m_config.support_material_contact_distance.value == 0) ?
-                    stBottom : stBottomBridge;
                 for (size_t idx_layer = range.begin(); idx_layer < range.end(); ++ idx_layer) {
                     m_print->throw_if_canceled();
                     // BOOST_LOG_TRIVIAL(trace) << "Detecting solid surfaces for region " << idx_region << " and layer " << layer->print_z;
-                    Layer       *layer  = m_layers[idx_layer];
-                    LayerRegion *layerm = layer->m_regions[idx_region];
-                    // comparison happens against the *full* slices (considering all regions)
-                    // unless internal shells are requested
-                    Layer       *upper_layer = (idx_layer + 1 < this->layer_count()) ? m_layers[idx_layer + 1] : nullptr;
-                    Layer       *lower_layer = (idx_layer > 0) ? m_layers[idx_layer - 1] : nullptr;
-                    // collapse very narrow parts (using the safety offset in the diff is not enough)
-                    float        offset = layerm->flow(frExternalPerimeter).scaled_width() / 10.f;
-
-                    Polygons     layerm_slices_surfaces = to_polygons(layerm->slices.surfaces);
-
-                    // find top surfaces (difference between current surfaces
-                    // of current layer and upper one)
-                    Surfaces top;
-                    if (upper_layer) {
-                        Polygons upper_slices = interface_shells ? 
-                            to_polygons(upper_layer->m_regions[idx_region]->slices.surfaces) : 
-                            to_polygons(upper_layer->lslices);
-                        surfaces_append(top,
-                            //FIXME implement offset2_ex working over ExPolygons, that should be a bit more efficient than calling offset_ex twice.
-                            offset_ex(offset_ex(diff_ex(layerm_slices_surfaces, upper_slices, true), -offset), offset),
-                            stTop);
-                    } else {
-                        // if no upper layer, all surfaces of this one are solid
-                        // we clone surfaces because we're going to clear the slices collection
-                        top = layerm->slices.surfaces;
-                        for (Surface &surface : top)
-                            surface.surface_type = stTop;
-                    }
-                    
-                    // Find bottom surfaces (difference between current surfaces of current layer and lower one).
-                    Surfaces bottom;
-                    if (lower_layer) {
-#if 0
-                        //FIXME Why is this branch failing t\multi.t ?
-                        Polygons lower_slices = interface_shells ? 
-                            to_polygons(lower_layer->get_region(idx_region)->slices.surfaces) : 
-                            to_polygons(lower_layer->slices);
-                        surfaces_append(bottom,
-                            offset2_ex(diff(layerm_slices_surfaces, lower_slices, true), -offset, offset),
-                            surface_type_bottom_other);
-#else
-                        // Any surface lying on the void is a true bottom bridge (an overhang)
-                        surfaces_append(
-                            bottom,
-                            offset2_ex(
-                                diff(layerm_slices_surfaces, to_polygons(lower_layer->lslices), true), 
-                                -offset, offset),
-                            surface_type_bottom_other);
-                        // if user requested internal shells, we need to identify surfaces
-                        // lying on other slices not belonging to this region
-                        if (interface_shells) {
-                            // non-bridging bottom surfaces: any part of this layer lying 
-                            // on something else, excluding those lying on our own region
-                            surfaces_append(
-                                bottom,
-                                offset2_ex(
-                                    diff(
-                                        intersection(layerm_slices_surfaces, to_polygons(lower_layer->lslices)), // supported
-                                        to_polygons(lower_layer->m_regions[idx_region]->slices.surfaces), 
-                                        true), 
-                                    -offset, offset),
-                                stBottom);
-                        }
-#endif
-                    } else {
-                        // if no lower layer, all surfaces of this one are solid
-                        // we clone surfaces because we're going to clear the slices collection
-                        bottom = layerm->slices.surfaces;
-                        for (Surface &surface : bottom)
-                            surface.surface_type = surface_type_bottom_1st;
-                    }
-                    
-                    // now, if the object contained a thin membrane, we could have overlapping bottom
-                    // and top surfaces; let's do an intersection to discover them and consider them
-                    // as bottom surfaces (to allow for bridge detection)
-                    if (! top.empty() && ! bottom.empty()) {
-        //                Polygons overlapping = intersection(to_polygons(top), to_polygons(bottom));
-        //                Slic3r::debugf "  layer %d contains %d membrane(s)\n", $layerm->layer->id, scalar(@$overlapping)
-        //                    if $Slic3r::debug;
-                        Polygons top_polygons = to_polygons(std::move(top));
-                        top.clear();
-                        surfaces_append(top,
-                            diff_ex(top_polygons, to_polygons(bottom), false),
-                            stTop);
-                    }
-
-        #ifdef SLIC3R_DEBUG_SLICE_PROCESSING
-                    {
-                        static int iRun = 0;
-                        std::vector<std::pair<Slic3r::ExPolygons, SVG::ExPolygonAttributes>> expolygons_with_attributes;
-                        expolygons_with_attributes.emplace_back(std::make_pair(union_ex(top),                           SVG::ExPolygonAttributes("green")));
-                        expolygons_with_attributes.emplace_back(std::make_pair(union_ex(bottom),                        SVG::ExPolygonAttributes("brown")));
-                        expolygons_with_attributes.emplace_back(std::make_pair(to_expolygons(layerm->slices.surfaces),  SVG::ExPolygonAttributes("black")));
-                        SVG::export_expolygons(debug_out_path("1_detect_surfaces_type_%d_region%d-layer_%f.svg", iRun ++, idx_region, layer->print_z).c_str(), expolygons_with_attributes);
-                    }
-        #endif /* SLIC3R_DEBUG_SLICE_PROCESSING */
-                    
-                    // save surfaces to layer
-                    Surfaces &surfaces_out = interface_shells ? surfaces_new[idx_layer] : layerm->slices.surfaces;
-                    surfaces_out.clear();
-
-                    // find internal surfaces (difference between top/bottom surfaces and others)
-                    {
-                        Polygons topbottom = to_polygons(top);
-                        polygons_append(topbottom, to_polygons(bottom));
-                        surfaces_append(surfaces_out,
-                            diff_ex(layerm_slices_surfaces, topbottom, false),
-                            stInternal);
-                    }
-
-                    surfaces_append(surfaces_out, std::move(top));
-                    surfaces_append(surfaces_out, std::move(bottom));
-                    
-        //            Slic3r::debugf "  layer %d has %d bottom, %d top and %d internal surfaces\n",
-        //                $layerm->layer->id, scalar(@bottom), scalar(@top), scalar(@internal) if $Slic3r::debug;
-
-        #ifdef SLIC3R_DEBUG_SLICE_PROCESSING
-                    layerm->export_region_slices_to_svg_debug("detect_surfaces_type-final");
-        #endif /* SLIC3R_DEBUG_SLICE_PROCESSING */
+                    this->detect_surfaces_type(idx_layer, idx_region, interface_shells,
+                        interface_shells ? surfaces_new[idx_layer] : m_layers[idx_layer]->m_regions[idx_region]->slices.surfaces);
                 }
             }
         ); // for each layer of a region
@@ -881,7 +935,7 @@ void PrintObject::detect_surfaces_type()
 
         if (interface_shells) {
             // Move surfaces_new to layerm->slices.surfaces
-            for (size_t idx_layer = 0; idx_layer < num_layers; ++ idx_layer)
+            for (size_t idx_layer = layer_begin; idx_layer < layer_end; ++ idx_layer)
                 m_layers[idx_layer]->m_regions[idx_region]->slices.surfaces = std::move(surfaces_new[idx_layer]);
         }
 
@@ -895,8 +949,9 @@ void PrintObject::detect_surfaces_type()
 
         BOOST_LOG_TRIVIAL(debug) << "Detecting solid surfaces for region " << idx_region << " - clipping in parallel - start";
         // Fill in layerm->fill_surfaces by trimming the layerm->slices by the cummulative layerm->fill_surfaces.
-        tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, m_layers.size()),
+        execution::parallel_for(
+            this->print()->execution_policy(),
+            tbb::blocked_range<size_t>(layer_begin, layer_end),
             [this, idx_region, interface_shells](const tbb::blocked_range<size_t>& range) {
                 for (size_t idx_layer = range.begin(); idx_layer < range.end(); ++ idx_layer) {
                     m_print->throw_if_canceled();
@@ -905,6 +960,10 @@ void PrintObject::detect_surfaces_type()
 #ifdef SLIC3R_DEBUG_SLICE_PROCESSING
                     layerm->export_region_fill_surfaces_to_svg_debug("1_detect_surfaces_type-final");
 #endif /* SLIC3R_DEBUG_SLICE_PROCESSING */
+                    // Decide what surfaces are to be filled while the fill surfaces of this layer are hot in the cache.
+                    // Here the stTop / stBottomBridge / stBottom infill is turned to just stInternal if zero top / bottom infill layers are configured.
+                    // Also tiny stInternal surfaces are turned to stInternalSolid.
+                    layerm->prepare_fill_surfaces();
                 } // for each layer of a region
             });
         m_print->throw_if_canceled();
@@ -915,10 +974,146 @@ void PrintObject::detect_surfaces_type()
     m_typed_slices = true;
 }
 
+// Classifies the slices of a single layer region into top, bottom and internal surfaces, see detect_surfaces_type() above.
+// The surfaces are stored into surfaces_out, which may be the slices of the layer region unless interface_shells are enabled.
+void PrintObject::detect_surfaces_type(size_t idx_layer, size_t idx_region, bool interface_shells, Surfaces &surfaces_out)
+{
+    // If we have raft layers, consider bottom layer as a bridge just like any other bottom surface lying on the void.
+    SurfaceType surface_type_bottom_1st =
+        (m_config.raft_layers.value > 0 && m_config.support_material_contact_distance.value > 0) ?
+        stBottomBridge : stBottom;
+    // If we have soluble support material, don't bridge. The overhang will be squished against a soluble layer separating
+    // the support from the print.
+    SurfaceType surface_type_bottom_other =
+        (m_config.support_material.value && m_config.support_material_contact_distance.value == 0) ?
+        stBottom : stBottomBridge;
+    Layer       *layer  = m_layers[idx_layer];
+    LayerRegion *layerm = layer->m_regions[idx_region];
+    // comparison happens against the *full* slices (considering all regions)
+    // unless internal shells are requested
+    Layer       *upper_layer = (idx_layer + 1 < this->layer_count()) ? m_layers[idx_layer + 1] : nullptr;
+    Layer       *lower_layer = (idx_layer > 0) ? m_layers[idx_layer - 1] : nullptr;
+    // collapse very narrow parts (using the safety offset in the diff is not enough)
+    float        offset = layerm->flow(frExternalPerimeter).scaled_width() / 10.f;
+
+    Polygons     layerm_slices_surfaces = to_polygons(layerm->slices.surfaces);
+
+    // find top surfaces (difference between current surfaces
+    // of current layer and upper one)
+    Surfaces top;
+    if (upper_layer) {
+        Polygons upper_slices = interface_shells ? 
+            to_polygons(upper_layer->m_regions[idx_region]->slices.surfaces) : 
+            to_polygons(upper_layer->lslices);
+        surfaces_append(top,
+            //FIXME implement offset2_ex working over ExPolygons, that should be a bit more efficient than calling offset_ex twice.
+            offset_ex(offset_ex(diff_ex(layerm_slices_surfaces, upper_slices, true), -offset), offset),
+            stTop);
+    } else {
+        // if no upper layer, all surfaces of this one are solid
+        // we clone surfaces because we're going to clear the slices collection
+        top = layerm->slices.surfaces;
+        for (Surface &surface : top)
+            surface.surface_type = stTop;
+    }
+    
+    // Find bottom surfaces (difference between current surfaces of current layer and lower one).
+    Surfaces bottom;
+    if (lower_layer) {
+#if 0
+        //FIXME Why is this branch failing t\multi.t ?
+        Polygons lower_slices = interface_shells ? 
+            to_polygons(lower_layer->get_region(idx_region)->slices.surfaces) : 
+            to_polygons(lower_layer->slices);
+        surfaces_append(bottom,
+            offset2_ex(diff(layerm_slices_surfaces, lower_slices, true), -offset, offset),
+            surface_type_bottom_other);
+#else
+        // Any surface lying on the void is a true bottom bridge (an overhang)
+        surfaces_append(
+            bottom,
+            offset2_ex(
+                diff(layerm_slices_surfaces, to_polygons(lower_layer->lslices), true), 
+                -offset, offset),
+            surface_type_bottom_other);
+        // if user requested internal shells, we need to identify surfaces
+        // lying on other slices not belonging to this region
+        if (interface_shells) {
+            // non-bridging bottom surfaces: any part of this layer lying 
+            // on something else, excluding those lying on our own region
+            surfaces_append(
+                bottom,
+                offset2_ex(
+                    diff(
+                        intersection(layerm_slices_surfaces, to_polygons(lower_layer->lslices)), // supported
+                        to_polygons(lower_layer->m_regions[idx_region]->slices.surfaces), 
+                        true), 
+                    -offset, offset),
+                stBottom);
+        }
+#endif
+    } else {
+        // if no lower layer, all surfaces of this one are solid
+        // we clone surfaces because we're going to clear the slices collection
+        bottom = layerm->slices.surfaces;
+        for (Surface &surface : bottom)
+            surface.surface_type = surface_type_bottom_1st;
+    }
+    
+    // now, if the object contained a thin membrane, we could have overlapping bottom
+    // and top surfaces; let's do an intersection to discover them and consider them
+    // as bottom surfaces (to allow for bridge detection)
+    if (! top.empty() && ! bottom.empty()) {
+        //                Polygons overlapping = intersection(to_polygons(top), to_polygons(bottom));
+        //                Slic3r::debugf "  layer %d contains %d membrane(s)\n", $layerm->layer->id, scalar(@$overlapping)
+        //                    if $Slic3r::debug;
+        Polygons top_polygons = to_polygons(std::move(top));
+        top.clear();
+        surfaces_append(top,
+            diff_ex(top_polygons, to_polygons(bottom), false),
+            stTop);
+    }
+
+#ifdef SLIC3R_DEBUG_SLICE_PROCESSING
+    {
+        static int iRun = 0;
+        std::vector<std::pair<Slic3r::ExPolygons, SVG::ExPolygonAttributes>> expolygons_with_attributes;
+        expolygons_with_attributes.emplace_back(std::make_pair(union_ex(top),                           SVG::ExPolygonAttributes("green")));
+        expolygons_with_attributes.emplace_back(std::make_pair(union_ex(bottom),                        SVG::ExPolygonAttributes("brown")));
+        expolygons_with_attributes.emplace_back(std::make_pair(to_expolygons(layerm->slices.surfaces),  SVG::ExPolygonAttributes("black")));
+        SVG::export_expolygons(debug_out_path("1_detect_surfaces_type_%d_region%d-layer_%f.svg", iRun ++, idx_region, layer->print_z).c_str(), expolygons_with_attributes);
+    }
+#endif /* SLIC3R_DEBUG_SLICE_PROCESSING */
+    
+    // save surfaces to layer
+    surfaces_out.clear();
+
+    // find internal surfaces (difference between top/bottom surfaces and others)
+    {
+        Polygons topbottom = to_polygons(top);
+        polygons_append(topbottom, to_polygons(bottom));
+        surfaces_append(surfaces_out,
+            diff_ex(layerm_slices_surfaces, topbottom, false),
+            stInternal);
+    }
+
+    surfaces_append(surfaces_out, std::move(top));
+    surfaces_append(surfaces_out, std::move(bottom));
+    
+        //            Slic3r::debugf "  layer %d has %d bottom, %d top and %d internal surfaces\n",
+        //                $layerm->layer->id, scalar(@bottom), scalar(@top), scalar(@internal) if $Slic3r::debug;
+
+#ifdef SLIC3R_DEBUG_SLICE_PROCESSING
+    layerm->export_region_slices_to_svg_debug("detect_surfaces_type-final");
+#endif /* SLIC3R_DEBUG_SLICE_PROCESSING */
+}
+
 void PrintObject::process_external_surfaces()
 {
     BOOST_LOG_TRIVIAL(info) << "Processing external surfaces..." << log_memory_info();
 
+    // Layers to be processed, all of them unless just the layers around a layer height change were resliced.
+    auto [layer_begin, layer_end] = this->layers_to_process();
     // Cached surfaces covered by some extrusion, defining regions, over which the from the surfaces one layer higher are allowed to expand.
     std::vector<Polygons> surfaces_covered;
     // Is there any printing region, that has zero infill? If so, then we don't want the expansion to be performed over the complete voids, but only
@@ -932,7 +1127,7 @@ void PrintObject::process_external_surfaces()
 	if (has_voids && m_layers.size() > 1) {
 	    // All but stInternal fill surfaces will get expanded and possibly trimmed.
 	    std::vector<unsigned char> layer_expansions_and_voids(m_layers.size(), false);
-	    for (size_t layer_idx = 0; layer_idx < m_layers.size(); ++ layer_idx) {
+	    for (size_t layer_idx = layer_begin; layer_idx < layer_end; ++ layer_idx) {
 	    	const Layer *layer = m_layers[layer_idx];
 	    	bool expansions = false;
 	    	bool voids      = false;
@@ -953,8 +1148,9 @@ void PrintObject::process_external_surfaces()
 	    BOOST_LOG_TRIVIAL(debug) << "Collecting surfaces covered with extrusions in parallel - start";
 	    surfaces_covered.resize(m_layers.size() - 1, Polygons());
     	auto unsupported_width = - float(scale_(0.3 * EXTERNAL_INFILL_MARGIN));
-	    tbb::parallel_for(
-	        tbb::blocked_range<size_t>(0, m_layers.size() - 1),
+	    execution::parallel_for(
+	        this->print()->execution_policy(),
+	        tbb::blocked_range<size_t>(std::max(layer_begin, size_t(1)) - 1, std::max(layer_end, size_t(1)) - 1),
 	        [this, &surfaces_covered, &layer_expansions_and_voids, unsupported_width](const tbb::blocked_range<size_t>& range) {
 	            for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx)
 	            	if (layer_expansions_and_voids[layer_idx + 1]) {
@@ -976,8 +1172,9 @@ void PrintObject::process_external_surfaces()
 
 	for (size_t region_id = 0; region_id < this->region_volumes.size(); ++region_id) {
         BOOST_LOG_TRIVIAL(debug) << "Processing external surfaces for region " << region_id << " in parallel - start";
-        tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, m_layers.size()),
+        execution::parallel_for(
+            this->print()->execution_policy(),
+            tbb::blocked_range<size_t>(layer_begin, layer_end),
             [this, &surfaces_covered, region_id](const tbb::blocked_range<size_t>& range) {
                 for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
                     m_print->throw_if_canceled();
@@ -1022,6 +1219,21 @@ void PrintObject::discover_vertical_shells()
 	    	   num_extra_layers(config.bottom_solid_layers, config.bottom_solid_min_thickness) > 0;
     };
     std::vector<DiscoverVerticalShellsCacheEntry> cache_top_botom_regions(num_layers, DiscoverVerticalShellsCacheEntry());
+    // Layers to be processed, all of them unless just the layers around a layer height change were resliced (never in spiral vase mode).
+    // The cache is filled in for these layers and for their neighbors up to the shell thickness.
+    auto [layer_begin, layer_end] = this->layers_to_process();
+    layer_end = std::min(layer_end, num_layers);
+    std::pair<size_t, size_t> cache_range(layer_begin, layer_end);
+    if (layer_begin > 0 || layer_end < num_layers) {
+        size_t   num_solid_layers = 0;
+        coordf_t shell_thickness  = 0.;
+        for (size_t idx_region = 0; idx_region < this->region_volumes.size(); ++ idx_region) {
+            const PrintRegionConfig &config = m_print->get_region(idx_region)->config();
+            num_solid_layers = std::max(num_solid_layers, size_t(std::max(config.top_solid_layers.value, config.bottom_solid_layers.value)));
+            shell_thickness  = std::max(shell_thickness, std::max(config.top_solid_min_thickness.value, config.bottom_solid_min_thickness.value));
+        }
+        cache_range = extend_layer_range(m_layers, cache_range, num_solid_layers, shell_thickness);
+    }
     bool top_bottom_surfaces_all_regions = this->region_volumes.size() > 1 && ! m_config.interface_shells.value;
     if (top_bottom_surfaces_all_regions) {
         // This is a multi-material print and interface_shells are disabled, meaning that the vertical shell thickness
@@ -1041,8 +1253,9 @@ void PrintObject::discover_vertical_shells()
         BOOST_LOG_TRIVIAL(debug) << "Discovering vertical shells in parallel - start : cache top / bottom";
         //FIXME Improve the heuristics for a grain size.
         size_t grain_size = std::max(num_layers / 16, size_t(1));
-        tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, num_layers, grain_size),
+        execution::parallel_for(
+            this->print()->execution_policy(),
+            tbb::blocked_range<size_t>(cache_range.first, cache_range.second, grain_size),
             [this, &cache_top_botom_regions](const tbb::blocked_range<size_t>& range) {
                 const SurfaceType surfaces_bottom[2] = { stBottom, stBottomBridge };
                 const size_t num_regions = this->region_volumes.size();
@@ -1124,8 +1337,9 @@ void PrintObject::discover_vertical_shells()
             // This is either a single material print, or a multi-material print and interface_shells are enabled, meaning that the vertical shell thickness
             // is calculated over a single material.
             BOOST_LOG_TRIVIAL(debug) << "Discovering vertical shells for region " << idx_region << " in parallel - start : cache top / bottom";
-            tbb::parallel_for(
-                tbb::blocked_range<size_t>(0, num_layers, grain_size),
+            execution::parallel_for(
+                this->print()->execution_policy(),
+                tbb::blocked_range<size_t>(cache_range.first, cache_range.second, grain_size),
                 [this, idx_region, &cache_top_botom_regions](const tbb::blocked_range<size_t>& range) {
                     const SurfaceType surfaces_bottom[2] = { stBottom, stBottomBridge };
                     for (size_t idx_layer = range.begin(); idx_layer < range.end(); ++ idx_layer) {
@@ -1152,8 +1366,9 @@ void PrintObject::discover_vertical_shells()
         }
 
         BOOST_LOG_TRIVIAL(debug) << "Discovering vertical shells for region " << idx_region << " in parallel - start : ensure vertical wall thickness";
-        tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, num_layers, grain_size),
+        execution::parallel_for(
+            this->print()->execution_policy(),
+            tbb::blocked_range<size_t>(layer_begin, layer_end, grain_size),
             [this, idx_region, &cache_top_botom_regions]
             (const tbb::blocked_range<size_t>& range) {
                 // printf("discover_vertical_shells from %d to %d\n", range.begin(), range.end());
@@ -1411,6 +1626,9 @@ void PrintObject::bridge_over_infill()
 {
     BOOST_LOG_TRIVIAL(info) << "Bridge over infill..." << log_memory_info();
 
+    // Layers to be processed, all of them unless just the layers around a layer height change were resliced.
+    auto [layer_begin, layer_end] = this->layers_to_process();
+
     for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id) {
         const PrintRegion &region = *m_print->regions()[region_id];
         
@@ -1427,7 +1645,7 @@ void PrintObject::bridge_over_infill()
             *this
         );
         
-		for (LayerPtrs::iterator layer_it = m_layers.begin(); layer_it != m_layers.end(); ++ layer_it) {
+		for (LayerPtrs::iterator layer_it = m_layers.begin() + layer_begin; layer_it != m_layers.begin() + layer_end; ++ layer_it) {
             // skip first layer
 			if (layer_it == m_layers.begin())
                 continue;
@@ -1673,6 +1891,143 @@ bool PrintObject::update_layer_height_profile(const ModelObject &model_object, c
     return updated;
 }
 
+// Called by _slice() after just the layer heights of the object changed, see invalidate_layer_heights().
+// The new layers are matched against the layers of the last slicing pass by their Z span. The layers, which did not match,
+// are resliced together with their neighbors up to the distance the surface classification, the shells, the bridges
+// over infill and the extra perimeters look at, and all of them will be reprocessed by the following steps.
+// The other layers keep their slices, perimeters and infill.
+bool PrintObject::reuse_unchanged_layers(const std::vector<coordf_t> &object_layers, std::pair<size_t, size_t> &layers_to_slice)
+{
+    bool reuse = m_reslice_changed_layers_only;
+    m_reslice_changed_layers_only = false;
+    if (! reuse || m_layers.empty() || object_layers.empty())
+        return false;
+
+    // The following features make a layer depend on the layers far away or on the layer index, reslice the whole object if enabled.
+    if (this->print()->config().spiral_vase.value || m_config.infill_only_where_needed.value)
+        return false;
+    // The layers to be reused have to be split into the same regions.
+    if (m_layers.front()->regions().size() != this->region_volumes.size())
+        return false;
+    size_t   num_solid_layers = 0;
+    coordf_t shell_thickness  = 0.;
+    for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id) {
+        if (m_layers.front()->regions()[region_id]->region() != m_print->get_region(region_id))
+            return false;
+        if (this->region_volumes[region_id].empty())
+            continue;
+        const PrintRegionConfig &config = m_print->get_region(region_id)->config();
+        if (config.infill_every_layers.value > 1 || config.solid_infill_every_layers.value > 0 ||
+            // The octrees of these infills are built over the whole object.
+            config.fill_pattern.value == ipAdaptiveCubic || config.fill_pattern.value == ipSupportCubic)
+            return false;
+        num_solid_layers = std::max(num_solid_layers, size_t(std::max(config.top_solid_layers.value, config.bottom_solid_layers.value)));
+        shell_thickness  = std::max(shell_thickness, std::max(config.top_solid_min_thickness.value, config.bottom_solid_min_thickness.value));
+    }
+
+    // Match the new layers against the old ones.
+    const size_t   num_layers  = object_layers.size() / 2;
+    const coordf_t print_z_min = m_slicing_params.object_print_z_min;
+    // Index of the old layer with the same Z span as the new layer, -1 if there is none.
+    std::vector<int> old_layer_idx(num_layers, -1);
+    for (size_t i = 0, j = 0; i < num_layers; ++ i) {
+        coordf_t print_z = object_layers[2 * i + 1] + print_z_min;
+        coordf_t height  = object_layers[2 * i + 1] - object_layers[2 * i];
+        for (; j < m_layers.size() && m_layers[j]->print_z < print_z - EPSILON; ++ j) ;
+        if (j < m_layers.size() && std::abs(m_layers[j]->print_z - print_z) < EPSILON && std::abs(m_layers[j]->height - height) < EPSILON &&
+            // The layers, which were not reprocessed yet after the last change of layer heights, are not reused.
+            (print_z < m_process_z_range.first - EPSILON || print_z > m_process_z_range.second + EPSILON))
+            old_layer_idx[i] = int(j);
+    }
+    size_t changed_begin = 0;
+    size_t changed_end   = num_layers;
+    for (; changed_begin < num_layers && old_layer_idx[changed_begin] != -1; ++ changed_begin) ;
+    for (; changed_end > changed_begin && old_layer_idx[changed_end - 1] != -1; -- changed_end) ;
+    // Layers to be reprocessed, their results differ from the results of the last slicing pass.
+    std::pair<size_t, size_t> layers_to_reprocess(changed_begin, changed_end);
+    layers_to_slice = layers_to_reprocess;
+    if (changed_begin < changed_end) {
+        // The extra perimeters, the surface classification and the external surfaces look at the layers above and below,
+        // the vertical and then the horizontal shells up to the number of solid layers or the minimum shell thickness, the bridges
+        // over infill up to the bridge flow height. A change of a layer propagates through all of these steps, one after the other.
+        auto extend = [&object_layers, num_solid_layers, shell_thickness, this](const std::pair<size_t, size_t> &range) {
+            return extend_layer_range(object_layers, range, 2 * num_solid_layers + 3,
+                2. * shell_thickness + *std::max_element(m_print->config().nozzle_diameter.values.begin(), m_print->config().nozzle_diameter.values.end()));
+        };
+        layers_to_reprocess = extend(layers_to_reprocess);
+        // The layers reprocessed next to the unchanged layers would see these neighbors in their final state, while a full run shows
+        // them in the state of the step being run. Reslice and reprocess the guard layers around the layers to be reprocessed as well,
+        // as far as such a difference may propagate, and keep their results of the last slicing pass.
+        layers_to_slice = extend(layers_to_reprocess);
+        if (layers_to_slice.first == 0 && layers_to_slice.second == num_layers)
+            // Reslicing the whole object.
+            return false;
+    }
+    BOOST_LOG_TRIVIAL(info) << "Slicing objects - reprocessing layers " << layers_to_reprocess.first << " to " << layers_to_reprocess.second <<
+        ", reslicing layers " << layers_to_slice.first << " to " << layers_to_slice.second << " of " << num_layers;
+
+    // Reuse the old layers outside of the layers to be sliced, create the new ones in between.
+    // The old guard layers are set aside until their copies are processed.
+    const size_t raft_layers   = m_slicing_params.raft_layers();
+    // Index of the first layer, from which the layer ids changed.
+    size_t                     first_shifted = num_layers;
+    std::vector<unsigned char> reused(m_layers.size(), false);
+    LayerPtrs                  layers;
+    layers.reserve(num_layers);
+    assert(m_guard_layers.empty());
+    for (size_t i = 0; i < num_layers; ++ i) {
+        coordf_t lo = object_layers[2 * i];
+        coordf_t hi = object_layers[2 * i + 1];
+        if (old_layer_idx[i] != -1) {
+            Layer *old_layer = m_layers[old_layer_idx[i]];
+            if (old_layer->id() != raft_layers + i)
+                first_shifted = std::min(first_shifted, i);
+            if (i < layers_to_reprocess.first || i >= layers_to_reprocess.second) {
+                reused[old_layer_idx[i]] = true;
+                if (i >= layers_to_slice.first && i < layers_to_slice.second)
+                    m_guard_layers.emplace_back(old_layer);
+            }
+        }
+        Layer *layer;
+        if (i >= layers_to_slice.first && i < layers_to_slice.second) {
+            layer = new Layer(raft_layers + i, this, hi - lo, hi + print_z_min, 0.5 * (lo + hi));
+            // Make sure all layers contain layer region objects for all regions.
+            for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id)
+                layer->add_region(this->print()->regions()[region_id]);
+        } else {
+            assert(old_layer_idx[i] != -1);
+            layer = m_layers[old_layer_idx[i]];
+            layer->set_id(raft_layers + i);
+            layer->height  = hi - lo;
+            layer->print_z = hi + print_z_min;
+            layer->slice_z = 0.5 * (lo + hi);
+        }
+        layer->lower_layer = layers.empty() ? nullptr : layers.back();
+        layer->upper_layer = nullptr;
+        if (! layers.empty())
+            layers.back()->upper_layer = layer;
+        layers.emplace_back(layer);
+    }
+    for (size_t j = 0; j < m_layers.size(); ++ j)
+        if (! reused[j])
+            delete m_layers[j];
+    m_layers = std::move(layers);
+
+    // The changed layers are reprocessed together with the layers not yet reprocessed after the last change of layer heights,
+    // which were not matched above. The slices of the reused layers stay classified, thus m_typed_slices is left set.
+    auto merge = [](const std::pair<coordf_t, coordf_t> &a, const std::pair<coordf_t, coordf_t> &b)
+        { return std::make_pair(std::min(a.first, b.first), std::max(a.second, b.second)); };
+    m_process_z_range = no_layers_z_range;
+    if (layers_to_reprocess.first < layers_to_reprocess.second) {
+        m_process_z_range = { m_layers[layers_to_reprocess.first]->print_z, m_layers[layers_to_reprocess.second - 1]->print_z };
+        m_fill_z_range    = merge(m_fill_z_range, m_process_z_range);
+    }
+    if (first_shifted < num_layers)
+        // The infill direction alternates with the layer id.
+        m_fill_z_range = merge(m_fill_z_range, { m_layers[first_shifted]->print_z, std::numeric_limits<coordf_t>::max() });
+    return true;
+}
+
 // 1) Decides Z positions of the layers,
 // 2) Initializes layers and their regions
 // 3) Slices the object meshes
@@ -1686,34 +2041,48 @@ void PrintObject::_slice(const std::vector<coordf_t> &layer_height_profile)
 {
     BOOST_LOG_TRIVIAL(info) << "Slicing objects..." << log_memory_info();
 
-    m_typed_slices = false;
-
     // 1) Initialize layers and their slice heights.
     std::vector<float> slice_zs;
+    // Index range of the layers to be sliced, the other layers are reused from the last slicing pass.
+    std::pair<size_t, size_t> layers_to_slice;
     {
-        this->clear_layers();
         // Object layers (pairs of bottom/top Z coordinate), without the raft.
         std::vector<coordf_t> object_layers = generate_object_layers(m_slicing_params, layer_height_profile);
-        // Reserve object layers for the raft. Last layer of the raft is the contact layer.
-        int id = int(m_slicing_params.raft_layers());
-        slice_zs.reserve(object_layers.size());
-        Layer *prev = nullptr;
-        for (size_t i_layer = 0; i_layer < object_layers.size(); i_layer += 2) {
-            coordf_t lo = object_layers[i_layer];
-            coordf_t hi = object_layers[i_layer + 1];
-            coordf_t slice_z = 0.5 * (lo + hi);
-            Layer *layer = this->add_layer(id ++, hi - lo, hi + m_slicing_params.object_print_z_min, slice_z);
-            slice_zs.push_back(float(slice_z));
-            if (prev != nullptr) {
-                prev->upper_layer = layer;
-                layer->lower_layer = prev;
+        if (this->reuse_unchanged_layers(object_layers, layers_to_slice)) {
+            slice_zs.reserve(layers_to_slice.second - layers_to_slice.first);
+            for (size_t i_layer = layers_to_slice.first; i_layer < layers_to_slice.second; ++ i_layer)
+                slice_zs.push_back(float(m_layers[i_layer]->slice_z));
+        } else {
+            this->clear_layers();
+            this->process_all_layers();
+            m_typed_slices = false;
+            // Reserve object layers for the raft. Last layer of the raft is the contact layer.
+            int id = int(m_slicing_params.raft_layers());
+            slice_zs.reserve(object_layers.size());
+            Layer *prev = nullptr;
+            for (size_t i_layer = 0; i_layer < object_layers.size(); i_layer += 2) {
+                coordf_t lo = object_layers[i_layer];
+                coordf_t hi = object_layers[i_layer + 1];
+                coordf_t slice_z = 0.5 * (lo + hi);
+                Layer *layer = this->add_layer(id ++, hi - lo, hi + m_slicing_params.object_print_z_min, slice_z);
+                slice_zs.push_back(float(slice_z));
+                if (prev != nullptr) {
+                    prev->upper_layer = layer;
+                    layer->lower_layer = prev;
+                }
+                // Make sure all layers contain layer region objects for all regions.
+                for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id)
+                    layer->add_region(this->print()->regions()[region_id]);
+                prev = layer;
             }
-            // Make sure all layers contain layer region objects for all regions.
-            for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id)
-                layer->add_region(this->print()->regions()[region_id]);
-            prev = layer;
+            layers_to_slice = { 0, m_layers.size() };
         }
     }
+    if (slice_zs.empty())
+        // No layer changed.
+        return;
+    // Layers to be sliced are indexed by the index of their slice_z.
+    Layer **layers = m_layers.data() + layers_to_slice.first;
 
     // Count model parts and modifier meshes, check whether the model parts are of the same region.
     int              all_volumes_single_region = -2; // not set yet
@@ -1758,7 +2127,7 @@ void PrintObject::_slice(const std::vector<coordf_t> &layer_height_profile)
             m_print->throw_if_canceled();
             BOOST_LOG_TRIVIAL(debug) << "Slicing objects - append slices " << region_id << " start";
             for (size_t layer_id = 0; layer_id < expolygons_by_layer.size(); ++ layer_id)
-                m_layers[layer_id]->regions()[region_id]->slices.append(std::move(expolygons_by_layer[layer_id]), stInternal);
+                layers[layer_id]->regions()[region_id]->slices.append(std::move(expolygons_by_layer[layer_id]), stInternal);
             m_print->throw_if_canceled();
             BOOST_LOG_TRIVIAL(debug) << "Slicing objects - append slices " << region_id << " end";
         }
@@ -1800,9 +2169,10 @@ void PrintObject::_slice(const std::vector<coordf_t> &layer_height_profile)
 		}
         // Second clip the volumes in the order they are presented at the user interface.
         BOOST_LOG_TRIVIAL(debug) << "Slicing objects - parallel clipping - start";
-        tbb::parallel_for(
+        execution::parallel_for(
+            this->print()->execution_policy(),
             tbb::blocked_range<size_t>(0, slice_zs.size()),
-            [this, &sliced_volumes, num_modifiers](const tbb::blocked_range<size_t>& range) {
+            [this, layers, &sliced_volumes, num_modifiers](const tbb::blocked_range<size_t>& range) {
                 float delta   = float(scale_(m_config.xy_size_compensation.value));
                 // Only upscale together with clipping if there are no modifiers, as the modifiers shall be applied before upscaling
                 // (upscaling may grow the object outside of the modifier mesh).
@@ -1838,7 +2208,7 @@ void PrintObject::_slice(const std::vector<coordf_t> &layer_height_profile)
                         if (num_volumes > 1)
                             // Merge the islands using a positive / negative offset.
                             expolygons = offset_ex(offset_ex(expolygons, float(scale_(EPSILON))), -float(scale_(EPSILON)));
-                        m_layers[layer_id]->regions()[region_id]->slices.append(std::move(expolygons), stInternal);
+                        layers[layer_id]->regions()[region_id]->slices.append(std::move(expolygons), stInternal);
                     }
                 }
             });
@@ -1858,14 +2228,15 @@ void PrintObject::_slice(const std::vector<coordf_t> &layer_height_profile)
                 continue;
             // loop through the other regions and 'steal' the slices belonging to this one
             BOOST_LOG_TRIVIAL(debug) << "Slicing modifier volumes - stealing " << region_id << " start";
-            tbb::parallel_for(
-                tbb::blocked_range<size_t>(0, m_layers.size()),
-				[this, &expolygons_by_layer, region_id](const tbb::blocked_range<size_t>& range) {
+            execution::parallel_for(
+                this->print()->execution_policy(),
+                tbb::blocked_range<size_t>(0, slice_zs.size()),
+				[this, layers, &expolygons_by_layer, region_id](const tbb::blocked_range<size_t>& range) {
                     for (size_t layer_id = range.begin(); layer_id < range.end(); ++ layer_id) {
                         for (size_t other_region_id = 0; other_region_id < this->region_volumes.size(); ++ other_region_id) {
                             if (region_id == other_region_id)
                                 continue;
-                            Layer       *layer = m_layers[layer_id];
+                            Layer       *layer = layers[layer_id];
                             LayerRegion *layerm = layer->m_regions[region_id];
                             LayerRegion *other_layerm = layer->m_regions[other_region_id];
                             if (layerm == nullptr || other_layerm == nullptr || other_layerm->slices.empty() || expolygons_by_layer[layer_id].empty())
@@ -1910,8 +2281,10 @@ end:
         	0.f;
         // Uncompensated slices for the first layer in case the Elephant foot compensation is applied.
 	    ExPolygons  lslices_1st_layer;
-	    tbb::parallel_for(
-	        tbb::blocked_range<size_t>(0, m_layers.size()),
+	    execution::parallel_for(
+	        this->print()->execution_policy(),
+	        // Top empty layers may have been removed.
+	        tbb::blocked_range<size_t>(layers_to_slice.first, std::min(layers_to_slice.second, m_layers.size())),
 			[this, upscaled, clipped, xy_compensation_scaled, elephant_foot_compensation_scaled, &lslices_1st_layer]
 				(const tbb::blocked_range<size_t>& range) {
 	            for (size_t layer_id = range.begin(); layer_id < range.end(); ++ layer_id) {
@@ -1987,7 +2360,7 @@ end:
 	                layer->make_slices();
 	            }
 	        });
-	    if (elephant_foot_compensation_scaled > 0.f) {
+	    if (elephant_foot_compensation_scaled > 0.f && layers_to_slice.first == 0) {
 	    	// The Elephant foot has been compensated, therefore the 1st layer's lslices are shrank with the Elephant foot compensation value.
 	    	// Store the uncompensated value there.
 	    	assert(! m_layers.empty());
@@ -2151,6 +2524,7 @@ std::vector<ExPolygons> PrintObject::slice_volumes(const std::vector<float> &z,
             mesh.require_shared_vertices();
             TriangleMeshSlicer mslicer;
             mslicer.init(&mesh, callback);
+            mslicer.set_deterministic(print->execution_policy().deterministic);
 			mslicer.slice(z, mode, float(m_config.slice_closing_radius.value), &layers, callback);
             m_print->throw_if_canceled();
         }
@@ -2181,6 +2555,7 @@ std::vector<ExPolygons> PrintObject::slice_volume(const std::vector<float> &z, S
 	        // TriangleMeshSlicer needs the shared vertices.
 	        mesh.require_shared_vertices();
 	        mslicer.init(&mesh, callback);
+	        mslicer.set_deterministic(print->execution_policy().deterministic);
 	        mslicer.slice(z, mode, float(m_config.slice_closing_radius.value), &layers, callback);
 	        m_print->throw_if_canceled();
 	    }
@@ -2227,14 +2602,17 @@ std::string PrintObject::_fix_slicing_errors()
 {
     // Collect layers with slicing errors.
     // These layers will be fixed in parallel.
+    // Only the layers just sliced are repaired, the layers reused from the last slicing pass have been repaired already.
+    auto [layer_begin, layer_end] = this->layers_to_process();
     std::vector<size_t> buggy_layers;
-    buggy_layers.reserve(m_layers.size());
-    for (size_t idx_layer = 0; idx_layer < m_layers.size(); ++ idx_layer)
+    buggy_layers.reserve(layer_end - layer_begin);
+    for (size_t idx_layer = layer_begin; idx_layer < layer_end; ++ idx_layer)
         if (m_layers[idx_layer]->slicing_errors)
             buggy_layers.push_back(idx_layer);
 
     BOOST_LOG_TRIVIAL(debug) << "Slicing objects - fixing slicing errors in parallel - begin";
-    tbb::parallel_for(
+    execution::parallel_for(
+        this->print()->execution_policy(),
         tbb::blocked_range<size_t>(0, buggy_layers.size()),
         [this, &buggy_layers](const tbb::blocked_range<size_t>& range) {
             for (size_t buggy_layer_idx = range.begin(); buggy_layer_idx < range.end(); ++ buggy_layer_idx) {
@@ -2312,8 +2690,11 @@ std::string PrintObject::_fix_slicing_errors()
 void PrintObject::simplify_slices(double distance)
 {
     BOOST_LOG_TRIVIAL(debug) << "Slicing objects - siplifying slices in parallel - begin";
-    tbb::parallel_for(
-        tbb::blocked_range<size_t>(0, m_layers.size()),
+    // The layers reused from the last slicing pass have been simplified already.
+    auto [layer_begin, layer_end] = this->layers_to_process();
+    execution::parallel_for(
+        this->print()->execution_policy(),
+        tbb::blocked_range<size_t>(layer_begin, layer_end),
         [this, distance](const tbb::blocked_range<size_t>& range) {
             for (size_t layer_idx = range.begin(); layer_idx < range.end(); ++ layer_idx) {
                 m_print->throw_if_canceled();
@@ -2420,15 +2801,25 @@ void PrintObject::clip_fill_surfaces()
 void PrintObject::discover_horizontal_shells()
 {
     BOOST_LOG_TRIVIAL(trace) << "discover_horizontal_shells()";
+
+    // Layers to be processed, all of them unless just the layers around a layer height change were resliced.
+    // Then the shells are scattered into these layers from them and from their neighbors up to the shell thickness.
+    auto [layer_begin, layer_end] = this->layers_to_process();
     
     for (size_t region_id = 0; region_id < this->region_volumes.size(); ++ region_id) {
-        for (size_t i = 0; i < m_layers.size(); ++ i) {
+        std::pair<size_t, size_t> scatter_range(layer_begin, layer_end);
+        if (layer_begin > 0 || layer_end < m_layers.size()) {
+            const PrintRegionConfig &config = m_print->get_region(region_id)->config();
+            scatter_range = extend_layer_range(m_layers, scatter_range, size_t(std::max(config.top_solid_layers.value, config.bottom_solid_layers.value)),
+                std::max(config.top_solid_min_thickness.value, config.bottom_solid_min_thickness.value));
+        }
+        for (size_t i = scatter_range.first; i < scatter_range.second; ++ i) {
             m_print->throw_if_canceled();
             Layer 					*layer  = m_layers[i];
             LayerRegion             *layerm = layer->regions()[region_id];
             const PrintRegionConfig &region_config = layerm->region()->config();
             if (region_config.solid_infill_every_layers.value > 0 && region_config.fill_density.value > 0 &&
-                (i % region_config.solid_infill_every_layers) == 0) {
+                (i % region_config.solid_infill_every_layers) == 0 && i >= layer_begin && i < layer_end) {
                 // Insert a solid internal layer. Mark stInternal surfaces as stInternalSolid or stInternalBridge.
                 SurfaceType type = (region_config.fill_density == 100) ? stInternalSolid : stInternalBridge;
                 for (Surface &surface : layerm->fill_surfaces.surfaces)
@@ -2574,6 +2965,10 @@ void PrintObject::discover_horizontal_shells()
                         }
                     }
                     
+                    if (n < int(layer_begin) || n >= int(layer_end))
+                        // The layers not processed have received their shells already.
+                        continue;
+
                     // internal-solid are the union of the existing internal-solid surfaces
                     // and new ones
                     SurfaceCollection backup = std::move(neighbor_layerm->fill_surfaces);
@@ -2778,7 +3173,8 @@ void PrintObject::project_and_append_custom_facets(
         std::vector<TriangleProjections> projections_of_triangles(custom_facets.indices.size());
 
         // Iterate over all triangles.
-        tbb::parallel_for(
+        execution::parallel_for(
+            this->print()->execution_policy(),
             tbb::blocked_range<size_t>(0, custom_facets.indices.size()),
             [&](const tbb::blocked_range<size_t>& range) {
             for (size_t idx = range.begin(); idx < range.end(); ++ idx) {
@@ -3,13 +3,12 @@
 
 #include <tbb/spin_mutex.h>
 #include <tbb/mutex.h>
-#include <tbb/parallel_for.h>
-#include <tbb/parallel_reduce.h>
 
 #include <algorithm>
 #include <numeric>
 
 #include <libslic3r/libslic3r.h>
+#include <libslic3r/Execution.hpp>
 
 namespace Slic3r {
 namespace sla {
@@ -25,25 +24,13 @@ template<> struct _ccr<true>
     using SpinningMutex = tbb::spin_mutex;
     using BlockingMutex = tbb::mutex;
 
-    template<class Fn, class It>
-    static IteratorOnly<It, void> loop_(const tbb::blocked_range<It> &range, Fn &&fn)
-    {
-        for (auto &el : range) fn(el);
-    }
-
-    template<class Fn, class I>
-    static IntegerOnly<I, void> loop_(const tbb::blocked_range<I> &range, Fn &&fn)
-    {
-        for (I i = range.begin(); i < range.end(); ++i) fn(i);
-    }
-
+    // The parallel loops are executed by the libslic3r wide execution
+    // backend with the process wide execution policy.
     template<class It, class Fn>
     static void for_each(It from, It to, Fn &&fn, size_t granularity = 1)
     {
-        tbb::parallel_for(tbb::blocked_range{from, to, granularity},
-                          [&fn, from](const auto &range) {
-            loop_(range, std::forward<Fn>(fn));
-        });
+        execution::for_each(default_execution_policy(), from, to,
+                            std::forward<Fn>(fn), granularity);
     }
 
     template<class I, class MergeFn, class T, class AccessFn>
@@ -55,14 +42,9 @@ template<> struct _ccr<true>
                     size_t     granularity = 1
                     )
     {
-        return tbb::parallel_reduce(
-            tbb::blocked_range{from, to, granularity}, init,
-            [&](const auto &range, T subinit) {
-                T acc = subinit;
-                loop_(range, [&](auto &i) { acc = mergefn(acc, access(i)); });
-                return acc;
-            },
-            std::forward<MergeFn>(mergefn));
+        return execution::reduce(default_execution_policy(), from, to, init,
+                                 std::forward<MergeFn>(mergefn),
+                                 std::forward<AccessFn>(access), granularity);
     }
 
     template<class I, class MergeFn, class T>
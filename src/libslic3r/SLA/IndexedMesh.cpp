@@ -41,6 +41,17 @@ public:
                                                  s, dir, hits);
     }
 
+    template<size_t N>
+    void intersect_ray_packet(const TriangleMesh& tm,
+                              const std::array<Vec3d, N>& s, const std::array<Vec3d, N>& dir,
+                              std::array<igl::Hit, N>& hits)
+    {
+        AABBTreeIndirect::intersect_ray_packet_first_hits(tm.its.vertices,
+                                                          tm.its.indices,
+                                                          m_tree,
+                                                          s, dir, hits);
+    }
+
     double squared_distance(const TriangleMesh& tm,
                             const Vec3d& point, int& i, Eigen::Matrix<double, 1, 3>& closest) {
         size_t idx_unsigned = 0;
@@ -137,6 +148,47 @@ IndexedMesh::query_ray_hit(const Vec3d &s, const Vec3d &dir) const
 #endif
 
     m_aabb->intersect_ray(*m_tm, s, dir, hit);
+    return to_hit_result(hit, s, dir);
+}
+
+void IndexedMesh::query_ray_hit(const Vec3d *s, const Vec3d *dir, size_t n, hit_result *out) const
+{
+#ifdef SLIC3R_HOLE_RAYCASTER
+    if (! m_holes.empty()) {
+        for (size_t i = 0; i < n; ++i)
+            out[i] = query_ray_hit(s[i], dir[i]);
+
+        return;
+    }
+#endif
+
+    // Rays are cast in packets of fixed size, the last packet is padded by
+    // repeating its last ray.
+    static const constexpr size_t PACKET_SIZE = 8;
+
+    std::array<Vec3d, PACKET_SIZE>    ps, pdirs;
+    std::array<igl::Hit, PACKET_SIZE> hits;
+
+    for (size_t from = 0; from < n; from += PACKET_SIZE) {
+        size_t cnt = std::min(PACKET_SIZE, n - from);
+        for (size_t i = 0; i < PACKET_SIZE; ++i) {
+            size_t ri = from + std::min(i, cnt - 1);
+            assert(is_approx(dir[ri].norm(), 1.));
+            ps[i]    = s[ri];
+            pdirs[i] = dir[ri];
+        }
+
+        m_aabb->intersect_ray_packet(*m_tm, ps, pdirs, hits);
+
+        for (size_t i = 0; i < cnt; ++i)
+            out[from + i] = to_hit_result(hits[i], ps[i], pdirs[i]);
+    }
+}
+
+IndexedMesh::hit_result IndexedMesh::to_hit_result(const igl::Hit &hit,
+                                                   const Vec3d &   s,
+                                                   const Vec3d &   dir) const
+{
     hit_result ret(*this);
     ret.m_t = double(hit.t);
     ret.m_dir = dir;
@@ -1,6 +1,7 @@
 #ifndef SLA_INDEXEDMESH_H
 #define SLA_INDEXEDMESH_H
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -15,6 +16,8 @@
   #include "libslic3r/SLA/Hollowing.hpp"
 #endif
 
+namespace igl { struct Hit; }
+
 namespace Slic3r {
 
 class TriangleMesh;
@@ -120,6 +123,21 @@ public:
     // Casts a ray on the mesh and returns all hits
     std::vector<hit_result> query_ray_hits(const Vec3d &s, const Vec3d &dir) const;
 
+    // Casting a packet of rays on the mesh. The rays are traversed through
+    // the acceleration tree together, which is faster than casting them one
+    // by one if the rays are coherent, e.g. sampled around a support head.
+    // Returns the same hits as query_ray_hit would for each ray.
+    void query_ray_hit(const Vec3d *s, const Vec3d *dir, size_t n, hit_result *out) const;
+
+    template<size_t N>
+    std::array<hit_result, N> query_ray_hit(const std::array<Vec3d, N> &s,
+                                            const std::array<Vec3d, N> &dir) const
+    {
+        std::array<hit_result, N> ret;
+        query_ray_hit(s.data(), dir.data(), N, ret.data());
+        return ret;
+    }
+
     double squared_distance(const Vec3d& p, int& i, Vec3d& c) const;
     inline double squared_distance(const Vec3d &p) const
     {
@@ -131,6 +149,9 @@ public:
     Vec3d normal_by_face_id(int face_id) const;
 
     const TriangleMesh * get_triangle_mesh() const { return m_tm; }
+
+private:
+    hit_result to_hit_result(const igl::Hit &hit, const Vec3d &s, const Vec3d &dir) const;
 };
 
 // Calculate the normals for the selected points (from 'points' set) on the
@@ -3,15 +3,15 @@
 #include <libslic3r/SLA/Rotfinder.hpp>
 #include <libslic3r/SLA/Concurrency.hpp>
 
-#include <libslic3r/Optimize/BruteforceOptimizer.hpp>
-
 #include "libslic3r/SLAPrint.hpp"
 #include "libslic3r/PrintConfig.hpp"
 
 #include <libslic3r/Geometry.hpp>
 #include "Model.hpp"
 
+#include <atomic>
 #include <thread>
+#include <unordered_map>
 
 namespace Slic3r { namespace sla {
 
@@ -72,26 +72,104 @@ struct Facestats {
         normal = C.normalized();
         area = 0.5 * C.norm();
     }
+
+    Facestats(const Vec3d &n, double a) : normal{n}, area{a} {}
 };
 
 inline const Vec3d DOWN = {0., 0., -1.};
 constexpr double POINTS_PER_UNIT_AREA = 1.;
 
-// The score function for a particular face
-inline double get_score(const Facestats &fc)
+// The score of a unit area with the given angle between its normal and the
+// DOWN vector. Monotonically decreasing with the angle.
+inline double get_score_of_angle(double angle)
 {
-    // Simply get the angle (acos of dot product) between the face normal and
-    // the DOWN vector.
-    double phi = 1. - std::acos(fc.normal.dot(DOWN)) / PI;
+    double phi = 1. - angle / PI;
 
     // Only consider faces that have have slopes below 90 deg:
     phi = phi * (phi > 0.5);
 
     // Make the huge slopes more significant than the smaller slopes
-    phi = phi * phi * phi;
+    return phi * phi * phi;
+}
+
+// The score function for a particular face
+inline double get_score(const Facestats &fc)
+{
+    // Simply get the angle (acos of dot product) between the face normal and
+    // the DOWN vector.
+    double angle = std::acos(std::clamp(fc.normal.dot(DOWN), -1., 1.));
 
     // Multiply with the area of the current face
-    return fc.area * POINTS_PER_UNIT_AREA * phi;
+    return fc.area * POINTS_PER_UNIT_AREA * get_score_of_angle(angle);
+}
+
+// Normals and areas of the untransformed mesh faces. A rotation preserves the
+// face areas and rotates the normals, thus the statistics of a rotated mesh
+// are cheaply derived from these without transforming the vertices.
+std::vector<Facestats> get_facestats(const TriangleMesh &mesh)
+{
+    size_t facecount = mesh.its.indices.size();
+    auto   ret       = reserve_vector<Facestats>(facecount);
+    for (size_t fi = 0; fi < facecount; ++fi)
+        ret.emplace_back(get_triangle_vertices(mesh, fi));
+
+    return ret;
+}
+
+// Faces with similar normals merged into clusters. A cluster stores the sum
+// of the face areas, the area weighted average normal and the maximum angle
+// between the average normal and the normals of its faces.
+struct NormalCluster {
+    Vec3d  normal;
+    double area;
+    double max_angle;
+};
+
+std::vector<NormalCluster> cluster_facestats(const std::vector<Facestats> &stats)
+{
+    // Grid step for the normal vector components.
+    constexpr double Step = 0.1;
+
+    struct Key {
+        std::array<int, 3> v;
+        bool operator==(const Key &k) const { return v == k.v; }
+    };
+    struct KeyHash {
+        size_t operator()(const Key &k) const
+        {
+            return std::hash<int>()(k.v[0]) ^ (std::hash<int>()(k.v[1]) << 10) ^ (std::hash<int>()(k.v[2]) << 20);
+        }
+    };
+
+    std::unordered_map<Key, size_t, KeyHash> cluster_map;
+    std::vector<NormalCluster> clusters;
+    std::vector<size_t>        face_cluster(stats.size());
+
+    for (size_t fi = 0; fi < stats.size(); ++fi) {
+        const Facestats &fc = stats[fi];
+        Key key{{int(std::floor(fc.normal.x() / Step)),
+                 int(std::floor(fc.normal.y() / Step)),
+                 int(std::floor(fc.normal.z() / Step))}};
+        auto [it, inserted] = cluster_map.insert({key, clusters.size()});
+        if (inserted)
+            clusters.push_back({Vec3d::Zero(), 0., 0.});
+
+        NormalCluster &cl = clusters[it->second];
+        cl.normal += fc.area * fc.normal;
+        cl.area   += fc.area;
+        face_cluster[fi] = it->second;
+    }
+
+    for (NormalCluster &cl : clusters)
+        cl.normal.normalize();
+
+    for (size_t fi = 0; fi < stats.size(); ++fi) {
+        NormalCluster &cl = clusters[face_cluster[fi]];
+        double angle = std::acos(std::clamp(cl.normal.dot(stats[fi].normal), -1., 1.));
+        cl.max_angle = std::max(cl.max_angle, angle);
+    }
+
+    return clusters;
 }
 
 template<class AccessFn>
@@ -120,6 +198,73 @@ double get_model_supportedness(const TriangleMesh &mesh, const Transform3d &tr)
     return sum_score(accessfn, facecount, Nthreads) / facecount;
 }
 
+// The same as get_model_supportedness(), but using the precomputed face
+// statistics. The transformation is expected to be a pure rotation.
+double get_model_supportedness(const std::vector<Facestats> &stats, const Transform3d &tr)
+{
+    if (stats.empty()) return std::nan("");
+
+    Matrix3d rot = tr.linear();
+    auto accessfn = [&stats, &rot](size_t fi) {
+        return get_score(Facestats{rot * stats[fi].normal, stats[fi].area});
+    };
+
+    size_t facecount = stats.size();
+    size_t Nthreads  = std::thread::hardware_concurrency();
+    return sum_score(accessfn, facecount, Nthreads) / facecount;
+}
+
+// Lower and upper bound of get_model_supportedness(stats, tr) calculated from
+// the normal clusters of the face statistics. The score of a face decreases
+// monotonically with the angle between its normal and the DOWN vector, thus
+// the score of each face of a cluster is bounded by the scores of the
+// cluster's normal angle decreased and increased by the cluster's max_angle.
+std::pair<double, double> get_model_supportedness_bounds(const std::vector<NormalCluster> &clusters,
+                                                         size_t                            facecount,
+                                                         const Transform3d &               tr)
+{
+    Matrix3d rot = tr.linear();
+    double lower = 0., upper = 0.;
+    for (const NormalCluster &cl : clusters) {
+        double angle = std::acos(std::clamp((rot * cl.normal).dot(DOWN), -1., 1.));
+        lower += cl.area * get_score_of_angle(std::min(PI, angle + cl.max_angle));
+        upper += cl.area * get_score_of_angle(std::max(0., angle - cl.max_angle));
+    }
+
+    return {POINTS_PER_UNIT_AREA * lower / facecount, POINTS_PER_UNIT_AREA * upper / facecount};
+}
+
+// The same as get_model_supportedness_onfloor(), but using the precomputed
+// face statistics. The transformation is expected to be a pure rotation.
+double get_model_supportedness_onfloor(const TriangleMesh &            mesh,
+                                       const std::vector<Facestats> &stats,
+                                       const Transform3d &             tr)
+{
+    if (stats.empty()) return std::nan("");
+
+    size_t Nthreads = std::thread::hardware_concurrency();
+
+    double zmin = find_ground_level(mesh, tr, Nthreads);
+    double zlvl = zmin + 0.1; // Set up a slight tolerance from z level
+
+    Matrix3d rot  = tr.linear();
+    Vec3d    zrow = rot.row(2).transpose();
+    double   zoff = tr.translation().z();
+
+    auto accessfn = [&mesh, &stats, &rot, &zrow, zoff, zlvl](size_t fi) {
+        const auto &face = mesh.its.indices[fi];
+        auto z = [&](int i) { return zrow.dot(mesh.its.vertices[face(i)].cast<double>()) + zoff; };
+
+        if (z(0) <= zlvl && z(1) <= zlvl && z(2) <= zlvl)
+            return -stats[fi].area * POINTS_PER_UNIT_AREA;
+
+        return get_score(Facestats{rot * stats[fi].normal, stats[fi].area});
+    };
+
+    size_t facecount = stats.size();
+    return sum_score(accessfn, facecount, Nthreads) / facecount;
+}
+
 double get_model_supportedness_onfloor(const TriangleMesh &mesh,
                                        const Transform3d & tr)
 {
@@ -177,7 +322,7 @@ std::array<double, N> find_min_score(Fn &&fn, It from, It to, StopCond &&stopfn)
         if (stopfn()) return;
 
         scores[i] = fn(*(from + i));
-    }, dist / Nthreads);
+    }, std::max(dist / Nthreads, size_t(1)));
 
     auto it = std::min_element(scores.begin(), scores.end());
 
@@ -238,13 +383,72 @@ std::vector<XYRotation> get_chull_rotations(const TriangleMesh &mesh, size_t max
     return ret;
 }
 
+static const unsigned MAX_TRIES = 1000;
+
+// The search of the best rotation of an object elevated on supports.
+// max_tries is updated to the number of the candidates evaluated.
+template<class StatusFn, class StopCond>
+XYRotation find_best_rotation_elevated(const std::vector<Facestats> &stats,
+                                       unsigned &                    max_tries,
+                                       bool                          prune_candidates,
+                                       StatusFn &&                   statusfn,
+                                       StopCond &&                   stopcond)
+{
+    // We are searching rotations around only two axes x, y on an
+    // equidistant grid of the [-PI, PI] intervals, 2D grid has gridsize^2
+    // candidates. The candidates are ordered the same way as the brute
+    // force optimizer visits them, so that the first of equally good
+    // rotations is returned.
+    size_t gridsize = std::max(size_t(std::sqrt(max_tries)), size_t(2));
+    double step     = 2. * PI / (gridsize - 1);
+    auto   inputs   = reserve_vector<XYRotation>(gridsize * gridsize);
+    for (size_t iy = 0; iy < gridsize; ++iy)
+        for (size_t ix = 0; ix < gridsize; ++ix)
+            inputs.push_back({-PI + ix * step, -PI + iy * step});
+
+    // Prune the candidates by the bounds of their score calculated on
+    // faces clustered by their normals. A candidate is thrown away if
+    // its lower bound is worse than the best upper bound, thus it cannot
+    // be the best one. Only worth it if the clusters are considerably
+    // fewer than the faces.
+    std::vector<NormalCluster> clusters;
+    if (prune_candidates)
+        clusters = cluster_facestats(stats);
+    if (prune_candidates && clusters.size() * 4 < stats.size()) {
+        std::vector<std::pair<double, double>> bounds(inputs.size());
+        ccr_par::for_each(size_t(0), inputs.size(), [&](size_t i) {
+            bounds[i] = get_model_supportedness_bounds(clusters, stats.size(), to_transform3d(inputs[i]));
+        });
+
+        double best_upper = std::numeric_limits<double>::max();
+        for (const std::pair<double, double> &b : bounds)
+            best_upper = std::min(best_upper, b.second);
+
+        // Slight tolerance for the rounding errors of the bounds.
+        best_upper += EPSILON * (std::abs(best_upper) + 1.);
+
+        size_t cnt = 0;
+        for (size_t i = 0; i < inputs.size(); ++i)
+            if (bounds[i].first <= best_upper)
+                inputs[cnt++] = inputs[i];
+        inputs.erase(inputs.begin() + cnt, inputs.end());
+    }
+
+    max_tries = inputs.size();
+
+    auto objfn = [&stats, &statusfn](const XYRotation &rot) {
+        statusfn();
+        return get_model_supportedness(stats, to_transform3d(rot));
+    };
+
+    return find_min_score<2>(objfn, inputs.begin(), inputs.end(), stopcond);
+}
+
 Vec2d find_best_rotation(const SLAPrintObject &        po,
                          float                         accuracy,
                          std::function<void(unsigned)> statuscb,
                          std::function<bool()>         stopcond)
 {
-    static const unsigned MAX_TRIES = 1000;
-
     // return value
     XYRotation rot;
 
@@ -253,15 +457,21 @@ Vec2d find_best_rotation(const SLAPrintObject &        po,
     TriangleMesh mesh = po.model_object()->raw_mesh();
     mesh.require_shared_vertices();
 
+    // The face normals and areas are invariant to the transformation, except
+    // for the rotation of the normals. Compute them only once.
+    std::vector<Facestats> stats = get_facestats(mesh);
+
     // To keep track of the number of iterations
-    unsigned status = 0;
+    std::atomic<unsigned> status{0};
 
     // The maximum number of iterations
     auto max_tries = unsigned(accuracy * MAX_TRIES);
 
     // call status callback with zero, because we are at the start
-    statuscb(status);
+    statuscb(0);
 
+    // The candidates are evaluated in parallel, thus the status is reported
+    // from the worker threads.
     auto statusfn = [&statuscb, &status, &max_tries] {
         // report status
         statuscb(unsigned(++status * 100.0/max_tries) );
@@ -276,40 +486,39 @@ Vec2d find_best_rotation(const SLAPrintObject &        po,
         // If the model can be placed on the bed directly, we only need to
         // check the 3D convex hull face rotations.
 
-        auto objfn = [&mesh, &statusfn](const XYRotation &rot) {
+        auto objfn = [&mesh, &stats, &statusfn](const XYRotation &rot) {
             statusfn();
             Transform3d tr = to_transform3d(rot);
-            return get_model_supportedness_onfloor(mesh, tr);
+            return get_model_supportedness_onfloor(mesh, stats, tr);
         };
 
         rot = find_min_score<2>(objfn, inputs.begin(), inputs.end(), stopcond);
     } else {
-        // Preparing the optimizer.
-        size_t gridsize = std::sqrt(max_tries); // 2D grid has gridsize^2 calls
-        opt::Optimizer<opt::AlgBruteForce> solver(opt::StopCriteria{}
-                                                    .max_iterations(max_tries)
-                                                    .stop_condition(stopcond),
-                                                  gridsize);
-
-        // We are searching rotations around only two axes x, y. Thus the
-        // problem becomes a 2 dimensional optimization task.
-        // We can specify the bounds for a dimension in the following way:
-        auto bounds = opt::bounds({ {-PI, PI}, {-PI, PI} });
-
-        auto result = solver.to_min().optimize(
-            [&mesh, &statusfn] (const XYRotation &rot)
-            {
-                statusfn();
-                return get_model_supportedness(mesh, to_transform3d(rot));
-            }, opt::initvals({0., 0.}), bounds);
-
-        // Save the result and fck off
-        rot = result.optimum;
+        rot = find_best_rotation_elevated(stats, max_tries, true, statusfn, stopcond);
     }
 
     return {rot[0], rot[1]};
 }
 
+Vec2d find_best_rotation_elevated(const TriangleMesh &          mesh,
+                                  float                         accuracy,
+                                  bool                          prune_candidates,
+                                  std::function<void(unsigned)> statuscb,
+                                  std::function<bool()>         stopcond)
+{
+    std::atomic<unsigned> status{0};
+    auto max_tries = unsigned(accuracy * MAX_TRIES);
+
+    statuscb(0);
+    auto statusfn = [&statuscb, &status, &max_tries] {
+        statuscb(unsigned(++status * 100.0/max_tries) );
+    };
+
+    XYRotation rot = find_best_rotation_elevated(get_facestats(mesh), max_tries, prune_candidates, statusfn, stopcond);
+
+    return {rot[0], rot[1]};
+}
+
 double get_model_supportedness(const SLAPrintObject &po, const Transform3d &tr)
 {
     TriangleMesh mesh = po.model_object()->raw_mesh();
@@ -9,6 +9,7 @@
 namespace Slic3r {
 
 class SLAPrintObject;
+class TriangleMesh;
 
 namespace sla {
 
@@ -34,6 +35,23 @@ Vec2d find_best_rotation(
         std::function<bool()> stopcond = [] () { return false; }
         );
 
+/**
+  * The rotation search of find_best_rotation() for an object elevated on
+  * supports, working on the mesh directly. The mesh is expected to have its
+  * vertices shared.
+  *
+  * @param prune_candidates If true, the rotation candidates which cannot be
+  * the best one judging by the bounds of their score are not evaluated.
+  * The result is the same either way.
+  */
+Vec2d find_best_rotation_elevated(
+        const TriangleMesh& mesh,
+        float accuracy = 1.0f,
+        bool prune_candidates = true,
+        std::function<void(unsigned)> statuscb = [] (unsigned) {},
+        std::function<bool()> stopcond = [] () { return false; }
+        );
+
 double get_model_supportedness(const SLAPrintObject &mesh,
                                const Transform3d & tr);
 
@@ -583,18 +583,54 @@ void SupportPointGenerator::uniformly_cover(const ExPolygons& islands, Structure
 
     //FIXME share the random generator. The random generator may be not so cheap to initialize, also we don't want the random generator to be restarted for each polygon.
 
-    std::vector<Vec2f> raw_samples =
-        flags & icfWithBoundary ?
-            sample_expolygon_with_boundary(islands, samples_per_mm2,
-                                           5.f / poisson_radius, m_rng) :
-            sample_expolygon(islands, samples_per_mm2, m_rng);
-
-    std::vector<Vec2f>  poisson_samples;
-    for (size_t iter = 0; iter < 4; ++ iter) {
-        poisson_samples = poisson_disk_from_samples(raw_samples, poisson_radius,
+    auto poisson_disk = [&structure, &grid3d](const std::vector<Vec2f> &raw_samples, float poisson_radius, float min_spacing) {
+        return poisson_disk_from_samples(raw_samples, poisson_radius,
             [&structure, &grid3d, min_spacing](const Vec2f &pos) {
                 return grid3d.collides_with(pos, structure.layer->print_z, min_spacing);
             });
+    };
+
+    std::vector<Vec2f>  raw_samples;
+    std::vector<Vec2f>  poisson_samples;
+    bool                covered = false;
+    if (m_config.adaptive_sampling && ! (flags & icfWithBoundary)) {
+        // Multi-resolution sampling of the flat islands: The dense sampling produces the maximum Poisson disk set,
+        // which is then mostly thrown away if the island is large and only a few points are to be placed.
+        // Sample the island with a density sufficient for the target number of points first,
+        // refine to the dense sampling only if the coarse sampling does not produce enough points.
+        // The slopes (sampled with their boundary) are always sampled densely, as their shape matters.
+        // The coarse density is weighted by the curvature of the island outlines, estimated by the isoperimetric ratio
+        // (1 for a disc, growing with the wiggliness of the outline and with narrow arms), which the coarse samples would miss.
+        double islands_area = 0.;
+        double islands_perimeter = 0.;
+        for (const ExPolygon &island : islands) {
+            islands_area += island.area();
+            islands_perimeter += island.contour.length();
+            for (const Polygon &hole : island.holes)
+                islands_perimeter += hole.length();
+        }
+        islands_area      *= SCALING_FACTOR * SCALING_FACTOR;
+        islands_perimeter *= SCALING_FACTOR;
+        const double curvature_weight = islands_area > EPSILON ? std::max(1., sqr(islands_perimeter) / (4. * M_PI * islands_area)) : 1.;
+        const float samples_per_mm2_coarse = islands_area > EPSILON ?
+            float(4. * curvature_weight * double(poisson_samples_target) / islands_area) : samples_per_mm2;
+        if (samples_per_mm2_coarse < 0.5f * samples_per_mm2) {
+            raw_samples     = sample_expolygon(islands, samples_per_mm2_coarse, m_rng);
+            poisson_samples = poisson_disk(raw_samples, poisson_radius, min_spacing);
+            covered         = poisson_samples.size() >= poisson_samples_target;
+        }
+    }
+
+    if (! covered) {
+        raw_samples =
+            flags & icfWithBoundary ?
+                sample_expolygon_with_boundary(islands, samples_per_mm2,
+                                               5.f / poisson_radius, m_rng) :
+                sample_expolygon(islands, samples_per_mm2, m_rng);
+    }
+
+    for (size_t iter = 0; ! covered && iter < 4; ++ iter) {
+        poisson_samples = poisson_disk(raw_samples, poisson_radius, min_spacing);
         if (poisson_samples.size() >= poisson_samples_target || m_config.minimal_distance > poisson_radius-EPSILON)
             break;
         float coeff = 0.5f;
@@ -22,6 +22,9 @@ public:
         float density_relative {1.f};
         float minimal_distance {1.f};
         float head_diameter {0.4f};
+        // Sample the large islands with a density derived from the number of support points to be placed
+        // and from the curvature of the island outlines instead of the fixed dense sampling. The dense sampling is still used for the slopes and as a fallback.
+        bool  adaptive_sampling {true};
 
         // Originally calibrated to 7.7f, reduced density by Tamas to 70% which is 11.1 (7.7 / 0.7) to adjust for new algorithm changes in tm_suppt_gen_improve
         inline float support_force() const { return 11.1f / density_relative; } // a force one point can support       (arbitrary force unit)
@@ -207,51 +207,65 @@ IndexedMesh::hit_result SupportTreeBuildsteps::pinhead_mesh_intersect(
 
     // We will shoot multiple rays from the head pinpoint in the direction
     // of the pinhead robe (side) surface. The result will be the smallest
-    // hit distance.
-
-    ccr::for_each(size_t(0), hits.size(),
-                  [&m, &rings, sd, &hits](size_t i) {
-
-       // Point on the circle on the pin sphere
-       Vec3d ps = rings.pinring(i);
-       // This is the point on the circle on the back sphere
-       Vec3d p = rings.backring(i);
-
-       auto &hit = hits[i];
-
-       // Point ps is not on mesh but can be inside or
-       // outside as well. This would cause many problems
-       // with ray-casting. To detect the position we will
-       // use the ray-casting result (which has an is_inside
-       // predicate).
-
-       Vec3d n = (p - ps).normalized();
-       auto  q = m.query_ray_hit(ps + sd * n, n);
-
-       if (q.is_inside()) { // the hit is inside the model
-           if (q.distance() > rings.rpin) {
-               // If we are inside the model and the hit
-               // distance is bigger than our pin circle
-               // diameter, it probably indicates that the
-               // support point was already inside the
-               // model, or there is really no space
-               // around the point. We will assign a zero
-               // hit distance to these cases which will
-               // enforce the function return value to be
-               // an invalid ray with zero hit distance.
-               // (see min_element at the end)
-               hit = HitResult(0.0);
-           } else {
-               // re-cast the ray from the outside of the
-               // object. The starting point has an offset
-               // of 2*safety_distance because the
-               // original ray has also had an offset
-               auto q2 = m.query_ray_hit(ps + (q.distance() + 2 * sd) * n, n);
-               hit = q2;
-           }
-       } else
-           hit = q;
-    });
+    // hit distance. The rays are close to each other, so they are cast
+    // together as a packet.
+
+    std::array<Vec3d, SAMPLES> pins, srcs, dirs;
+    for (size_t i = 0; i < SAMPLES; ++i) {
+        // Point on the circle on the pin sphere
+        pins[i] = rings.pinring(i);
+        // This is the point on the circle on the back sphere
+        Vec3d p = rings.backring(i);
+
+        // Point ps is not on mesh but can be inside or
+        // outside as well. This would cause many problems
+        // with ray-casting. To detect the position we will
+        // use the ray-casting result (which has an is_inside
+        // predicate).
+        dirs[i] = (p - pins[i]).normalized();
+        srcs[i] = pins[i] + sd * dirs[i];
+    }
+
+    hits = m.query_ray_hit(srcs, dirs);
+
+    // Rays to be re-cast from the outside of the object
+    std::array<Vec3d, SAMPLES> resrcs, redirs;
+    std::array<size_t, SAMPLES> reidx;
+    size_t recount = 0;
+
+    for (size_t i = 0; i < SAMPLES; ++i) {
+        auto &hit = hits[i];
+
+        if (hit.is_inside()) { // the hit is inside the model
+            if (hit.distance() > rings.rpin) {
+                // If we are inside the model and the hit
+                // distance is bigger than our pin circle
+                // diameter, it probably indicates that the
+                // support point was already inside the
+                // model, or there is really no space
+                // around the point. We will assign a zero
+                // hit distance to these cases which will
+                // enforce the function return value to be
+                // an invalid ray with zero hit distance.
+                // (see min_element at the end)
+                hit = HitResult(0.0);
+            } else {
+                // re-cast the ray from the outside of the
+                // object. The starting point has an offset
+                // of 2*safety_distance because the
+                // original ray has also had an offset
+                resrcs[recount] = pins[i] + (hit.distance() + 2 * sd) * dirs[i];
+                redirs[recount] = dirs[i];
+                reidx[recount++] = i;
+            }
+        }
+    }
+
+    if (recount > 0) {
+        std::array<HitResult, SAMPLES> rehits;
+        m.query_ray_hit(resrcs.data(), redirs.data(), recount, rehits.data());
+        for (size_t k = 0; k < recount; ++k) hits[reidx[k]] = rehits[k];
+    }
 
     return min_hit(hits);
 }
@@ -267,24 +281,40 @@ IndexedMesh::hit_result SupportTreeBuildsteps::bridge_mesh_intersect(
     // Hit results
     std::array<Hit, SAMPLES> hits;
 
-    ccr::for_each(size_t(0), hits.size(),
-                 [this, r, src, /*ins_check,*/ &ring, dir, sd, &hits] (size_t i)
-    {
-        Hit &hit = hits[i];
-
+    // The rays are parallel, so they are cast together as a packet.
+    std::array<Vec3d, SAMPLES> pts, srcs, dirs;
+    for (size_t i = 0; i < SAMPLES; ++i) {
         // Point on the circle on the pin sphere
-        Vec3d p = ring.get(i, src, r + sd);
+        pts[i]  = ring.get(i, src, r + sd);
+        srcs[i] = pts[i] + r * dir;
+        dirs[i] = dir;
+    }
 
-        auto hr = m_mesh.query_ray_hit(p + r * dir, dir);
+    hits = m_mesh.query_ray_hit(srcs, dirs);
+
+    // Rays to be re-cast from the outside of the object
+    std::array<Vec3d, SAMPLES> resrcs;
+    std::array<size_t, SAMPLES> reidx;
+    size_t recount = 0;
+
+    for (size_t i = 0; i < SAMPLES; ++i) {
+        Hit &hit = hits[i];
 
-        if(/*ins_check && */hr.is_inside()) {
-            if(hr.distance() > 2 * r + sd) hit = Hit(0.0);
+        if(/*ins_check && */hit.is_inside()) {
+            if(hit.distance() > 2 * r + sd) hit = Hit(0.0);
             else {
                 // re-cast the ray from the outside of the object
-                hit = m_mesh.query_ray_hit(p + (hr.distance() + EPSILON) * dir, dir);
+                resrcs[recount] = pts[i] + (hit.distance() + EPSILON) * dir;
+                reidx[recount++] = i;
             }
-        } else hit = hr;
-    });
+        }
+    }
+
+    if (recount > 0) {
+        std::array<Hit, SAMPLES> rehits;
+        m_mesh.query_ray_hit(resrcs.data(), dirs.data(), recount, rehits.data());
+        for (size_t k = 0; k < recount; ++k) hits[reidx[k]] = rehits[k];
+    }
 
     return min_hit(hits);
 }
@@ -6,10 +6,13 @@
 #include "MTUtils.hpp"
 #include "Thread.hpp"
 
+#include <atomic>
+#include <exception>
 #include <unordered_set>
 #include <numeric>
 
 #include <tbb/parallel_for.h>
+#include <tbb/task_group.h>
 #include <boost/filesystem/path.hpp>
 #include <boost/log/trivial.hpp>
 
@@ -715,50 +718,95 @@ void SLAPrint::process()
     SLAPrintStep print_steps[] = { slapsMergeSlicesAndEval, slapsRasterize };
     
     double st = Steps::min_objstatus;
+    m_report_status.reset();
 
     BOOST_LOG_TRIVIAL(info) << "Start slicing process.";
 
 #ifdef SLAPRINT_DO_BENCHMARK
-    Benchmark bench;
+    using StepBenchmark = Benchmark;
 #else
-    struct {
+    struct StepBenchmark {
         void start() {} void stop() {} double getElapsedSec() { return .0; }
-    } bench;
+    };
 #endif
 
     std::array<double, slaposCount + slapsCount> step_times {};
+    // Guards st and step_times, which are updated by the objects processed concurrently.
+    std::mutex progress_mutex;
 
-    auto apply_steps_on_objects =
-        [this, &st, &printsteps, &step_times, &bench]
-        (const std::vector<SLAPrintObjectStep> &steps)
+    auto apply_steps_on_object =
+        [this, &st, &printsteps, &step_times, &progress_mutex]
+        (SLAPrintObject *po, const std::vector<SLAPrintObjectStep> &steps, const std::atomic<bool> &failed)
     {
-        double incr = 0;
-        for (SLAPrintObject *po : m_objects) {
-            for (SLAPrintObjectStep step : steps) {
+        for (SLAPrintObjectStep step : steps) {
 
-                // Cancellation checking. Each step will check for
-                // cancellation on its own and return earlier gracefully.
-                // Just after it returns execution gets to this point and
-                // throws the canceled signal.
-                throw_if_canceled();
+            // Cancellation checking. Each step will check for
+            // cancellation on its own and return earlier gracefully.
+            // Just after it returns execution gets to this point and
+            // throws the canceled signal.
+            throw_if_canceled();
 
-                st += incr;
+            // Processing of another object failed, don't start any new step.
+            if (failed)
+                return;
 
-                if (po->m_stepmask[step] && po->set_started(step)) {
-                    m_report_status(*this, st, printsteps.label(step));
-                    bench.start();
-                    printsteps.execute(step, *po);
-                    bench.stop();
-                    step_times[step] += bench.getElapsedSec();
-                    throw_if_canceled();
-                    po->set_done(step);
+            if (po->m_stepmask[step] && po->set_started(step)) {
+                double st_started;
+                {
+                    std::lock_guard<std::mutex> lock(progress_mutex);
+                    st_started = st;
                 }
-                
-                incr = printsteps.progressrange(step);
+                // st_started does not include the progress of the steps running on the other objects,
+                // m_report_status does not let the reported progress go back.
+                m_report_status(*this, st_started, printsteps.label(step));
+                StepBenchmark bench;
+                bench.start();
+                printsteps.execute(step, *po);
+                bench.stop();
+                throw_if_canceled();
+                po->set_done(step);
+                std::lock_guard<std::mutex> lock(progress_mutex);
+                step_times[step] += bench.getElapsedSec();
             }
+
+            // The progress is the sum of the progress ranges of the steps finished by all the objects.
+            std::lock_guard<std::mutex> lock(progress_mutex);
+            st += printsteps.progressrange(step);
         }
     };
 
+    // The objects are processed concurrently, each object executes its steps in order.
+    // The steps of the individual objects are only partially parallel internally,
+    // so a plate with many objects would be dominated by the serial parts when processing the objects one by one.
+    auto apply_steps_on_objects =
+        [this, &apply_steps_on_object](const std::vector<SLAPrintObjectStep> &steps)
+    {
+        std::atomic<bool> failed { false };
+        if (m_objects.size() == 1) {
+            apply_steps_on_object(m_objects.front(), steps, failed);
+            return;
+        }
+        // The exceptions are caught and the first one is rethrown after all the objects stop, so that the TBB
+        // does not cancel the parallel algorithms of the other objects while their steps are being marked as done.
+        std::exception_ptr exception;
+        std::mutex         exception_mutex;
+        tbb::task_group    task_group;
+        for (SLAPrintObject *po : m_objects)
+            task_group.run([po, &steps, &apply_steps_on_object, &failed, &exception, &exception_mutex]() {
+                try {
+                    apply_steps_on_object(po, steps, failed);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(exception_mutex);
+                    if (! exception)
+                        exception = std::current_exception();
+                    failed = true;
+                }
+            });
+        task_group.wait();
+        if (exception)
+            std::rethrow_exception(exception);
+    };
+
     apply_steps_on_objects(level1_obj_steps);
     apply_steps_on_objects(level2_obj_steps);
 
@@ -766,11 +814,34 @@ void SLAPrint::process()
     // std::fill(m_stepmask.begin(), m_stepmask.end(), false);
     
     st = Steps::max_objstatus;
+
+    // If both the merging and the rasterization are pending, the layers are merged and rasterized in a single
+    // streaming pass, thus the merged polygons of all the layers are never kept in memory at the same time.
+    if (m_printer && m_stepmask[slapsMergeSlicesAndEval] && m_stepmask[slapsRasterize] &&
+        ! Inherited::is_step_done(slapsMergeSlicesAndEval) && ! Inherited::is_step_done(slapsRasterize)) {
+        throw_if_canceled();
+
+        if (set_started(slapsMergeSlicesAndEval)) {
+            m_report_status(*this, st, printsteps.label(slapsMergeSlicesAndEval));
+            StepBenchmark bench;
+            bench.start();
+            printsteps.merge_slices_eval_stats_and_rasterize();
+            bench.stop();
+            step_times[slaposCount + slapsRasterize] += bench.getElapsedSec();
+            throw_if_canceled();
+            set_done(slapsMergeSlicesAndEval);
+            // The layers have been rasterized already.
+            if (set_started(slapsRasterize))
+                set_done(slapsRasterize);
+        }
+    }
+
     for(SLAPrintStep currentstep : print_steps) {
         throw_if_canceled();
 
         if (m_stepmask[currentstep] && set_started(currentstep)) {
             m_report_status(*this, st, printsteps.label(currentstep));
+            StepBenchmark bench;
             bench.start();
             printsteps.execute(currentstep);
             bench.stop();
@@ -1252,7 +1323,12 @@ void SLAPrint::StatusReporter::operator()(SLAPrint &         p,
                                           unsigned           flags,
                                           const std::string &logmsg)
 {
-    m_st = st;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (st >= 0) {
+        // Never report a progress lower than already reported.
+        m_st = std::max(m_st, st);
+        st   = m_st;
+    }
     BOOST_LOG_TRIVIAL(info)
         << st << "% " << msg << (logmsg.empty() ? "" : ": ") << logmsg
         << log_memory_info();
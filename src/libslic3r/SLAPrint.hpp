@@ -521,6 +521,9 @@ private:
 
     // Ready-made data for rasterization.
     std::vector<PrintLayer>         m_printer_input;
+    // The layers of m_printer_input were merged and rasterized in a single streaming pass,
+    // the merged polygons (PrintLayer::transformed_slices()) were not retained.
+    bool                            m_printer_input_streamed = false;
     
     // The archive object which collects the raster images after slicing
     SLAPrinter                     *m_printer = nullptr;
@@ -528,8 +531,13 @@ private:
     // Estimated print time, material consumed.
     SLAPrintStatistics              m_print_statistics;
     
+    // The objects processed concurrently report the progress of their steps from different starting points,
+    // therefore the reported progress is the maximum of the progress reported since the last reset().
+    // Negative progress values report a message without a progress.
     class StatusReporter
     {
+        // Serializes the status updates of the objects processed concurrently.
+        mutable std::mutex m_mutex;
         double m_st = 0;
         
     public:
@@ -539,7 +547,9 @@ private:
                         unsigned           flags = SlicingStatus::DEFAULT,
                         const std::string &logmsg = "");
         
-        double status() const { return m_st; }
+        double status() const { std::lock_guard<std::mutex> lock(m_mutex); return m_st; }
+        // Start a new slicing process from zero progress.
+        void   reset() { std::lock_guard<std::mutex> lock(m_mutex); m_st = 0; }
     } m_report_status;
 
 	friend SLAPrintObject;
@@ -73,7 +73,6 @@ std::string PRINT_STEP_LABELS(size_t idx)
 
 SLAPrint::Steps::Steps(SLAPrint *print)
     : m_print{print}
-    , m_rng{std::random_device{}()}
     , objcount{m_print->m_objects.size()}
     , ilhd{m_print->m_material_config.initial_layer_height.getFloat()}
     , ilh{float(ilhd)}
@@ -176,12 +175,14 @@ void SLAPrint::Steps::drill_holes(SLAPrintObject &po)
     BOOST_LOG_TRIVIAL(info) << "Drilling drainage holes.";
     sla::DrainHoles drainholes = po.transformed_drainhole_points();
     
+    // Local random generator, as the objects may be drilled concurrently.
+    std::mt19937 rng{std::random_device{}()};
     std::uniform_real_distribution<float> dist(0., float(EPSILON));
     auto holes_mesh_cgal = MeshBoolean::cgal::triangle_mesh_to_cgal({});
     for (sla::DrainHole holept : drainholes) {
-        holept.normal += Vec3f{dist(m_rng), dist(m_rng), dist(m_rng)};
+        holept.normal += Vec3f{dist(rng), dist(rng), dist(rng)};
         holept.normal.normalize();
-        holept.pos += Vec3f{dist(m_rng), dist(m_rng), dist(m_rng)};
+        holept.pos += Vec3f{dist(rng), dist(rng), dist(rng)};
         TriangleMesh m = sla::to_triangle_mesh(holept.to_mesh());
         m.require_shared_vertices();
         auto cgal_m = MeshBoolean::cgal::triangle_mesh_to_cgal(m);
@@ -331,6 +332,8 @@ void SLAPrint::Steps::support_points(SLAPrintObject &po)
         
         // scaling for the sub operations
         double d = objectstep_scale * OBJ_STEP_LEVELS[slaposSupportPoints] / 100.0;
+        // Progress of all the objects when this step started. The other objects may advance the progress concurrently,
+        // then the progress of this object is reported only once it gets over theirs.
         double init = current_status();
         
         auto statuscb = [this, d, init](unsigned st)
@@ -638,22 +641,87 @@ void SLAPrint::Steps::initialize_printer_input()
     }
 }
 
-// Merging the slices from all the print objects into one slice grid and
-// calculating print statistics from the merge result.
-void SLAPrint::Steps::merge_slices_and_eval_stats() {
-    
-    initialize_printer_input();
-    
+// Merge the slices of all the objects at a single print layer into the polygons to be rasterized.
+// The areas of the merged model and support polygons are returned through stats.
+ClipperPolygons SLAPrint::Steps::merge_layer_slices(const PrintLayer &layer, LayerStats &stats)
+{
+    // libnest calculates positive area for clockwise polygons, Slic3r is in counter-clockwise
+    auto areafn = [](const ClipperPolygon& poly) { return - libnest2d::sl::area(poly); };
+
+    // vector of slice record references
+    auto& slicerecord_references = layer.slices();
+
+    if(slicerecord_references.empty()) return {};
+
+    // Layer height should match for all object slices for a given level.
+    stats.empty  = false;
+    stats.height = double(slicerecord_references.front().get().layer_height());
+
+    // Calculation of the consumed material
+
+    ClipperPolygons model_polygons;
+    ClipperPolygons supports_polygons;
+
+    size_t c = std::accumulate(layer.slices().begin(),
+                               layer.slices().end(),
+                               size_t(0),
+                               [](size_t a, const SliceRecord &sr) {
+        return a + sr.get_slice(soModel).size();
+    });
+
+    model_polygons.reserve(c);
+
+    c = std::accumulate(layer.slices().begin(),
+                        layer.slices().end(),
+                        size_t(0),
+                        [](size_t a, const SliceRecord &sr) {
+        return a + sr.get_slice(soModel).size();
+    });
+
+    supports_polygons.reserve(c);
+
+    for(const SliceRecord& record : layer.slices()) {
+
+        ClipperPolygons modelslices = get_all_polygons(record, soModel);
+        for(ClipperPolygon& p_tmp : modelslices) model_polygons.emplace_back(std::move(p_tmp));
+
+        ClipperPolygons supportslices = get_all_polygons(record, soSupport);
+        for(ClipperPolygon& p_tmp : supportslices) supports_polygons.emplace_back(std::move(p_tmp));
+
+    }
+
+    model_polygons = polyunion(model_polygons);
+    for (const ClipperPolygon& polygon : model_polygons)
+        stats.model_area += areafn(polygon);
+
+    if(!supports_polygons.empty()) {
+        if(model_polygons.empty()) supports_polygons = polyunion(supports_polygons);
+        else supports_polygons = polydiff(supports_polygons, model_polygons);
+        // allegedly, union of subject is done withing the diff according to the pftPositive polyFillType
+    }
+
+    for (const ClipperPolygon& polygon : supports_polygons)
+        stats.support_area += areafn(polygon);
+
+    // Here we can save the expensively calculated polygons for printing
+    ClipperPolygons trslices;
+    trslices.reserve(model_polygons.size() + supports_polygons.size());
+    for(ClipperPolygon& poly : model_polygons) trslices.emplace_back(std::move(poly));
+    for(ClipperPolygon& poly : supports_polygons) trslices.emplace_back(std::move(poly));
+
+    return polyunion(trslices);
+}
+
+// Calculating the print statistics from the areas of the merged layers.
+// The layers are accumulated in order, as the exposure time of a layer depends on the layers below (faded layers).
+void SLAPrint::Steps::eval_stats(const std::vector<LayerStats> &layers_stats)
+{
     auto &print_statistics = m_print->m_print_statistics;
     auto &printer_config   = m_print->m_printer_config;
     auto &material_config  = m_print->m_material_config;
-    auto &printer_input    = m_print->m_printer_input;
-    
+
     print_statistics.clear();
-    
-    // libnest calculates positive area for clockwise polygons, Slic3r is in counter-clockwise
-    auto areafn = [](const ClipperPolygon& poly) { return - libnest2d::sl::area(poly); };
-    
+
     const double area_fill = printer_config.area_fill.getFloat()*0.01;// 0.5 (50%);
     const double fast_tilt = printer_config.fast_tilt_time.getFloat();// 5.0;
     const double slow_tilt = printer_config.slow_tilt_time.getFloat();// 8.0;
@@ -672,132 +740,48 @@ void SLAPrint::Steps::merge_slices_and_eval_stats() {
     
     double estim_time(0.0);
     std::vector<double> layers_times;
-    layers_times.reserve(printer_input.size());
+    layers_times.reserve(layers_stats.size());
     
     size_t slow_layers = 0;
     size_t fast_layers = 0;
     
     const double delta_fade_time = (init_exp_time - exp_time) / (fade_layers_cnt + 1);
     double fade_layer_time = init_exp_time;
-    
-    sla::ccr::SpinningMutex mutex;
-    using Lock = std::lock_guard<sla::ccr::SpinningMutex>;
-    
-    // Going to parallel:
-    auto printlayerfn = [this,
-            // functions and read only vars
-            areafn, area_fill, display_area, exp_time, init_exp_time, fast_tilt, slow_tilt, delta_fade_time,
-            
-            // write vars
-            &mutex, &models_volume, &supports_volume, &estim_time, &slow_layers,
-            &fast_layers, &fade_layer_time, &layers_times](size_t sliced_layer_cnt)
-    {
-        PrintLayer &layer = m_print->m_printer_input[sliced_layer_cnt];
 
-        // vector of slice record references
-        auto& slicerecord_references = layer.slices();
-        
-        if(slicerecord_references.empty()) return;
-        
-        // Layer height should match for all object slices for a given level.
-        const auto l_height = double(slicerecord_references.front().get().layer_height());
-        
-        // Calculation of the consumed material
-        
-        ClipperPolygons model_polygons;
-        ClipperPolygons supports_polygons;
-        
-        size_t c = std::accumulate(layer.slices().begin(),
-                                   layer.slices().end(),
-                                   size_t(0),
-                                   [](size_t a, const SliceRecord &sr) {
-            return a + sr.get_slice(soModel).size();
-        });
-        
-        model_polygons.reserve(c);
-        
-        c = std::accumulate(layer.slices().begin(),
-                            layer.slices().end(),
-                            size_t(0),
-                            [](size_t a, const SliceRecord &sr) {
-            return a + sr.get_slice(soModel).size();
-        });
-        
-        supports_polygons.reserve(c);
-        
-        for(const SliceRecord& record : layer.slices()) {
-            
-            ClipperPolygons modelslices = get_all_polygons(record, soModel);
-            for(ClipperPolygon& p_tmp : modelslices) model_polygons.emplace_back(std::move(p_tmp));
-        
-            ClipperPolygons supportslices = get_all_polygons(record, soSupport);
-            for(ClipperPolygon& p_tmp : supportslices) supports_polygons.emplace_back(std::move(p_tmp));
-        
-        }
-        
-        model_polygons = polyunion(model_polygons);
-        double layer_model_area = 0;
-        for (const ClipperPolygon& polygon : model_polygons)
-            layer_model_area += areafn(polygon);
-        
-        if (layer_model_area < 0 || layer_model_area > 0) {
-            Lock lck(mutex); models_volume += layer_model_area * l_height;
-        }
-        
-        if(!supports_polygons.empty()) {
-            if(model_polygons.empty()) supports_polygons = polyunion(supports_polygons);
-            else supports_polygons = polydiff(supports_polygons, model_polygons);
-            // allegedly, union of subject is done withing the diff according to the pftPositive polyFillType
-        }
-        
-        double layer_support_area = 0;
-        for (const ClipperPolygon& polygon : supports_polygons)
-            layer_support_area += areafn(polygon);
-        
-        if (layer_support_area < 0 || layer_support_area > 0) {
-            Lock lck(mutex); supports_volume += layer_support_area * l_height;
-        }
-        
-        // Here we can save the expensively calculated polygons for printing
-        ClipperPolygons trslices;
-        trslices.reserve(model_polygons.size() + supports_polygons.size());
-        for(ClipperPolygon& poly : model_polygons) trslices.emplace_back(std::move(poly));
-        for(ClipperPolygon& poly : supports_polygons) trslices.emplace_back(std::move(poly));
-        
-        layer.transformed_slices(polyunion(trslices));
-        
+    for (size_t sliced_layer_cnt = 0; sliced_layer_cnt < layers_stats.size(); ++ sliced_layer_cnt) {
+        const LayerStats &layer = layers_stats[sliced_layer_cnt];
+        if (layer.empty)
+            continue;
+
+        models_volume   += layer.model_area * layer.height;
+        supports_volume += layer.support_area * layer.height;
+
         // Calculation of the slow and fast layers to the future controlling those values on FW
         
-        const bool is_fast_layer = (layer_model_area + layer_support_area) <= display_area*area_fill;
+        const bool is_fast_layer = (layer.model_area + layer.support_area) <= display_area*area_fill;
         const double tilt_time = is_fast_layer ? fast_tilt : slow_tilt;
         
-        { Lock lck(mutex);
-            if (is_fast_layer)
-                fast_layers++;
-            else
-                slow_layers++;
-            
-            // Calculation of the printing time
-
-            double layer_times = 0.0;
-            if (sliced_layer_cnt < 3)
-                layer_times += init_exp_time;
-            else if (fade_layer_time > exp_time) {
-                fade_layer_time -= delta_fade_time;
-                layer_times += fade_layer_time;
-            }
-            else
-                layer_times += exp_time;
-            layer_times += tilt_time;
+        if (is_fast_layer)
+            fast_layers++;
+        else
+            slow_layers++;
+        
+        // Calculation of the printing time
 
-            layers_times.push_back(layer_times);
-            estim_time += layer_times;
+        double layer_times = 0.0;
+        if (sliced_layer_cnt < 3)
+            layer_times += init_exp_time;
+        else if (fade_layer_time > exp_time) {
+            fade_layer_time -= delta_fade_time;
+            layer_times += fade_layer_time;
         }
-    };
-    
-    // sequential version for debugging:
-    // for(size_t i = 0; i < m_printer_input.size(); ++i) printlayerfn(i);
-    sla::ccr::for_each(size_t(0), printer_input.size(), printlayerfn);
+        else
+            layer_times += exp_time;
+        layer_times += tilt_time;
+
+        layers_times.push_back(layer_times);
+        estim_time += layer_times;
+    }
     
     auto SCALING2 = SCALING_FACTOR * SCALING_FACTOR;
     print_statistics.support_used_material = supports_volume * SCALING2;
@@ -805,7 +789,7 @@ void SLAPrint::Steps::merge_slices_and_eval_stats() {
     
     // Estimated printing time
     // A layers count o the highest object
-    if (printer_input.size() == 0)
+    if (layers_stats.size() == 0)
         print_statistics.estimated_print_time = std::nan("");
     else {
         print_statistics.estimated_print_time = estim_time;
@@ -814,22 +798,70 @@ void SLAPrint::Steps::merge_slices_and_eval_stats() {
     
     print_statistics.fast_layers_count = fast_layers;
     print_statistics.slow_layers_count = slow_layers;
+}
+
+// Merging the slices from all the print objects into one slice grid and
+// calculating print statistics from the merge result.
+void SLAPrint::Steps::merge_slices_and_eval_stats() {
+    
+    initialize_printer_input();
+    m_print->m_printer_input_streamed = false;
+    
+    auto &printer_input = m_print->m_printer_input;
+    std::vector<LayerStats> layers_stats(printer_input.size());
+    
+    // Going to parallel:
+    auto printlayerfn = [&printer_input, &layers_stats](size_t sliced_layer_cnt)
+    {
+        PrintLayer &layer = printer_input[sliced_layer_cnt];
+        layer.transformed_slices(merge_layer_slices(layer, layers_stats[sliced_layer_cnt]));
+    };
+    
+    // sequential version for debugging:
+    // for(size_t i = 0; i < m_printer_input.size(); ++i) printlayerfn(i);
+    sla::ccr::for_each(size_t(0), printer_input.size(), printlayerfn);
+    
+    eval_stats(layers_stats);
     
     report_status(-2, "", SlicingStatus::RELOAD_SLA_PREVIEW);
 }
 
-// Rasterizing the model objects, and their supports
-void SLAPrint::Steps::rasterize()
+// Streaming variant of merge_slices_and_eval_stats() followed by rasterize().
+// Each layer is merged, its statistics are collected and the layer is rasterized and encoded right away
+// by the same worker thread. The merged polygons are released once the layer is rasterized, thus only the layers
+// being processed by the worker threads are kept in memory and the peak memory does not depend on the print height.
+// The merged polygons are not retained, if the rasterization step gets invalidated alone, rasterize() merges the layers again.
+void SLAPrint::Steps::merge_slices_eval_stats_and_rasterize()
 {
-    if(canceled() || !m_print->m_printer) return;
+    initialize_printer_input();
+    m_print->m_printer_input_streamed = true;
+    
+    auto &printer_input = m_print->m_printer_input;
+    std::vector<LayerStats> layers_stats(printer_input.size());
     
+    if (! canceled() && m_print->m_printer) {
+        // The status is advanced over the slots of both the merging and the rasterization.
+        unsigned slot = PRINT_STEP_LEVELS[slapsMergeSlicesAndEval] + PRINT_STEP_LEVELS[slapsRasterize];
+        this->draw_layers(slot, [&printer_input, &layers_stats](size_t idx) {
+            return merge_layer_slices(printer_input[idx], layers_stats[idx]);
+        });
+    }
+    throw_if_canceled();
+    
+    eval_stats(layers_stats);
+    
+    report_status(-2, "", SlicingStatus::RELOAD_SLA_PREVIEW);
+}
+
+// Rasterizing the layers by the printer. slicesfn(layer_idx) returns the polygons to be rasterized for a layer.
+// The status is advanced over the provided slot.
+template<class SlicesFn>
+void SLAPrint::Steps::draw_layers(unsigned slot, SlicesFn &&slicesfn)
+{
     // coefficient to map the rasterization state (0-99) to the allocated
     // portion (slot) of the process state
     double sd = (100 - max_objstatus) / 100.0;
     
-    // slot is the portion of 100% that is realted to rasterization
-    unsigned slot = PRINT_STEP_LEVELS[slapsRasterize];
-    
     // pst: previous state
     double pst = current_status();
     
@@ -841,13 +873,12 @@ void SLAPrint::Steps::rasterize()
     
     // procedure to process one height level. This will run in parallel
     auto lvlfn =
-        [this, &slck, increment, &dstatus, &pst]
+        [this, &slck, increment, &dstatus, &pst, &slicesfn]
         (sla::RasterBase& raster, size_t idx)
     {
-        PrintLayer& printlayer = m_print->m_printer_input[idx];
         if(canceled()) return;
         
-        for (const ClipperLib::Polygon& poly : printlayer.transformed_slices())
+        for (const ClipperLib::Polygon& poly : slicesfn(idx))
             raster.draw(poly);
         
         // Status indication guarded with the spinlock
@@ -869,6 +900,26 @@ void SLAPrint::Steps::rasterize()
     m_print->m_printer->draw_layers(m_print->m_printer_input.size(), lvlfn);
 }
 
+// Rasterizing the model objects, and their supports
+void SLAPrint::Steps::rasterize()
+{
+    if(canceled() || !m_print->m_printer) return;
+    
+    auto &printer_input = m_print->m_printer_input;
+    // slot is the portion of 100% that is realted to rasterization
+    unsigned slot = PRINT_STEP_LEVELS[slapsRasterize];
+    if (m_print->m_printer_input_streamed)
+        // The merged polygons were released by merge_slices_eval_stats_and_rasterize(), merge the layers again.
+        this->draw_layers(slot, [&printer_input](size_t idx) {
+            LayerStats stats;
+            return merge_layer_slices(printer_input[idx], stats);
+        });
+    else
+        this->draw_layers(slot, [&printer_input](size_t idx) -> const ClipperPolygons& {
+            return printer_input[idx].transformed_slices();
+        });
+}
+
 std::string SLAPrint::Steps::label(SLAPrintObjectStep step)
 {
     return OBJ_STEP_LABELS(step);
@@ -14,7 +14,6 @@ class SLAPrint::Steps
 {
 private:
     SLAPrint *m_print = nullptr;
-    std::mt19937 m_rng;
     
 public:    
     // where the per object operations start and end
@@ -45,6 +44,20 @@ private:
     
     void apply_printer_corrections(SLAPrintObject &po, SliceOrigin o);
     
+public:
+    // Areas of the merged slices of a single print layer, input of the print statistics.
+    struct LayerStats {
+        bool   empty        = true;
+        double height       = 0.;
+        double model_area   = 0.;
+        double support_area = 0.;
+    };
+    
+private:
+    static std::vector<ClipperLib::Polygon> merge_layer_slices(const PrintLayer &layer, LayerStats &stats);
+    void eval_stats(const std::vector<LayerStats> &layers_stats);
+    template<class SlicesFn> void draw_layers(unsigned slot, SlicesFn &&slicesfn);
+    
 public:
     explicit Steps(SLAPrint *print);
     
@@ -58,6 +71,8 @@ public:
     
     void merge_slices_and_eval_stats();
     void rasterize();
+    // Both merge_slices_and_eval_stats() and rasterize() in a single streaming pass over the layers.
+    void merge_slices_eval_stats_and_rasterize();
     
     void execute(SLAPrintObjectStep step, SLAPrintObject &obj);
     void execute(SLAPrintStep step);
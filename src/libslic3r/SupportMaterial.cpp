@@ -7,6 +7,7 @@
 #include "EdgeGrid.hpp"
 #include "Geometry.hpp"
 
+#include <atomic>
 #include <cmath>
 #include <memory>
 #include <boost/log/trivial.hpp>
@@ -277,6 +278,8 @@ void PrintObjectSupportMaterial::generate(PrintObject &object)
     MyLayersPtr intermediate_layers = this->raft_and_intermediate_support_layers(
         object, bottom_contacts, top_contacts, layer_storage);
 
+    // raft_and_intermediate_support_layers() adjusts the height / bottom_z of the top contact layers,
+    // which are read by the trimming below, therefore the trimming must not start before it is finished.
 //    this->trim_support_layers_by_object(object, top_contacts, m_slicing_params.soluble_interface ? 0. : m_support_layer_height_min, 0., m_gap_xy);
     this->trim_support_layers_by_object(object, top_contacts, 
         m_slicing_params.soluble_interface ? 0. : m_object_config->support_material_contact_distance.value, 
@@ -1017,7 +1020,7 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::top_contact_
     // and the other for the overhangs extruded with a normal flow.
     contact_out.assign(num_layers * 2, nullptr);
     tbb::spin_mutex layer_storage_mutex;
-    tbb::parallel_for(tbb::blocked_range<size_t>(this->has_raft() ? 0 : 1, num_layers),
+    execution::parallel_for(m_object->print()->execution_policy(), tbb::blocked_range<size_t>(this->has_raft() ? 0 : 1, num_layers),
         [this, &object, &buildplate_covered, &enforcers, &blockers, support_auto, threshold_rad, &layer_storage, &layer_storage_mutex, &contact_out]
         (const tbb::blocked_range<size_t>& range) {
             for (size_t layer_id = range.begin(); layer_id < range.end(); ++ layer_id) 
@@ -1721,7 +1724,7 @@ int idx_lower_or_equal(const std::vector<T*> &vec, int idx, FN_LOWER_EQUAL fn_lo
 void PrintObjectSupportMaterial::trim_top_contacts_by_bottom_contacts(
     const PrintObject &object, const MyLayersPtr &bottom_contacts, MyLayersPtr &top_contacts) const
 {
-    tbb::parallel_for(tbb::blocked_range<int>(0, int(top_contacts.size())),
+    execution::parallel_for(m_object->print()->execution_policy(), tbb::blocked_range<int>(0, int(top_contacts.size())),
         [this, &object, &bottom_contacts, &top_contacts](const tbb::blocked_range<int>& range) {
             int idx_bottom_overlapping_first = -2;
             // For all top contact layers, counting downwards due to the way idx_higher_or_equal caches the last index to avoid repeated binary search.
@@ -1949,7 +1952,8 @@ void PrintObjectSupportMaterial::generate_base_layers(
     // coordf_t fillet_radius_scaled = scale_(m_object_config->support_material_spacing);
 
     BOOST_LOG_TRIVIAL(debug) << "PrintObjectSupportMaterial::generate_base_layers() in parallel - start";
-    tbb::parallel_for(
+    execution::parallel_for(
+        m_object->print()->execution_policy(),
         tbb::blocked_range<size_t>(0, intermediate_layers.size()),
         [this, &object, &bottom_contacts, &top_contacts, &intermediate_layers, &layer_support_areas](const tbb::blocked_range<size_t>& range) {
             // index -2 means not initialized yet, -1 means intialized and decremented to 0 and then -1.
@@ -2095,7 +2099,8 @@ void PrintObjectSupportMaterial::trim_support_layers_by_object(
 
     // For all intermediate support layers:
     BOOST_LOG_TRIVIAL(debug) << "PrintObjectSupportMaterial::trim_support_layers_by_object() in parallel - start";
-    tbb::parallel_for(
+    execution::parallel_for(
+        m_object->print()->execution_policy(),
         tbb::blocked_range<size_t>(0, nonempty_layers.size()),
         [this, &object, &nonempty_layers, gap_extra_above, gap_extra_below, gap_xy_scaled](const tbb::blocked_range<size_t>& range) {
             size_t idx_object_layer_overlapping = size_t(-1);
@@ -2252,7 +2257,7 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::generate_int
         BOOST_LOG_TRIVIAL(debug) << "PrintObjectSupportMaterial::generate_interface_layers() in parallel - start";
         interface_layers.assign(intermediate_layers.size(), nullptr);
         tbb::spin_mutex layer_storage_mutex;
-        tbb::parallel_for(tbb::blocked_range<size_t>(0, intermediate_layers.size()),
+        execution::parallel_for(m_object->print()->execution_policy(), tbb::blocked_range<size_t>(0, intermediate_layers.size()),
             [this, &bottom_contacts, &top_contacts, &intermediate_layers, &layer_storage, &layer_storage_mutex, &interface_layers](const tbb::blocked_range<size_t>& range) {
                 // Index of the first top contact layer intersecting the current intermediate layer.
                 size_t idx_top_contact_first = size_t(-1);
@@ -2995,98 +3000,8 @@ void PrintObjectSupportMaterial::generate_toolpaths(
         assert(m_slicing_params.raft_layers() == 0 && raft_layers.size() == 0);
     }
 
-    // Insert the raft base layers.
+    // Number of the raft base layers, which are generated independently from the support layers above the raft.
     size_t n_raft_layers = size_t(std::max(0, int(m_slicing_params.raft_layers()) - 1));
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, n_raft_layers),
-        [this, &object, &raft_layers, 
-            infill_pattern, &bbox_object, support_density, interface_density, raft_angle_1st_layer, raft_angle_base, raft_angle_interface, link_max_length_factor, with_sheath]
-            (const tbb::blocked_range<size_t>& range) {
-        for (size_t support_layer_id = range.begin(); support_layer_id < range.end(); ++ support_layer_id)
-        {
-            assert(support_layer_id < raft_layers.size());
-            SupportLayer &support_layer = *object.support_layers()[support_layer_id];
-            assert(support_layer.support_fills.entities.empty());
-            MyLayer      &raft_layer    = *raft_layers[support_layer_id];
-
-            std::unique_ptr<Fill> filler_interface = std::unique_ptr<Fill>(Fill::new_from_type(ipRectilinear));
-            std::unique_ptr<Fill> filler_support   = std::unique_ptr<Fill>(Fill::new_from_type(infill_pattern));
-            filler_interface->set_bounding_box(bbox_object);
-            filler_support->set_bounding_box(bbox_object);
-
-            // Print the support base below the support columns, or the support base for the support columns plus the contacts.
-            if (support_layer_id > 0) {
-                Polygons to_infill_polygons = (support_layer_id < m_slicing_params.base_raft_layers) ? 
-                    raft_layer.polygons :
-                    //FIXME misusing contact_polygons for support columns.
-                    ((raft_layer.contact_polygons == nullptr) ? Polygons() : *raft_layer.contact_polygons);
-                if (! to_infill_polygons.empty()) {
-                    Flow flow(float(m_support_material_flow.width), float(raft_layer.height), m_support_material_flow.nozzle_diameter, raft_layer.bridging);
-                    // find centerline of the external loop/extrusions
-                    ExPolygons to_infill = (support_layer_id == 0 || ! with_sheath) ?
-                        // union_ex(base_polygons, true) :
-                        offset2_ex(to_infill_polygons, float(SCALED_EPSILON), float(- SCALED_EPSILON)) :
-                        offset2_ex(to_infill_polygons, float(SCALED_EPSILON), float(- SCALED_EPSILON - 0.5*flow.scaled_width()));            
-                    if (! to_infill.empty() && with_sheath) {
-                        // Draw a perimeter all around the support infill. This makes the support stable, but difficult to remove.
-                        // TODO: use brim ordering algorithm
-                        to_infill_polygons = to_polygons(to_infill);
-                        // TODO: use offset2_ex()
-                        to_infill = offset_ex(to_infill, float(- 0.4 * flow.scaled_spacing()));
-                        extrusion_entities_append_paths(
-                            support_layer.support_fills.entities, 
-                            to_polylines(std::move(to_infill_polygons)),
-                            erSupportMaterial, flow.mm3_per_mm(), flow.width, flow.height);
-                    }
-                    if (! to_infill.empty()) {
-                        // We don't use $base_flow->spacing because we need a constant spacing
-                        // value that guarantees that all layers are correctly aligned.
-                        Fill *filler    = filler_support.get();
-                        filler->angle   = raft_angle_base;
-                        filler->spacing = m_support_material_flow.spacing();
-                        filler->link_max_length = coord_t(scale_(filler->spacing * link_max_length_factor / support_density));
-                        fill_expolygons_generate_paths(
-                            // Destination
-                            support_layer.support_fills.entities, 
-                            // Regions to fill
-                            std::move(to_infill), 
-                            // Filler and its parameters
-                            filler, float(support_density),
-                            // Extrusion parameters
-                            erSupportMaterial, flow);
-                    }
-                }
-            }
-
-            Fill *filler = filler_interface.get();
-            Flow  flow = m_first_layer_flow;
-            float density = 0.f;
-            if (support_layer_id == 0) {
-                // Base flange.
-                filler->angle = raft_angle_1st_layer;
-                filler->spacing = m_first_layer_flow.spacing();
-                // 70% of density on the 1st layer.
-                density       = 0.7f;
-            } else if (support_layer_id >= m_slicing_params.base_raft_layers) {
-                filler->angle = raft_angle_interface;
-                // We don't use $base_flow->spacing because we need a constant spacing
-                // value that guarantees that all layers are correctly aligned.
-                filler->spacing = m_support_material_flow.spacing();
-                flow          = Flow(float(m_support_material_interface_flow.width), float(raft_layer.height), m_support_material_flow.nozzle_diameter, raft_layer.bridging);
-                density       = float(interface_density);
-            } else
-                continue;
-            filler->link_max_length = coord_t(scale_(filler->spacing * link_max_length_factor / density));
-            fill_expolygons_generate_paths(
-                // Destination
-                support_layer.support_fills.entities, 
-                // Regions to fill
-                offset2_ex(raft_layer.polygons, float(SCALED_EPSILON), float(- SCALED_EPSILON)),
-                // Filler and its parameters
-                filler, density,
-                // Extrusion parameters
-                (support_layer_id < m_slicing_params.base_raft_layers) ? erSupportMaterial : erSupportMaterialInterface, flow);
-        }
-    });
 
     struct LayerCacheItem {
         LayerCacheItem(MyLayerExtruded *layer_extruded = nullptr) : layer_extruded(layer_extruded) {}
@@ -3102,8 +3017,148 @@ void PrintObjectSupportMaterial::generate_toolpaths(
     };
     std::vector<LayerCache>             layer_caches(object.support_layers().size(), LayerCache());
 
-    tbb::parallel_for(tbb::blocked_range<size_t>(n_raft_layers, object.support_layers().size()),
-        [this, &object, &bottom_contacts, &top_contacts, &intermediate_layers, &interface_layers, &layer_caches, &loop_interface_processor, 
+    // Modulate the support layer height of a single support layer, once all its overlapping layers are finished.
+    auto modulate_layer = [&object, &layer_caches](size_t support_layer_id) {
+        SupportLayer &support_layer = *object.support_layers()[support_layer_id];
+        LayerCache   &layer_cache   = layer_caches[support_layer_id];
+        for (LayerCacheItem &layer_cache_item : layer_cache.overlaps) {
+            modulate_extrusion_by_overlapping_layers(layer_cache_item.layer_extruded->extrusions, *layer_cache_item.layer_extruded->layer, layer_cache_item.overlapping);
+            support_layer.support_fills.append(std::move(layer_cache_item.layer_extruded->extrusions));
+        }
+    };
+
+    // Z window of each support layer: The lowest support layer, which may overlap with any layer of this support layer.
+    // Conservatively estimated from the thickest support layer.
+    coordf_t max_layer_height = 0.;
+    for (const MyLayersPtr *layers : { &bottom_contacts, &top_contacts, &intermediate_layers, &interface_layers })
+        for (const MyLayer *layer : *layers)
+            max_layer_height = std::max(max_layer_height, layer->height);
+    std::vector<size_t>              window_begin(object.support_layers().size(), n_raft_layers);
+    // Number of support layers in the Z window of a support layer (including the layer itself) not finished yet.
+    std::vector<std::atomic<size_t>> num_pending(object.support_layers().size());
+    for (size_t support_layer_id = n_raft_layers, idx_begin = n_raft_layers; support_layer_id < object.support_layers().size(); ++ support_layer_id) {
+        coordf_t bottom_z = object.support_layers()[support_layer_id]->print_z - max_layer_height - EPSILON;
+        while (object.support_layers()[idx_begin]->print_z <= bottom_z)
+            ++ idx_begin;
+        window_begin[support_layer_id] = idx_begin;
+        num_pending[support_layer_id].store(support_layer_id + 1 - idx_begin, std::memory_order_relaxed);
+    }
+
+    // The support layers are generated by a dependency driven scheduler:
+    // 1) The raft layers are independent from the support layers above the raft, they are generated concurrently with them.
+    // 2) The extrusion rate of a support layer is modulated by the lower support layers overlapping with it in Z.
+    //    The base and interface polygons of these lower layers are modified when generating their extrusions, therefore
+    //    a support layer is modulated as soon as all the support layers of its Z window below it are finished,
+    //    instead of waiting for all the support layers to be finished.
+    // Declared after all the state its tasks refer to: If this function unwinds, the task_group waits for its tasks
+    // before that state is destroyed.
+    tbb::task_group task_group;
+
+    // Insert the raft base layers.
+    task_group.run([this, &object, &raft_layers, n_raft_layers,
+        infill_pattern, &bbox_object, support_density, interface_density, raft_angle_1st_layer, raft_angle_base, raft_angle_interface, link_max_length_factor, with_sheath]() {
+        execution::parallel_for(m_object->print()->execution_policy(), tbb::blocked_range<size_t>(0, n_raft_layers),
+            [this, &object, &raft_layers, 
+                infill_pattern, &bbox_object, support_density, interface_density, raft_angle_1st_layer, raft_angle_base, raft_angle_interface, link_max_length_factor, with_sheath]
+                (const tbb::blocked_range<size_t>& range) {
+            for (size_t support_layer_id = range.begin(); support_layer_id < range.end(); ++ support_layer_id)
+            {
+                assert(support_layer_id < raft_layers.size());
+                SupportLayer &support_layer = *object.support_layers()[support_layer_id];
+                assert(support_layer.support_fills.entities.empty());
+                MyLayer      &raft_layer    = *raft_layers[support_layer_id];
+
+                std::unique_ptr<Fill> filler_interface = std::unique_ptr<Fill>(Fill::new_from_type(ipRectilinear));
+                std::unique_ptr<Fill> filler_support   = std::unique_ptr<Fill>(Fill::new_from_type(infill_pattern));
+                filler_interface->set_bounding_box(bbox_object);
+                filler_support->set_bounding_box(bbox_object);
+
+                // Print the support base below the support columns, or the support base for the support columns plus the contacts.
+                if (support_layer_id > 0) {
+                    Polygons to_infill_polygons = (support_layer_id < m_slicing_params.base_raft_layers) ? 
+                        raft_layer.polygons :
+                        //FIXME misusing contact_polygons for support columns.
+                        ((raft_layer.contact_polygons == nullptr) ? Polygons() : *raft_layer.contact_polygons);
+                    if (! to_infill_polygons.empty()) {
+                        Flow flow(float(m_support_material_flow.width), float(raft_layer.height), m_support_material_flow.nozzle_diameter, raft_layer.bridging);
+                        // find centerline of the external loop/extrusions
+                        ExPolygons to_infill = (support_layer_id == 0 || ! with_sheath) ?
+                            // union_ex(base_polygons, true) :
+                            offset2_ex(to_infill_polygons, float(SCALED_EPSILON), float(- SCALED_EPSILON)) :
+                            offset2_ex(to_infill_polygons, float(SCALED_EPSILON), float(- SCALED_EPSILON - 0.5*flow.scaled_width()));            
+                        if (! to_infill.empty() && with_sheath) {
+                            // Draw a perimeter all around the support infill. This makes the support stable, but difficult to remove.
+                            // TODO: use brim ordering algorithm
+                            to_infill_polygons = to_polygons(to_infill);
+                            // TODO: use offset2_ex()
+                            to_infill = offset_ex(to_infill, float(- 0.4 * flow.scaled_spacing()));
+                            extrusion_entities_append_paths(
+                                support_layer.support_fills.entities, 
+                                to_polylines(std::move(to_infill_polygons)),
+                                erSupportMaterial, flow.mm3_per_mm(), flow.width, flow.height);
+                        }
+                        if (! to_infill.empty()) {
+                            // We don't use $base_flow->spacing because we need a constant spacing
+                            // value that guarantees that all layers are correctly aligned.
+                            Fill *filler    = filler_support.get();
+                            filler->angle   = raft_angle_base;
+                            filler->spacing = m_support_material_flow.spacing();
+                            filler->link_max_length = coord_t(scale_(filler->spacing * link_max_length_factor / support_density));
+                            fill_expolygons_generate_paths(
+                                // Destination
+                                support_layer.support_fills.entities, 
+                                // Regions to fill
+                                std::move(to_infill), 
+                                // Filler and its parameters
+                                filler, float(support_density),
+                                // Extrusion parameters
+                                erSupportMaterial, flow);
+                        }
+                    }
+                }
+
+                Fill *filler = filler_interface.get();
+                Flow  flow = m_first_layer_flow;
+                float density = 0.f;
+                if (support_layer_id == 0) {
+                    // Base flange.
+                    filler->angle = raft_angle_1st_layer;
+                    filler->spacing = m_first_layer_flow.spacing();
+                    // 70% of density on the 1st layer.
+                    density       = 0.7f;
+                } else if (support_layer_id >= m_slicing_params.base_raft_layers) {
+                    filler->angle = raft_angle_interface;
+                    // We don't use $base_flow->spacing because we need a constant spacing
+                    // value that guarantees that all layers are correctly aligned.
+                    filler->spacing = m_support_material_flow.spacing();
+                    flow          = Flow(float(m_support_material_interface_flow.width), float(raft_layer.height), m_support_material_flow.nozzle_diameter, raft_layer.bridging);
+                    density       = float(interface_density);
+                } else
+                    continue;
+                filler->link_max_length = coord_t(scale_(filler->spacing * link_max_length_factor / density));
+                fill_expolygons_generate_paths(
+                    // Destination
+                    support_layer.support_fills.entities, 
+                    // Regions to fill
+                    offset2_ex(raft_layer.polygons, float(SCALED_EPSILON), float(- SCALED_EPSILON)),
+                    // Filler and its parameters
+                    filler, density,
+                    // Extrusion parameters
+                    (support_layer_id < m_slicing_params.base_raft_layers) ? erSupportMaterial : erSupportMaterialInterface, flow);
+            }
+        });
+    });
+
+    // Called once the extrusions of a support layer are generated. Schedule modulation of the support layers waiting for it.
+    auto layer_finished = [&object, &task_group, &window_begin, &num_pending, &modulate_layer](size_t support_layer_id) {
+        // window_begin is monotonous, thus the layers depending on support_layer_id form a continuous range.
+        for (size_t idx = support_layer_id; idx < object.support_layers().size() && window_begin[idx] <= support_layer_id; ++ idx)
+            if (num_pending[idx].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                task_group.run([idx, &modulate_layer]() { modulate_layer(idx); });
+    };
+
+    execution::parallel_for(m_object->print()->execution_policy(), tbb::blocked_range<size_t>(n_raft_layers, object.support_layers().size()),
+        [this, &object, &bottom_contacts, &top_contacts, &intermediate_layers, &interface_layers, &layer_caches, &loop_interface_processor, &layer_finished,
             infill_pattern, &bbox_object, support_density, interface_density, interface_angle, &angles, link_max_length_factor, with_sheath]
             (const tbb::blocked_range<size_t>& range) {
         // Indices of the 1st layer in their respective container at the support layer height.
@@ -3311,22 +3366,13 @@ void PrintObjectSupportMaterial::generate_toolpaths(
                     polylines           => [ map $_->unpack->polyline, @{$layer->support_fills} ],
                 );
             } */
+            // Now the support layers overlapping with this one may be modulated, possibly in parallel with the generation of the layers above.
+            layer_finished(support_layer_id);
         } // for each support_layer_id
     });
 
-    // Now modulate the support layer height in parallel.
-    tbb::parallel_for(tbb::blocked_range<size_t>(n_raft_layers, object.support_layers().size()),
-        [this, &object, &layer_caches]
-            (const tbb::blocked_range<size_t>& range) {
-        for (size_t support_layer_id = range.begin(); support_layer_id < range.end(); ++ support_layer_id) {
-            SupportLayer &support_layer = *object.support_layers()[support_layer_id];
-            LayerCache   &layer_cache   = layer_caches[support_layer_id];
-            for (LayerCacheItem &layer_cache_item : layer_cache.overlaps) {
-                modulate_extrusion_by_overlapping_layers(layer_cache_item.layer_extruded->extrusions, *layer_cache_item.layer_extruded->layer, layer_cache_item.overlapping);
-                support_layer.support_fills.append(std::move(layer_cache_item.layer_extruded->extrusions));
-            }
-        }
-    });
+    // Wait for the raft layers and for the modulation of the support layer heights.
+    task_group.wait();
 }
 
 /*
@@ -13,6 +13,7 @@
 #include <tbb/task_scheduler_init.h>
 
 
+#include "Execution.hpp"
 #include "Thread.hpp"
 
 namespace Slic3r {
@@ -195,7 +196,8 @@ void name_tbb_thread_pool_threads()
 	initialized = true;
 
 	const size_t nthreads_hw = std::thread::hardware_concurrency();
-	size_t 		 nthreads    = nthreads_hw;
+	// Respect the process wide thread limit, otherwise the tasks below would wait for threads which are never spawned.
+	size_t 		 nthreads    = execution::max_threads();
 
 #ifdef SLIC3R_PROFILE
 	// Shiny profiler is not thread safe, thus disable parallelization.
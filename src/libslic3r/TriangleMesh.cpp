@@ -12,6 +12,7 @@
 #include <set>
 #include <vector>
 #include <map>
+#include <tuple>
 #include <utility>
 #include <algorithm>
 #include <math.h>
@@ -837,8 +838,17 @@ void TriangleMeshSlicer::slice(const std::vector<float> &z, SlicingMode mode, st
                 if ((line_idx & 0x0ffff) == 0)
                     throw_on_cancel();
 
+                // The lines were collected in the order the slicing threads finished the facets.
+                // In the deterministic mode, sort them, so that the loops are chained the same way independently of the thread scheduling.
+                IntersectionLines &layer_lines = lines[line_idx];
+                if (m_deterministic)
+                    std::sort(layer_lines.begin(), layer_lines.end(), [](const IntersectionLine &l1, const IntersectionLine &l2) {
+                        return std::make_tuple(l1.edge_a_id, l1.edge_b_id, l1.a_id, l1.b_id, l1.a.x(), l1.a.y(), l1.b.x(), l1.b.y(), l1.edge_type, l1.flags) <
+                               std::make_tuple(l2.edge_a_id, l2.edge_b_id, l2.a_id, l2.b_id, l2.a.x(), l2.a.y(), l2.b.x(), l2.b.y(), l2.edge_type, l2.flags);
+                    });
+
                 Polygons &polygons = (*layers)[line_idx];
-                this->make_loops(lines[line_idx], &polygons);
+                this->make_loops(layer_lines, &polygons);
 
                 if (! polygons.empty()) {
                     if (mode == SlicingMode::Positive) {
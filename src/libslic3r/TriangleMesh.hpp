@@ -190,6 +190,8 @@ public:
         const float min_z, const float max_z, IntersectionLine *line_out) const;
     void cut(float z, TriangleMesh* upper, TriangleMesh* lower) const;
     void set_up_direction(const Vec3f& up);
+    // Chain the loops independently of the thread scheduling, see ExecutionPolicy::deterministic.
+    void set_deterministic(bool deterministic) { m_deterministic = deterministic; }
     
 private:
     const TriangleMesh      *mesh;
@@ -201,6 +203,8 @@ private:
     Eigen::Quaternion<float, Eigen::DontAlign> m_quaternion;
     // Whether or not the above quaterion should be used
     bool                     m_use_quaternion = false;
+    // Whether or not the intersection lines should be sorted before chaining them into loops
+    bool                     m_deterministic = false;
 
     void _slice_do(size_t facet_idx, std::vector<IntersectionLines>* lines, boost::mutex* lines_mutex, const std::vector<float> &z) const;
     void make_loops(std::vector<IntersectionLine> &lines, Polygons* loops) const;
@@ -15,6 +15,7 @@
 
 #include "libslic3r/ExtrusionEntity.hpp"
 #include "libslic3r/ExtrusionEntityCollection.hpp"
+#include "libslic3r/ExtrusionEntityFlat.hpp"
 #include "libslic3r/Geometry.hpp"
 #include "libslic3r/Print.hpp"
 #include "libslic3r/SLAPrint.hpp"
@@ -1630,6 +1631,38 @@ void _3DScene::extrusionentity_to_verts(const ExtrusionEntity *extrusion_entity,
     }
 }
 
+// Fill in the qverts and tverts with quads and triangles for the flattened extrusions.
+// Produces the same vertices as the overloads above for the source ExtrusionEntities, without traversing the tree of polymorphic objects.
+void _3DScene::extrusionentity_to_verts(const ExtrusionEntitiesFlat &extrusions, float print_z, const Point &copy, GLVolume &volume)
+{
+    Lines               lines;
+    std::vector<double> widths;
+    std::vector<double> heights;
+    for (const ExtrusionEntitiesFlat::Entity &entity : extrusions.entities()) {
+        lines.clear();
+        widths.clear();
+        heights.clear();
+        for (uint32_t idx_path = entity.path_begin; idx_path < entity.path_end; ++ idx_path) {
+            ExtrusionEntitiesFlat::PathView path = extrusions.path(idx_path);
+            if (path.points_begin == path.points_end)
+                continue;
+            size_t num_lines_old = lines.size();
+            // Skip the duplicate points the same way Polyline::remove_duplicate_points() does.
+            Point  prev = *path.points_begin + copy;
+            for (const Point *pt = path.points_begin + 1; pt != path.points_end; ++ pt) {
+                Point next = *pt + copy;
+                if (next != prev) {
+                    lines.emplace_back(prev, next);
+                    prev = next;
+                }
+            }
+            widths.insert(widths.end(), lines.size() - num_lines_old, path.width);
+            heights.insert(heights.end(), lines.size() - num_lines_old, path.height);
+        }
+        thick_lines_to_verts(lines, widths, heights, entity.is_loop(), print_z, volume);
+    }
+}
+
 void _3DScene::polyline3_to_verts(const Polyline3& polyline, double width, double height, GLVolume& volume)
 {
     Lines3 lines = polyline.lines();
@@ -8,6 +8,7 @@
 #include "libslic3r/GCode/ThumbnailData.hpp"
 #include "libslic3r/Geometry.hpp"
 #include "libslic3r/ExtrusionEntity.hpp"
+#include "libslic3r/ExtrusionEntityFlat.hpp"
 #include "libslic3r/Layer.hpp"
 #include "libslic3r/Utils.hpp"
 #include "libslic3r/Technologies.hpp"
@@ -5881,6 +5882,15 @@ void GLCanvas3D::_load_print_object_toolpaths(const PrintObject& print_object, c
         for (GLVolume *vol : vols)
 			// Reserving number of vertices (3x position + 3x color)
         	vol->indexed_vertex_array.reserve(VERTEX_BUFFER_RESERVE_SIZE / 6);
+        // Flattened extrusions of a single layer, reused for all the layers of this range to avoid repeated allocation.
+        struct RegionExtrusions {
+            ExtrusionEntitiesFlat perimeters;
+            ExtrusionEntitiesFlat infill;
+            ExtrusionEntitiesFlat solid_infill;
+        };
+        std::vector<RegionExtrusions> region_extrusions;
+        ExtrusionEntitiesFlat         support_extrusions;
+        ExtrusionEntitiesFlat         support_interface_extrusions;
         for (size_t idx_layer = range.begin(); idx_layer < range.end(); ++ idx_layer) {
             const Layer *layer = ctxt.layers[idx_layer];
 
@@ -5909,9 +5919,37 @@ void GLCanvas3D::_load_print_object_toolpaths(const PrintObject& print_object, c
                     vol->offsets.emplace_back(vol->indexed_vertex_array.quad_indices.size());
                     vol->offsets.emplace_back(vol->indexed_vertex_array.triangle_indices.size());
                 }
+            // Flatten the extrusions of this layer once, so that they are not traversed again for each instance.
+            region_extrusions.resize(layer->regions().size());
+            for (size_t idx_region = 0; idx_region < layer->regions().size(); ++ idx_region) {
+                const LayerRegion *layerm  = layer->regions()[idx_region];
+                RegionExtrusions  &region  = region_extrusions[idx_region];
+                region.perimeters.clear();
+                region.infill.clear();
+                region.solid_infill.clear();
+                if (ctxt.has_perimeters)
+                    region.perimeters.append(layerm->perimeters);
+                if (ctxt.has_infill) {
+                    for (const ExtrusionEntity *ee : layerm->fills.entities) {
+                        // fill represents infill extrusions of a single island.
+                        const auto *fill = dynamic_cast<const ExtrusionEntityCollection*>(ee);
+                        if (! fill->entities.empty())
+                            (is_solid_infill(fill->entities.front()->role()) ? region.solid_infill : region.infill).append(*fill);
+                    }
+                }
+            }
+            const SupportLayer *support_layer = ctxt.has_support ? dynamic_cast<const SupportLayer*>(layer) : nullptr;
+            support_extrusions.clear();
+            support_interface_extrusions.clear();
+            if (support_layer) {
+                for (const ExtrusionEntity *extrusion_entity : support_layer->support_fills.entities)
+                    ((extrusion_entity->role() == erSupportMaterial) ? support_extrusions : support_interface_extrusions).append(*extrusion_entity);
+            }
             for (const PrintInstance &instance : *ctxt.shifted_copies) {
                 const Point &copy = instance.shift;
-                for (const LayerRegion *layerm : layer->regions()) {
+                for (size_t idx_region = 0; idx_region < layer->regions().size(); ++ idx_region) {
+                    const LayerRegion      *layerm = layer->regions()[idx_region];
+                    const RegionExtrusions &region = region_extrusions[idx_region];
                     if (is_selected_separate_extruder)
                     {
                         const PrintRegionConfig& cfg = layerm->region()->config();
@@ -5920,34 +5958,23 @@ void GLCanvas3D::_load_print_object_toolpaths(const PrintObject& print_object, c
                             cfg.solid_infill_extruder.value != m_selected_extruder)
                             continue;
                     }
-                    if (ctxt.has_perimeters)
-                        _3DScene::extrusionentity_to_verts(layerm->perimeters, float(layer->print_z), copy,
+                    if (! region.perimeters.empty())
+                        _3DScene::extrusionentity_to_verts(region.perimeters, float(layer->print_z), copy,
                         	volume(idx_layer, layerm->region()->config().perimeter_extruder.value, 0));
-                    if (ctxt.has_infill) {
-                        for (const ExtrusionEntity *ee : layerm->fills.entities) {
-                            // fill represents infill extrusions of a single island.
-                            const auto *fill = dynamic_cast<const ExtrusionEntityCollection*>(ee);
-                            if (! fill->entities.empty())
-                                _3DScene::extrusionentity_to_verts(*fill, float(layer->print_z), copy,
-	                                volume(idx_layer, 
-		                                is_solid_infill(fill->entities.front()->role()) ?
-			                                layerm->region()->config().solid_infill_extruder :
-			                                layerm->region()->config().infill_extruder,
-		                                1));
-                        }
-                    }
+                    if (! region.infill.empty())
+                        _3DScene::extrusionentity_to_verts(region.infill, float(layer->print_z), copy,
+                            volume(idx_layer, layerm->region()->config().infill_extruder, 1));
+                    if (! region.solid_infill.empty())
+                        _3DScene::extrusionentity_to_verts(region.solid_infill, float(layer->print_z), copy,
+                            volume(idx_layer, layerm->region()->config().solid_infill_extruder, 1));
                 }
-                if (ctxt.has_support) {
-                    const SupportLayer *support_layer = dynamic_cast<const SupportLayer*>(layer);
-                    if (support_layer) {
-                        for (const ExtrusionEntity *extrusion_entity : support_layer->support_fills.entities)
-                            _3DScene::extrusionentity_to_verts(extrusion_entity, float(layer->print_z), copy,
-	                            volume(idx_layer, 
-		                            (extrusion_entity->role() == erSupportMaterial) ?
-			                            support_layer->object()->config().support_material_extruder :
-			                            support_layer->object()->config().support_material_interface_extruder,
-		                            2));
-                    }
+                if (support_layer) {
+                    if (! support_extrusions.empty())
+                        _3DScene::extrusionentity_to_verts(support_extrusions, float(layer->print_z), copy,
+                            volume(idx_layer, support_layer->object()->config().support_material_extruder, 2));
+                    if (! support_interface_extrusions.empty())
+                        _3DScene::extrusionentity_to_verts(support_interface_extrusions, float(layer->print_z), copy,
+                            volume(idx_layer, support_layer->object()->config().support_material_interface_extruder, 2));
                 }
             }
             // Ensure that no volume grows over the limits. If the volume is too large, allocate a new one.
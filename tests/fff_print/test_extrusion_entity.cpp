@@ -4,6 +4,7 @@
 
 #include "libslic3r/ExtrusionEntityCollection.hpp"
 #include "libslic3r/ExtrusionEntity.hpp"
+#include "libslic3r/ExtrusionEntityFlat.hpp"
 #include "libslic3r/Point.hpp"
 #include "libslic3r/libslic3r.h"
 
@@ -83,3 +84,44 @@ SCENARIO("ExtrusionEntityCollection: Polygon flattening", "[ExtrusionEntity]") {
         }
     }
 }
+
+SCENARIO("ExtrusionEntitiesFlat: Flattening of an extrusion tree", "[ExtrusionEntity]") {
+    srand(0xDEADBEEF); // consistent seed for test reproducibility.
+
+    GIVEN("A collection of paths, a loop and a nested collection") {
+        Slic3r::ExtrusionEntityCollection sub;
+        sub.append(random_paths(3, 5));
+        Slic3r::ExtrusionEntityCollection sample;
+        sample.append(random_paths(4, 7));
+        sample.append(ExtrusionLoop(random_paths(2, 6), elrContourInternalPerimeter));
+        sample.append(sub);
+
+        WHEN("The collection is flattened") {
+            ExtrusionEntitiesFlat flat(sample);
+            THEN("All the paths and points are stored") {
+                REQUIRE(flat.num_entities() == 4 + 1 + 3);
+                REQUIRE(flat.num_paths() == 4 + 2 + 3);
+                REQUIRE(flat.num_points() == 4 * 7 + 2 * 6 + 3 * 5);
+            }
+            THEN("The loop keeps its paths and loop role") {
+                const ExtrusionEntitiesFlat::Entity &loop = flat.entity(4);
+                REQUIRE(loop.is_loop());
+                REQUIRE(loop.num_paths() == 2);
+                REQUIRE(loop.loop_role == elrContourInternalPerimeter);
+            }
+            AND_THEN("The paths converted back match the source paths") {
+                ExtrusionEntityCollection out;
+                flat.to_extrusion_entity_collection(out);
+                ExtrusionEntityCollection src = sample.flatten();
+                REQUIRE(out.entities.size() == src.entities.size());
+                for (size_t i = 0; i < src.entities.size(); ++ i) {
+                    CHECK(out.entities[i]->role() == src.entities[i]->role());
+                    CHECK(out.entities[i]->is_loop() == src.entities[i]->is_loop());
+                    CHECK(out.entities[i]->as_polylines().size() == src.entities[i]->as_polylines().size());
+                    CHECK(out.entities[i]->first_point() == src.entities[i]->first_point());
+                    CHECK(out.entities[i]->min_mm3_per_mm() == src.entities[i]->min_mm3_per_mm());
+                }
+            }
+        }
+    }
+}
@@ -5,6 +5,7 @@
 
 #include "libslic3r/ClipperUtils.hpp"
 #include "libslic3r/Fill/Fill.hpp"
+#include "libslic3r/Fill/FillGyroid.hpp"
 #include "libslic3r/Flow.hpp"
 #include "libslic3r/Geometry.hpp"
 #include "libslic3r/Print.hpp"
@@ -190,6 +191,246 @@ TEST_CASE("Fill: Pattern Path Length", "[Fill]") {
     }
 }
 
+TEST_CASE("Fill: Monotonic ordering engines", "[Fill]") {
+    // Perforated square, which splits the monotonic infill into many regions.
+    ExPolygon expolygon(Polygon { Point::new_scale(0, 0), Point::new_scale(40, 0), Point::new_scale(40, 40), Point::new_scale(0, 40) });
+    for (int i = 0; i < 6; ++ i)
+        for (int j = 0; j < 6; ++ j) {
+            Polygon hole { Point::new_scale(0, 0), Point::new_scale(0, 2), Point::new_scale(2, 2), Point::new_scale(2, 0) };
+            hole.translate(Point::new_scale(4 + 6 * i, 4 + 6 * j));
+            expolygon.holes.emplace_back(std::move(hole));
+        }
+    Surface surface(stTop, expolygon);
+
+    auto fill = [&surface](MonotonicOrdering ordering) {
+        std::unique_ptr<Slic3r::Fill> filler(Slic3r::Fill::new_from_type(ipMonotonic));
+        filler->bounding_box = get_extents(surface.expolygon.contour);
+        filler->angle        = float(PI / 4.);
+        filler->spacing      = 0.5;
+        FillParams fill_params;
+        fill_params.density            = 1.f;
+        fill_params.monotonic          = true;
+        fill_params.monotonic_ordering = ordering;
+        return filler->fill_surface(&surface, fill_params);
+    };
+    auto travel_length = [](const Polylines &paths) {
+        double length = 0.;
+        for (size_t i = 1; i < paths.size(); ++ i)
+            length += (paths[i].first_point() - paths[i - 1].last_point()).cast<double>().norm();
+        return length;
+    };
+    auto extrusion_length = [](const Polylines &paths) {
+        return std::accumulate(paths.begin(), paths.end(), 0., [](double l, const Polyline &pl) { return l + pl.length(); });
+    };
+
+    Polylines ant_colony   = fill(MonotonicOrdering::AntColony);
+    Polylines local_search = fill(MonotonicOrdering::LocalSearch);
+    REQUIRE(! ant_colony.empty());
+    REQUIRE(! local_search.empty());
+    // paths don't cross the holes
+    REQUIRE(diff_pl(local_search, offset(expolygon, float(SCALED_EPSILON * 10))).empty());
+    // both engines extrude the same lines, they only differ in the links along the perimeters
+    REQUIRE(extrusion_length(local_search) == Approx(extrusion_length(ant_colony)).epsilon(0.05));
+    // similar travel length
+    REQUIRE(travel_length(local_search) < 1.5 * travel_length(ant_colony) + scale_(5.));
+    // the local search is deterministic
+    Polylines local_search2 = fill(MonotonicOrdering::LocalSearch);
+    REQUIRE(local_search2.size() == local_search.size());
+    for (size_t i = 0; i < local_search.size(); ++ i)
+        REQUIRE(local_search2[i].points == local_search[i].points);
+}
+
+TEST_CASE("Fill: Pattern cache", "[Fill]") {
+    ExPolygon expolygon(Polygon { Point::new_scale(0, 0), Point::new_scale(80, 0), Point::new_scale(80, 60), Point::new_scale(0, 60) });
+    expolygon.holes.emplace_back(Polygon { Point::new_scale(20, 20), Point::new_scale(20, 40), Point::new_scale(40, 40), Point::new_scale(40, 20) });
+    Surface surface(stInternal, expolygon);
+
+    FillPatternCache cache;
+    for (size_t layer_id = 0; layer_id < 6; ++ layer_id) {
+        auto fill = [&](FillPatternCache *pattern_cache) {
+            std::unique_ptr<Slic3r::Fill> filler(Slic3r::Fill::new_from_type(ipHoneycomb));
+            filler->bounding_box  = get_extents(expolygon.contour);
+            filler->layer_id      = layer_id;
+            filler->z             = 0.2 * double(layer_id + 1);
+            filler->angle         = float(PI / 4.);
+            filler->spacing       = 0.45;
+            filler->pattern_cache = pattern_cache;
+            FillParams fill_params;
+            fill_params.density = 0.2f;
+            return filler->fill_surface(&surface, fill_params);
+        };
+        Polylines uncached = fill(nullptr);
+        Polylines cached   = fill(&cache);
+        REQUIRE(cached.size() == uncached.size());
+        for (size_t i = 0; i < cached.size(); ++ i)
+            REQUIRE(cached[i].points == uncached[i].points);
+    }
+    // The honeycomb pattern does not depend on Z, it repeats with the infill direction every third layer.
+    REQUIRE(cache.misses() == 3);
+    REQUIRE(cache.hits() == 3);
+}
+
+// The gyroid wave generator as it was before the horizontal waves were generated transposed, as a reference.
+namespace gyroid_reference {
+
+static double f(double x, double z_sin, double z_cos, bool vertical, bool flip)
+{
+    if (vertical) {
+        double phase_offset = (z_cos < 0 ? M_PI : 0) + M_PI;
+        double a   = sin(x + phase_offset);
+        double b   = - z_cos;
+        double res = z_sin * cos(x + phase_offset + (flip ? M_PI : 0.));
+        double r   = sqrt(sqr(a) + sqr(b));
+        return asin(a/r) + asin(res/r) + M_PI;
+    } else {
+        double phase_offset = z_sin < 0 ? M_PI : 0.;
+        double a   = cos(x + phase_offset);
+        double b   = - z_sin;
+        double res = z_cos * sin(x + phase_offset + (flip ? 0 : M_PI));
+        double r   = sqrt(sqr(a) + sqr(b));
+        return (asin(a/r) + asin(res/r) + 0.5 * M_PI);
+    }
+}
+
+static Polyline make_wave(const std::vector<Vec2d> &one_period, double width, double height, double offset, double scaleFactor,
+                          double z_cos, double z_sin, bool vertical, bool flip)
+{
+    std::vector<Vec2d> points = one_period;
+    double period = points.back()(0);
+    if (width != period) {
+        points.pop_back();
+        size_t n = points.size();
+        do {
+            points.emplace_back(points[points.size()-n].x() + period, points[points.size()-n].y());
+        } while (points.back()(0) < width - EPSILON);
+        points.emplace_back(Vec2d(width, f(width, z_sin, z_cos, vertical, flip)));
+    }
+
+    Polyline polyline;
+    for (Vec2d &point : points) {
+        point(1) += offset;
+        point(1) = clamp(0., height, double(point(1)));
+        if (vertical)
+            std::swap(point(0), point(1));
+        polyline.points.emplace_back((point * scaleFactor).cast<coord_t>());
+    }
+    return polyline;
+}
+
+static std::vector<Vec2d> make_one_period(double width, double z_cos, double z_sin, bool vertical, bool flip, double tolerance)
+{
+    std::vector<Vec2d> points;
+    double limit = std::min(2*M_PI, width);
+    for (double x = 0.; x < limit - EPSILON; x += M_PI_2)
+        points.emplace_back(Vec2d(x, f(x, z_sin, z_cos, vertical, flip)));
+    points.emplace_back(Vec2d(limit, f(limit, z_sin, z_cos, vertical, flip)));
+
+    // Refine all the segments until none of them is split, then sort the new points in.
+    for (;;) {
+        size_t size = points.size();
+        for (size_t i = 1; i < size; ++ i) {
+            Vec2d  lp = points[i - 1];
+            Vec2d  rp = points[i];
+            double x  = lp(0) + (rp(0) - lp(0)) / 2;
+            Vec2d  ip = { x, f(x, z_sin, z_cos, vertical, flip) };
+            if (std::abs(cross2(Vec2d(ip - lp), Vec2d(ip - rp))) > sqr(tolerance))
+                points.emplace_back(ip);
+        }
+        if (size == points.size())
+            break;
+        std::sort(points.begin(), points.end(), [](const Vec2d &lhs, const Vec2d &rhs) { return lhs(0) < rhs(0); });
+    }
+    return points;
+}
+
+static Polylines make_gyroid_waves(double gridZ, double density_adjusted, double line_spacing, double width, double height)
+{
+    const double scaleFactor = scale_(line_spacing) / density_adjusted;
+    const double tolerance   = std::min(line_spacing / 2, FillGyroid::PatternTolerance) / unscale<double>(scaleFactor);
+    const double z     = gridZ / scaleFactor;
+    const double z_sin = sin(z);
+    const double z_cos = cos(z);
+
+    bool   vertical    = (std::abs(z_sin) <= std::abs(z_cos));
+    double lower_bound = 0.;
+    double upper_bound = height;
+    bool   flip        = true;
+    if (vertical) {
+        flip        = false;
+        lower_bound = -M_PI;
+        upper_bound = width - M_PI_2;
+        std::swap(width, height);
+    }
+
+    std::vector<Vec2d> one_period_odd  = make_one_period(width, z_cos, z_sin, vertical, flip, tolerance);
+    flip = ! flip;
+    std::vector<Vec2d> one_period_even = make_one_period(width, z_cos, z_sin, vertical, flip, tolerance);
+    Polylines result;
+    for (double y0 = lower_bound; y0 < upper_bound + EPSILON; y0 += M_PI) {
+        result.emplace_back(make_wave(one_period_odd, width, height, y0, scaleFactor, z_cos, z_sin, vertical, flip));
+        y0 += M_PI;
+        if (y0 < upper_bound + EPSILON)
+            result.emplace_back(make_wave(one_period_even, width, height, y0, scaleFactor, z_cos, z_sin, vertical, flip));
+    }
+    return result;
+}
+
+// The gyroid lines of a region clipped with the reference generator, the same way as FillGyroid does with the infill lines
+// not connected and the infill angle zero.
+static Polylines fill(const ExPolygon &expolygon, double z, double spacing, double density)
+{
+    BoundingBox bb               = expolygon.contour.bounding_box();
+    double      density_adjusted = density * FillGyroid::DensityAdjust;
+    coord_t     distance         = coord_t(scale_(spacing) / density_adjusted);
+    bb.merge(Fill::_align_to_grid(bb.min, Point(2*M_PI*distance, 2*M_PI*distance)));
+
+    Polylines polylines = make_gyroid_waves(scale_(z), density_adjusted, spacing, ceil(bb.size()(0) / distance) + 1., ceil(bb.size()(1) / distance) + 1.);
+    for (Polyline &pl : polylines)
+        pl.translate(bb.min);
+    polylines = intersection_pl(polylines, to_polygons(expolygon));
+
+    const double minlength = scale_(0.8 * spacing);
+    polylines.erase(std::remove_if(polylines.begin(), polylines.end(), [minlength](const Polyline &pl) { return pl.length() < minlength; }), polylines.end());
+    return polylines;
+}
+
+} // namespace gyroid_reference
+
+TEST_CASE("Fill: Gyroid waves match the reference generator", "[Fill]") {
+    ExPolygon expolygon(Polygon { Point::new_scale(0, 0), Point::new_scale(80, 0), Point::new_scale(80, 60), Point::new_scale(0, 60) });
+    expolygon.holes.emplace_back(Polygon { Point::new_scale(20, 20), Point::new_scale(20, 40), Point::new_scale(40, 40), Point::new_scale(40, 20) });
+    Surface surface(stInternal, expolygon);
+
+    const double spacing   = 0.45;
+    const float  density   = 0.2f;
+    // Z of a quarter of the pattern period in Z, where the waves are horizontal, thus generated transposed,
+    // and Z of the pattern period, where the waves are vertical.
+    const double period_z  = 2. * PI * spacing / (double(density) * FillGyroid::DensityAdjust);
+    for (double z : { 0.25 * period_z, period_z }) {
+        std::unique_ptr<Slic3r::Fill> filler(Slic3r::Fill::new_from_type(ipGyroid));
+        filler->bounding_box = get_extents(expolygon.contour);
+        filler->z            = z;
+        // Cancel the correction angle of the gyroid, so that the region is not rotated.
+        filler->angle        = float(- FillGyroid::CorrectionAngle * PI / 180.);
+        filler->spacing      = spacing;
+        FillParams fill_params;
+        fill_params.density           = density;
+        fill_params.anchor_length_max = 0.f;
+        Polylines polylines = filler->fill_surface(&surface, fill_params);
+
+        ExPolygons regions = offset_ex(expolygon, - float(scale_(0.5 * spacing)));
+        REQUIRE(regions.size() == 1);
+        Polylines reference = gyroid_reference::fill(regions.front(), z, spacing, density);
+
+        // The same lines, up to the order and the direction of the polylines and the rounding of the clipping.
+        INFO("z " << z);
+        REQUIRE(! polylines.empty());
+        REQUIRE(total_length(polylines) == Approx(total_length(reference)).epsilon(1e-5));
+        REQUIRE(diff_pl(polylines, offset(reference, float(SCALED_EPSILON))).empty());
+        REQUIRE(diff_pl(reference, offset(polylines, float(SCALED_EPSILON))).empty());
+    }
+}
+
 /*
 {
     my $collection = Slic3r::Polyline::Collection->new(
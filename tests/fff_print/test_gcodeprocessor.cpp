@@ -0,0 +1,117 @@
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include <boost/filesystem.hpp>
+#include <boost/nowide/cstdio.hpp>
+
+#include "libslic3r/GCode/GCodeProcessor.hpp"
+
+#include "test_data.hpp"
+
+using namespace Slic3r;
+using namespace Slic3r::Test;
+
+static std::string read_file(const std::string &path)
+{
+    std::ifstream ifs(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+}
+
+// The exported G-code with the lines written by the time estimate post-processing turned back into the placeholders,
+// which GCode writes for the post-processing.
+static std::string unprocessed_gcode(const std::string &exported)
+{
+    std::istringstream iss(exported);
+    std::string        out;
+    std::string        line;
+    bool               first_line = true;
+    while (std::getline(iss, line)) {
+        if (line.rfind("M73 ", 0) == 0 || line.rfind("; estimated printing time", 0) == 0)
+            continue;
+        out += line + "\n";
+        if (first_line) {
+            out += GCodeProcessor::First_Line_M73_Placeholder_Tag + "\n";
+            first_line = false;
+        }
+    }
+    out += GCodeProcessor::Last_Line_M73_Placeholder_Tag + "\n";
+    out += GCodeProcessor::Estimated_Printing_Time_Placeholder_Tag + "\n";
+    return out;
+}
+
+static void init_processor(GCodeProcessor &processor, const PrintConfig &config)
+{
+    processor.reset();
+    processor.apply_config(config);
+    processor.enable_stealth_time_estimator(true);
+}
+
+SCENARIO("Streaming the G-code into GCodeProcessor gives the same result as processing the G-code file", "[GCodeProcessor]") {
+    GIVEN("The G-code of a cube printed by Marlin with the remaining times and the silent mode") {
+        Print print;
+        Model model;
+        init_print({ TestMesh::cube_20x20x20 }, print, model, {
+            { "gcode_flavor",       "marlin" },
+            { "remaining_times",    true },
+            { "silent_mode",        true }
+        });
+        const std::string gcode     = unprocessed_gcode(Test::gcode(print));
+        const std::string path_file = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+        const std::string path_streamed = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+        {
+            std::ofstream ofs(path_file, std::ios::binary);
+            ofs << gcode;
+        }
+        GCodeProcessor processor_file;
+        init_processor(processor_file, print.config());
+        processor_file.process_file(path_file, true);
+
+        GCodeProcessor processor_streamed;
+        init_processor(processor_streamed, print.config());
+        WHEN("The G-code is streamed in pieces of random length while being written") {
+            processor_streamed.start_streaming();
+            {
+                std::ofstream ofs(path_streamed, std::ios::binary);
+                std::mt19937  rng(0);
+                for (size_t i = 0; i < gcode.size();) {
+                    size_t      n     = std::min<size_t>(gcode.size() - i, 1 + rng() % 200);
+                    std::string piece = gcode.substr(i, n);
+                    ofs << piece;
+                    processor_streamed.process_buffer(piece.c_str());
+                    i += n;
+                }
+            }
+            processor_streamed.finish_streaming(path_streamed, true);
+            THEN("The post-processed files are identical, including the lines M73 and the estimated printing times") {
+                std::string processed = read_file(path_file);
+                REQUIRE(processed.find("M73 P") != std::string::npos);
+                REQUIRE(processed.find("M73 Q") != std::string::npos);
+                REQUIRE(processed.find("; estimated printing time (silent mode)") != std::string::npos);
+                REQUIRE(processed.find("_GP_") == std::string::npos);
+                REQUIRE(read_file(path_streamed) == processed);
+            }
+            THEN("The estimated printing times are identical") {
+                for (auto mode : { PrintEstimatedTimeStatistics::ETimeMode::Normal, PrintEstimatedTimeStatistics::ETimeMode::Stealth })
+                    REQUIRE(processor_streamed.get_time(mode) == processor_file.get_time(mode));
+            }
+        }
+        WHEN("The print is canceled while the G-code is being streamed") {
+            bool canceled = false;
+            processor_streamed.start_streaming([&canceled]() { if (canceled) throw CanceledException(); });
+            THEN("The cancel callback is called") {
+                processor_streamed.process_buffer(gcode.substr(0, gcode.size() / 2).c_str());
+                canceled = true;
+                // The cancel callback is called at most every 100 ms.
+                std::this_thread::sleep_for(std::chrono::milliseconds(150));
+                REQUIRE_THROWS_AS(processor_streamed.process_buffer(gcode.substr(gcode.size() / 2).c_str()), CanceledException);
+            }
+        }
+        boost::nowide::remove(path_file.c_str());
+        boost::nowide::remove(path_streamed.c_str());
+    }
+}
@@ -1,6 +1,11 @@
 #include <catch2/catch.hpp>
 
+#include <iomanip>
+#include <limits>
 #include <memory>
+#include <random>
+#include <sstream>
+#include <type_traits>
 
 #include "libslic3r/GCodeWriter.hpp"
 
@@ -94,3 +99,49 @@ SCENARIO("set_speed emits values with fixed-point output.", "[GCodeWriter]") {
         }
     }
 }
+
+SCENARIO("GCodeFormatter emits the same numbers as std::fixed with std::setprecision.", "[GCodeWriter]") {
+    auto stream_fixed = [](double value, int digits) {
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(digits) << value;
+        return ss.str();
+    };
+    auto formatter_fixed = [](double value, int digits) {
+        std::string out;
+        GCodeFormatter::append_fixed(out, value, digits);
+        return out;
+    };
+    GIVEN("Values at the rounding ties, negative values rounding to zero and out of range values") {
+        std::vector<double> values { 0., -0., 0.5, 1.5, 2.5, -2.5, 0.0005, 0.0015, 2.0005, 0.0625, -0.00001, 0.000005,
+                                     99999.123, 203.200522, 4503599627370495., 1e300, std::numeric_limits<double>::infinity() };
+        THEN("The output matches the stream output for 3 and 5 decimal digits") {
+            for (double v : values)
+                for (int digits : { 0, 3, 5 })
+                    REQUIRE(formatter_fixed(v, digits) == stream_fixed(v, digits));
+        }
+    }
+    GIVEN("Random coordinates and extrusion values") {
+        std::mt19937_64 rng(0);
+        std::uniform_real_distribution<double> dist(-1000., 1000.);
+        THEN("The output matches the stream output for 3 and 5 decimal digits") {
+            for (size_t i = 0; i < 10000; ++ i) {
+                double v = dist(rng);
+                REQUIRE(formatter_fixed(v, 3) == stream_fixed(v, 3));
+                REQUIRE(formatter_fixed(v, 5) == stream_fixed(v, 5));
+            }
+        }
+    }
+}
+
+template<typename T, typename = void>
+struct can_write_to_formatter : std::false_type {};
+template<typename T>
+struct can_write_to_formatter<T, std::void_t<decltype(std::declval<GCodeFormatter&>() << std::declval<T>())>> : std::true_type {};
+
+// Numbers shall only be written through GCodeFormatter::fixed(), not silently converted to a char.
+static_assert(can_write_to_formatter<char>::value, "GCodeFormatter shall accept a char");
+static_assert(can_write_to_formatter<const char*>::value, "GCodeFormatter shall accept a C string");
+static_assert(can_write_to_formatter<GCodeFormatter::Fixed>::value, "GCodeFormatter shall accept a fixed precision number");
+static_assert(! can_write_to_formatter<int>::value, "GCodeFormatter shall not accept an int");
+static_assert(! can_write_to_formatter<unsigned int>::value, "GCodeFormatter shall not accept an unsigned int");
+static_assert(! can_write_to_formatter<double>::value, "GCodeFormatter shall not accept a double");
@@ -1,6 +1,7 @@
 #include <catch2/catch.hpp>
 
 #include "libslic3r/libslic3r.h"
+#include "libslic3r/Execution.hpp"
 #include "libslic3r/Print.hpp"
 #include "libslic3r/Layer.hpp"
 
@@ -126,3 +127,51 @@ SCENARIO("Print: Brim generation", "[Print]") {
         }
     }
 }
+
+// G-code of the wipe tower of two cubes of different heights printed with two extruders.
+static std::string wipe_tower_gcode(size_t max_threads)
+{
+    DynamicPrintConfig config = DynamicPrintConfig::full_print_config();
+    config.set_deserialize({
+        { "nozzle_diameter",    "0.4, 0.4" },
+        { "wipe_tower",         true },
+        { "layer_height",       0.2 },
+        { "first_layer_height", 0.2 }
+    });
+    TriangleMesh tall_cube = make_cube(10., 10., 10.);
+    TriangleMesh low_cube  = make_cube(10., 10., 4.);
+    Slic3r::Print print;
+    Slic3r::Model model;
+    Slic3r::Test::init_print({ tall_cube, low_cube }, print, model, config);
+    model.objects.back()->config.set_deserialize("extruder", "2");
+    print.apply(model, config);
+    ExecutionPolicy policy;
+    policy.max_threads   = max_threads;
+    policy.deterministic = true;
+    print.set_execution_policy(policy);
+    print.process();
+    const WipeTowerData &wipe_tower_data = print.wipe_tower_data();
+    std::string gcode;
+    for (const std::vector<WipeTower::ToolChangeResult> &layer : wipe_tower_data.tool_changes)
+        for (const WipeTower::ToolChangeResult &tool_change : layer)
+            gcode += tool_change.gcode;
+    if (wipe_tower_data.final_purge)
+        gcode += wipe_tower_data.final_purge->gcode;
+    return gcode;
+}
+
+SCENARIO("Print: Wipe tower generation", "[Print]") {
+    GIVEN("Two cubes of different heights printed with two extruders") {
+        WHEN("The wipe tower is generated by a single thread and in chunks by multiple threads") {
+            // A single thread generates the wipe tower in one go, multiple threads split it into chunks.
+            std::string serial  = wipe_tower_gcode(1);
+            std::string chunked = wipe_tower_gcode(4);
+            THEN("The wipe tower prints tool changes") {
+                REQUIRE(serial.find("; CP TOOLCHANGE START") != std::string::npos);
+            }
+            THEN("The G-code of the tool changes is identical") {
+                REQUIRE(chunked == serial);
+            }
+        }
+    }
+}
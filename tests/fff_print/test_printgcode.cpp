@@ -1,9 +1,11 @@
 #include <catch2/catch.hpp>
 
 #include "libslic3r/libslic3r.h"
+#include "libslic3r/Execution.hpp"
 #include "libslic3r/GCodeReader.hpp"
 
 #include "test_data.hpp"
+#include "test_utils.hpp"
 
 #include <algorithm>
 #include <boost/regex.hpp>
@@ -268,3 +270,42 @@ SCENARIO( "PrintGCode basic functionality", "[PrintGCode]") {
         }
     }
 }
+
+// G-code of a model from tests/data sliced in the deterministic mode with the given thread limit.
+// The header line holding the time stamp is removed.
+static std::string deterministic_gcode(const std::string &obj_filename, size_t max_threads)
+{
+    Slic3r::Print print;
+    Slic3r::Model model;
+    Slic3r::Test::init_print({ load_model(obj_filename) }, print, model, {
+        { "fill_density",                   "20%" },
+        { "support_material",               true },
+        { "skirts",                         1 },
+        { "brim_width",                     2 }
+    });
+    ExecutionPolicy policy;
+    policy.max_threads   = max_threads;
+    policy.deterministic = true;
+    print.set_execution_policy(policy);
+    std::string gcode = Slic3r::Test::gcode(print);
+    size_t header = gcode.find("; generated by ");
+    if (header != std::string::npos)
+        gcode.erase(header, gcode.find('\n', header) - header);
+    return gcode;
+}
+
+SCENARIO("PrintGCode deterministic mode", "[PrintGCode]") {
+    GIVEN("A model with many loops per layer and a model with overhangs") {
+        WHEN("each model is sliced with a single thread and with all the threads") {
+            THEN("the G-codes are identical") {
+                for (const char *obj_filename : { "extruder_idler.obj", "overhang.obj" }) {
+                    INFO(obj_filename);
+                    std::string gcode_single = deterministic_gcode(obj_filename, 1);
+                    std::string gcode_multi  = deterministic_gcode(obj_filename, execution::max_threads());
+                    REQUIRE(! gcode_single.empty());
+                    REQUIRE(gcode_single == gcode_multi);
+                }
+            }
+        }
+    }
+}
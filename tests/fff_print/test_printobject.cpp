@@ -1,6 +1,7 @@
 #include <catch2/catch.hpp>
 
 #include "libslic3r/libslic3r.h"
+#include "libslic3r/Execution.hpp"
 #include "libslic3r/Print.hpp"
 #include "libslic3r/Layer.hpp"
 
@@ -87,3 +88,104 @@ SCENARIO("PrintObject: object layer heights", "[PrintObject]") {
 #endif
     }
 }
+
+// G-code of the print with the header line holding the time stamp removed.
+static std::string gcode_without_header(Print &print)
+{
+    std::string gcode = Slic3r::Test::gcode(print);
+    size_t header = gcode.find("; generated by ");
+    if (header != std::string::npos)
+        gcode.erase(header, gcode.find('\n', header) - header);
+    return gcode;
+}
+
+// G-code of a mesh sliced from scratch with the given layer height profile.
+static std::string sliced_gcode(const TriangleMesh &mesh, const DynamicPrintConfig &config, const std::vector<coordf_t> &layer_height_profile)
+{
+    Slic3r::Print print;
+    Slic3r::Model model;
+    Slic3r::Test::init_print({ mesh }, print, model, config);
+    model.objects.front()->layer_height_profile.set(layer_height_profile);
+    print.apply(model, config);
+    ExecutionPolicy policy;
+    policy.deterministic = true;
+    print.set_execution_policy(policy);
+    return gcode_without_header(print);
+}
+
+SCENARIO("PrintObject: reslicing after a change of the layer heights", "[PrintObject]") {
+    DynamicPrintConfig config = DynamicPrintConfig::full_print_config();
+    config.set_deserialize({
+        { "first_layer_height", 0.2 },
+        { "layer_height",       0.2 },
+        { "fill_density",       "20%" },
+        { "top_solid_layers",   3 },
+        { "bottom_solid_layers", 3 },
+        { "extra_perimeters",   true },
+        { "ironing",            true }
+    });
+    GIVEN("A pyramid sliced with 0.2mm layers") {
+        Slic3r::Print print;
+        Slic3r::Model model;
+        Slic3r::Test::init_print({ TestMesh::pyramid }, print, model, config);
+        ExecutionPolicy policy;
+        policy.deterministic = true;
+        print.set_execution_policy(policy);
+        gcode_without_header(print);
+        const std::vector<Layer*> &layers = print.objects().front()->layers();
+        const Layer *bottom_layer = layers.front();
+        const Layer *top_layer    = layers.back();
+        WHEN("The layer height profile is edited in the middle of the object and the object is resliced") {
+            // Thinner layers between 10mm and 15mm.
+            std::vector<coordf_t> layer_height_profile { 0., 0.2, 10., 0.2, 10., 0.1, 15., 0.1, 15., 0.2, 40., 0.2 };
+            model.objects.front()->layer_height_profile.set(layer_height_profile);
+            print.apply(model, config);
+            std::string resliced = gcode_without_header(print);
+            THEN("The layers far from the edit are not resliced") {
+                REQUIRE(layers.front() == bottom_layer);
+                REQUIRE(layers.back() == top_layer);
+            }
+            THEN("The G-code is identical to the G-code of the pyramid sliced from scratch") {
+                REQUIRE(! resliced.empty());
+                REQUIRE(resliced == sliced_gcode(mesh(TestMesh::pyramid), config, layer_height_profile));
+            }
+            AND_WHEN("The layer height profile is reset and the object is resliced again") {
+                model.objects.front()->layer_height_profile.clear();
+                print.apply(model, config);
+                THEN("The G-code is identical to the G-code of the pyramid sliced from scratch") {
+                    REQUIRE(gcode_without_header(print) == sliced_gcode(mesh(TestMesh::pyramid), config, {}));
+                }
+            }
+        }
+    }    GIVEN("A box carrying a tower capped by a plate, sliced with 0.2mm layers") {
+        TriangleMesh box = make_cube(30., 30., 6.);
+        TriangleMesh tower = make_cube(10., 10., 14.);
+        tower.translate(10., 10., 6.);
+        box.merge(tower);
+        TriangleMesh plate = make_cube(30., 30., 2.);
+        plate.translate(0., 0., 20.);
+        box.merge(plate);
+        Slic3r::Print print;
+        Slic3r::Model model;
+        Slic3r::Test::init_print({ box }, print, model, config);
+        ExecutionPolicy policy;
+        policy.deterministic = true;
+        print.set_execution_policy(policy);
+        gcode_without_header(print);
+        const Layer *top_layer = print.objects().front()->layers().back();
+        WHEN("The layer height profile is edited just below the top solid layers of the box and the object is resliced") {
+            // Thinner layers between 4.8mm and 5.2mm, the top shells of the box reach down into them.
+            std::vector<coordf_t> layer_height_profile { 0., 0.2, 4.8, 0.2, 4.8, 0.1, 5.2, 0.1, 5.2, 0.2, 22., 0.2 };
+            model.objects.front()->layer_height_profile.set(layer_height_profile);
+            print.apply(model, config);
+            std::string resliced = gcode_without_header(print);
+            THEN("The layers far from the edit are not resliced") {
+                REQUIRE(print.objects().front()->layers().back() == top_layer);
+            }
+            THEN("The G-code is identical to the G-code of the object sliced from scratch") {
+                REQUIRE(! resliced.empty());
+                REQUIRE(resliced == sliced_gcode(box, config, layer_height_profile));
+            }
+        }
+    }
+}
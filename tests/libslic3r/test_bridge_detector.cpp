@@ -0,0 +1,75 @@
+#include <catch2/catch.hpp>
+
+#include <iterator>
+#include <random>
+
+#include "libslic3r/BridgeDetector.hpp"
+#include "libslic3r/ClipperUtils.hpp"
+
+using namespace Slic3r;
+
+static Polygon rectangle(double x0, double y0, double x1, double y1)
+{
+    return Polygon({ Point::new_scale(x0, y0), Point::new_scale(x1, y0), Point::new_scale(x1, y1), Point::new_scale(x0, y1) });
+}
+
+SCENARIO("Bridge detector matches the angles of the detector clipping the test lines with Clipper", "[BridgeDetector]") {
+    // Angles detected by the BridgeDetector clipping the test lines with Clipper and testing their end points with
+    // ExPolygon::contains(), for the bridges generated below. -1 for no bridge detected.
+    static const double expected[] = {
+        0.758583, 2.268928, 2.268928, 1.745329, 1.308997, 3.116390, 3.104216, -1.000000,
+        1.570796, 1.730038, 1.570796, 1.919862, 2.094395, 2.216225, 1.221730, 2.268928,
+        1.308997, 1.514692, 1.308997, 1.047198, 2.094395, 0.640812, 0.200969, 2.094395,
+        1.741566, 2.268928, 2.268928, 0.785398, 1.424960, 0.916155, 2.967060, 0.174533,
+        1.570796, 2.697561, 2.737198, 2.696414, 0.523599, 0.123368, 0.171310, 1.658063,
+        2.437244, 2.898235, 1.308997, 1.658063, 1.047198, 0.436332, 2.530727, 1.134464,
+    };
+    GIVEN("Rectangular bridges supported all around, from two sides, from two adjacent sides and by scattered pillars") {
+        std::mt19937 rng(5);
+        // Not std::uniform_real_distribution, its output differs between the standard libraries.
+        auto random = [&rng]() { return double(rng()) / 4294967296.; };
+        std::vector<double> angles;
+        for (size_t i = 0; i < std::size(expected); ++ i) {
+            double     w = 2. + 18. * random();
+            double     h = 2. + 18. * random();
+            double     rotation = 2. * PI * random();
+            ExPolygon  bridge(rectangle(0., 0., w, h));
+            ExPolygons lower;
+            switch (i % 4) {
+            case 0:
+                lower.emplace_back(rectangle(-2., -2., w + 2., h + 2.));
+                lower.back().holes.emplace_back(rectangle(0., 0., w, h));
+                lower.back().holes.back().reverse();
+                break;
+            case 1:
+                lower.emplace_back(rectangle(-2., 0., 0., h));
+                lower.emplace_back(rectangle(w, 0., w + 2., h));
+                break;
+            case 2:
+                lower = diff_ex(Polygons{ rectangle(-2., -2., w + 2., h + 2.) }, Polygons{ rectangle(0., 0., w + 3., h + 3.) });
+                break;
+            default:
+                for (int k = 0; k < 6; ++ k) {
+                    double    x = random() * w;
+                    double    y = random() * h;
+                    ExPolygon pillar(rectangle(- 3. * random() - 0.5, - 3. * random() - 0.5, 3. * random() + 0.5, 3. * random() + 0.5));
+                    pillar.rotate(PI * random());
+                    pillar.translate(scale_(x), scale_(y));
+                    lower.emplace_back(std::move(pillar));
+                }
+                lower = diff_ex(to_polygons(union_ex(to_polygons(lower))), Polygons{ rectangle(0.5, 0.5, w - 0.5, h - 0.5) });
+            }
+            bridge.rotate(rotation);
+            for (ExPolygon &expoly : lower)
+                expoly.rotate(rotation);
+            BridgeDetector detector(bridge, lower, scale_(0.5));
+            angles.emplace_back(detector.detect_angle() ? detector.angle : -1.);
+        }
+        THEN("The bridges are detected at the same angles") {
+            for (size_t i = 0; i < angles.size(); ++ i) {
+                INFO("Bridge " << i);
+                REQUIRE(angles[i] == Approx(expected[i]).margin(1e-5));
+            }
+        }
+    }
+}
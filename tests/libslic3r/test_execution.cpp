@@ -0,0 +1,65 @@
+#include <catch2/catch.hpp>
+
+#include <libslic3r/Execution.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace Slic3r;
+
+TEST_CASE("Parallel loop visits every index once", "[Execution]")
+{
+    ExecutionPolicy policy;
+    for (size_t grain : { size_t(0), size_t(7) })
+        for (bool deterministic : { false, true }) {
+            policy.grain_size    = grain;
+            policy.deterministic = deterministic;
+            std::vector<std::atomic<int>> visited(1000);
+            execution::run(policy, [&policy, &visited]() {
+                execution::for_each(policy, size_t(0), visited.size(), [&visited](size_t i) { ++ visited[i]; });
+            });
+            for (const std::atomic<int> &v : visited)
+                REQUIRE(v == 1);
+        }
+}
+
+TEST_CASE("Deterministic reduction does not depend on the thread count", "[Execution]")
+{
+    // Floating point summation is not associative, thus the result depends on the order of merging.
+    std::vector<double> values(100000);
+    for (size_t i = 0; i < values.size(); ++ i)
+        values[i] = std::sin(double(i)) * std::pow(10., double(i % 13));
+
+    auto sum = [&values](size_t max_threads) {
+        ExecutionPolicy policy;
+        policy.max_threads   = max_threads;
+        policy.deterministic = true;
+        double result = 0.;
+        execution::run(policy, [&]() {
+            result = execution::reduce(policy, size_t(0), values.size(), 0., std::plus<double>(),
+                                       [&values](size_t i) { return values[i]; });
+        });
+        return result;
+    };
+
+    double reference = sum(1);
+    for (size_t max_threads : { 0, 2, 3 })
+        REQUIRE(sum(max_threads) == reference);
+}
+
+TEST_CASE("Canceled parallel loop throws", "[Execution]")
+{
+    ExecutionPolicy    policy;
+    std::atomic<bool>  canceled { false };
+    policy.cancel = CancellationToken([&canceled]() { if (canceled) throw std::runtime_error("canceled"); });
+
+    std::atomic<size_t> processed { 0 };
+    REQUIRE_THROWS(execution::for_each(policy, size_t(0), size_t(10000), [&canceled, &processed](size_t i) {
+        if (i == 0)
+            canceled = true;
+        ++ processed;
+    }, 100));
+    REQUIRE(processed < 10000);
+}
@@ -62,6 +62,24 @@ SCENARIO("Placeholder parser scripting", "[PlaceholderParser]") {
     // The PlaceholderParser has no way to know which extrusion type the caller has in mind, therefore it throws.
     SECTION("first_layer_speed") { REQUIRE_THROWS(parser.process("{first_layer_speed}")); }
 
+    // Test the compiled templates against the interpreted ones.
+    auto compiled_matches = [&parser](const std::string &templ) {
+        std::string interpreted, compiled;
+        try { interpreted = parser.process(templ, 1); } catch (const std::exception &ex) { interpreted = std::string("Error: ") + ex.what(); }
+        try { compiled = parser.process(PlaceholderParser::compile(templ), 1); } catch (const std::exception &ex) { compiled = std::string("Error: ") + ex.what(); }
+        return interpreted == compiled;
+    };
+    SECTION("compiled: variables") { REQUIRE(compiled_matches("  ;LAYER [bar] {bar}\nG1 Z{bar + 1}\n[temperature] [ temperature_ [foo] ] {temperature[bar]} {first_layer_extrusion_width}")); }
+    SECTION("compiled: conditionals") { REQUIRE(compiled_matches("{if foo == 0}A{if bar == 2}B{else}C{endif}[temperature]{elsif bar == 1}D{endif} {\"}\"}{if printer_notes=~/.*MK2}*.*/}E{endif}")); }
+    SECTION("compiled: unknown variable") { REQUIRE(compiled_matches("G1 {unknown_variable}")); }
+    SECTION("compiled: unpaired endif") { REQUIRE(compiled_matches("G1 {endif}")); }
+    SECTION("compiled: processed repeatedly") {
+        PlaceholderParser::CompiledTemplate templ = PlaceholderParser::compile(";LAYER:{foo}\n[bar] {2 * foo}");
+        REQUIRE(parser.process(templ) == ";LAYER:0\n2 0");
+        parser.set("foo", 5);
+        REQUIRE(parser.process(templ) == ";LAYER:5\n2 10");
+    }
+
     // Test the boolean expression parser.
     auto boolean_expression = [&parser](const std::string& templ) { return parser.evaluate_boolean_expression(templ, parser.config()); };
 
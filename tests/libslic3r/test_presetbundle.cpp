@@ -0,0 +1,132 @@
+#include <catch2/catch.hpp>
+
+#include "libslic3r/PresetBundle.hpp"
+#include "libslic3r/Utils.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/nowide/fstream.hpp>
+
+using namespace Slic3r;
+
+static const char *test_bundle = R"(
+[vendor]
+name = Test Vendor
+config_version = 1.0.0
+
+[printer_model:TEST]
+name = Test Printer
+variants = 0.4
+technology = FFF
+default_materials = Test PLA
+
+[print:*common*]
+layer_height = 0.2
+perimeters = 3
+
+[print:Test Print]
+inherits = *common*
+perimeters = 4
+
+[filament:Test PLA]
+temperature = 215
+
+[printer:Test Printer]
+printer_model = TEST
+printer_variant = 0.4
+nozzle_diameter = 0.4
+)";
+
+// Returns the one file in the cache directory.
+static boost::filesystem::path cache_file(const boost::filesystem::path &cache_dir)
+{
+    std::vector<boost::filesystem::path> files;
+    for (const auto &entry : boost::filesystem::directory_iterator(cache_dir))
+        files.emplace_back(entry.path());
+    REQUIRE(files.size() == 1);
+    return files.front();
+}
+
+static void check_presets(const PresetBundle &bundle)
+{
+    const Preset *print = bundle.prints.find_preset("Test Print");
+    REQUIRE(print != nullptr);
+    REQUIRE(print->is_system);
+    REQUIRE(print->config.opt_int("perimeters") == 4);
+    REQUIRE(print->config.opt_float("layer_height") == Approx(0.2));
+    const Preset *filament = bundle.filaments.find_preset("Test PLA");
+    REQUIRE(filament != nullptr);
+    REQUIRE(filament->config.opt_int("temperature", 0) == 215);
+    REQUIRE(bundle.printers.find_preset("Test Printer") != nullptr);
+    REQUIRE(bundle.prints.find_preset("*common*") == nullptr);
+}
+
+SCENARIO("System config bundles are cached", "[PresetBundle]") {
+    boost::filesystem::path temp      = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::filesystem::path cache_dir = temp / "bundle_cache";
+    boost::filesystem::create_directories(cache_dir);
+    // Cache directory of the PresetUpdater.
+    boost::filesystem::create_directories(temp / "cache");
+    boost::filesystem::create_directories(temp / "vendor");
+    std::string old_data_dir = data_dir();
+    set_data_dir(temp.string());
+    std::string bundle_path = (temp / "vendor" / "TestVendor.ini").string();
+    {
+        boost::nowide::ofstream ofs(bundle_path);
+        ofs << test_bundle;
+    }
+    auto load = [&bundle_path]() {
+        PresetBundle bundle;
+        REQUIRE(bundle.load_configbundle(bundle_path, PresetBundle::LOAD_CFGBNDLE_SYSTEM) == 3);
+        check_presets(bundle);
+    };
+    // The cache is only replaced when it is not valid, mark the cache to find out whether it was rewritten.
+    const std::time_t marker = 1000000;
+
+    GIVEN("A system config bundle loaded for the first time") {
+        load();
+        THEN("The cache is written") {
+            boost::filesystem::path path = cache_file(cache_dir);
+            REQUIRE(path.filename().string().find("TestVendor-") == 0);
+            REQUIRE(boost::filesystem::is_empty(temp / "cache"));
+            WHEN("The config bundle is loaded again") {
+                boost::filesystem::last_write_time(path, marker);
+                load();
+                THEN("The presets are loaded from the cache") {
+                    REQUIRE(boost::filesystem::last_write_time(cache_file(cache_dir)) == marker);
+                }
+            }
+            WHEN("The cache is truncated") {
+                boost::filesystem::resize_file(path, boost::filesystem::file_size(path) / 2);
+                boost::filesystem::last_write_time(path, marker);
+                load();
+                THEN("The config bundle is parsed and the cache is rewritten") {
+                    REQUIRE(boost::filesystem::last_write_time(cache_file(cache_dir)) != marker);
+                    boost::filesystem::last_write_time(path, marker);
+                    load();
+                    REQUIRE(boost::filesystem::last_write_time(cache_file(cache_dir)) == marker);
+                }
+            }
+            WHEN("The presets stored in the cache are corrupted") {
+                std::string data;
+                {
+                    boost::nowide::ifstream ifs(path.string(), std::ios::binary);
+                    data.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+                }
+                for (size_t i = data.size() / 2; i < data.size(); ++ i)
+                    data[i] = char(0xff);
+                {
+                    boost::nowide::ofstream ofs(path.string(), std::ios::binary);
+                    ofs.write(data.data(), data.size());
+                }
+                boost::filesystem::last_write_time(path, marker);
+                load();
+                THEN("The config bundle is parsed and the cache is rewritten") {
+                    REQUIRE(boost::filesystem::last_write_time(cache_file(cache_dir)) != marker);
+                }
+            }
+        }
+    }
+
+    set_data_dir(old_data_dir);
+    boost::filesystem::remove_all(temp);
+}
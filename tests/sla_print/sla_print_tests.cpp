@@ -6,6 +6,7 @@
 
 #include <libslic3r/SLA/SupportTreeMesher.hpp>
 #include <libslic3r/SLA/Concurrency.hpp>
+#include <libslic3r/Model.hpp>
 
 namespace {
 
@@ -251,3 +252,30 @@ TEST_CASE("Test concurrency")
 
     REQUIRE(s == Approx(ref));
 }
+
+TEST_CASE("Progress of the SLA objects processed concurrently does not go back", "[SLAPrint]")
+{
+    SLAFullPrintConfig sla_config;
+    sla_config.printer_technology.value = ptSLA;
+    DynamicPrintConfig config;
+    config.apply(sla_config, true);
+
+    Model model;
+    for (double x : { 30., 80. }) {
+        ModelObject *mo = model.add_object("20mm_cube.obj", "", load_model("20mm_cube.obj"));
+        mo->add_instance()->set_offset(Vec3d(x, 30., 0.));
+    }
+
+    SLAPrint         print;
+    std::vector<int> progress;
+    print.set_status_callback([&progress](const PrintBase::SlicingStatus &status) {
+        if (status.percent >= 0)
+            progress.emplace_back(status.percent);
+    });
+    print.apply(model, config);
+    print.process();
+
+    REQUIRE(! progress.empty());
+    REQUIRE(std::is_sorted(progress.begin(), progress.end()));
+    REQUIRE(progress.back() == 100);
+}
@@ -6,6 +6,8 @@
 
 #include "sla_test_utils.hpp"
 
+#include <chrono>
+
 using namespace Slic3r;
 
 // First do a simple test of the hole raycaster.
@@ -95,3 +97,78 @@ TEST_CASE("Raycaster with loaded drillholes", "[sla_raycast]")
     test_support_model_collision("20mm_cube.obj", {}, hcfg, holes);
 }
 #endif
+
+// Rays sampled on rings around points of the mesh surface, pointing outwards,
+// similarly to the rays cast by the support tree generator.
+static void make_ray_rings(const TriangleMesh &mesh, size_t ring_size,
+                           std::vector<Vec3d> &srcs, std::vector<Vec3d> &dirs)
+{
+    for (size_t fi = 0; fi < mesh.its.indices.size(); ++fi) {
+        const Vec3i &face = mesh.its.indices[fi];
+        Vec3d c = (mesh.its.vertices[face(0)] + mesh.its.vertices[face(1)] +
+                   mesh.its.vertices[face(2)]).cast<double>() / 3.;
+        Vec3d n = mesh.stl.facet_start[fi].normal.cast<double>();
+        Vec3d a = n.unitOrthogonal(), b = n.cross(a);
+        for (size_t i = 0; i < ring_size; ++i) {
+            double phi = 2. * PI * i / ring_size;
+            Vec3d  d   = (n + 0.5 * (std::cos(phi) * a + std::sin(phi) * b)).normalized();
+            srcs.emplace_back(c + 0.1 * d);
+            dirs.emplace_back(d);
+        }
+    }
+}
+
+TEST_CASE("Raycaster - packets hit the same as single rays", "[sla_raycast]")
+{
+    for (const char *obj_filename : { "20mm_cube.obj", "A_upsidedown.obj", "extruder_idler.obj" }) {
+        TriangleMesh mesh = load_model(obj_filename);
+        mesh.require_shared_vertices();
+        sla::IndexedMesh emesh{mesh};
+
+        // Ring size not divisible by the packet size to exercise the padding.
+        std::vector<Vec3d> srcs, dirs;
+        make_ray_rings(mesh, 7, srcs, dirs);
+        // Rays cast from the inside as well.
+        for (size_t i = 0, n = srcs.size(); i < n; ++i) {
+            srcs.emplace_back(srcs[i] - 0.2 * dirs[i]);
+            dirs.emplace_back(-dirs[i]);
+        }
+
+        std::vector<sla::IndexedMesh::hit_result> hits(srcs.size());
+        emesh.query_ray_hit(srcs.data(), dirs.data(), srcs.size(), hits.data());
+
+        for (size_t i = 0; i < srcs.size(); ++i) {
+            auto hit = emesh.query_ray_hit(srcs[i], dirs[i]);
+            REQUIRE(hits[i].face() == hit.face());
+            REQUIRE(hits[i].is_hit() == hit.is_hit());
+            if (hit.is_hit())
+                REQUIRE(hits[i].distance() == Approx(hit.distance()));
+        }
+    }
+}
+
+TEST_CASE("Benchmark raycasting in packets", "[sla_raycast][.Benchmark]")
+{
+    for (const char *obj_filename : { "A_upsidedown.obj", "extruder_idler.obj" }) {
+        TriangleMesh mesh = load_model(obj_filename);
+        mesh.require_shared_vertices();
+        sla::IndexedMesh emesh{mesh};
+
+        std::vector<Vec3d> srcs, dirs;
+        make_ray_rings(mesh, 8, srcs, dirs);
+        std::vector<sla::IndexedMesh::hit_result> hits(srcs.size());
+
+        auto t_start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < srcs.size(); ++i)
+            hits[i] = emesh.query_ray_hit(srcs[i], dirs[i]);
+        double single = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+
+        t_start = std::chrono::steady_clock::now();
+        emesh.query_ray_hit(srcs.data(), dirs.data(), srcs.size(), hits.data());
+        double packet = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+
+        std::cout << obj_filename << ": " << srcs.size() << " rays, single rays "
+                  << srcs.size() / single << " rays/s, packets "
+                  << srcs.size() / packet << " rays/s" << std::endl;
+    }
+}
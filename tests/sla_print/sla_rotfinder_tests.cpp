@@ -0,0 +1,24 @@
+#include <catch2/catch.hpp>
+#include <test_utils.hpp>
+
+#include <libslic3r/SLA/Rotfinder.hpp>
+
+namespace Slic3r { namespace sla {
+
+TEST_CASE("Pruned rotation search should find the same rotation as the exhaustive one", "[SLARotfinder]") {
+    for (const char *obj_filename : { "A_upsidedown.obj", "extruder_idler.obj", "frog_legs.obj", "ipadstand.obj" }) {
+        TriangleMesh mesh = load_model(obj_filename);
+        mesh.require_shared_vertices();
+
+        for (float accuracy : { 0.1f, 1.f }) {
+            Vec2d rot_exhaustive = find_best_rotation_elevated(mesh, accuracy, false);
+            Vec2d rot_pruned     = find_best_rotation_elevated(mesh, accuracy, true);
+
+            INFO(obj_filename << ", accuracy " << accuracy);
+            REQUIRE(rot_pruned.x() == Approx(rot_exhaustive.x()));
+            REQUIRE(rot_pruned.y() == Approx(rot_exhaustive.y()));
+        }
+    }
+}
+
+}} // namespace Slic3r::sla
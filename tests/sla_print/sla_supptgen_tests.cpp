@@ -4,6 +4,8 @@
 #include <libslic3r/ExPolygon.hpp>
 #include <libslic3r/BoundingBox.hpp>
 
+#include <chrono>
+
 #include "sla_test_utils.hpp"
 
 namespace Slic3r { namespace sla {
@@ -143,4 +145,103 @@ TEST_CASE("Two parallel plates should be supported", "[SupGen][Hollowed]")
     REQUIRE(!pts.empty());
 }
 
+TEST_CASE("Large overhanging surface should be supported with adaptive sampling", "[SupGen]") {
+    double width = 50., depth = 50., height = 1.;
+
+    TriangleMesh mesh = make_cube(width, depth, height);
+    mesh.translate(0., 0., 5.); // lift up
+    mesh.require_shared_vertices();
+
+    sla::SupportPointGenerator::Config cfg;
+    double mm2 = width * depth;
+
+    for (bool adaptive : { true, false }) {
+        cfg.adaptive_sampling = adaptive;
+        sla::SupportPoints pts = calc_support_pts(mesh, cfg);
+
+        REQUIRE(pts.size() * cfg.support_force() > mm2 * cfg.tear_pressure());
+        REQUIRE(min_point_distance(pts) >= cfg.minimal_distance);
+    }
+}
+
+// Area of the downward facing surfaces of the mesh, which are farther than max_dist from the nearest support point.
+static double unsupported_area(const TriangleMesh &mesh, const sla::SupportPoints &pts, double max_dist)
+{
+    sla::PointIndex index;
+    for (size_t i = 0; i < pts.size(); ++i)
+        index.insert(pts[i].pos.cast<double>(), i);
+
+    // Sample the triangles with a regular barycentric grid of step 0.5mm.
+    constexpr double step = 0.5;
+    double area = 0.;
+    for (const stl_triangle_vertex_indices &tri : mesh.its.indices) {
+        Vec3d a = mesh.its.vertices[tri(0)].cast<double>();
+        Vec3d b = mesh.its.vertices[tri(1)].cast<double>();
+        Vec3d c = mesh.its.vertices[tri(2)].cast<double>();
+        Vec3d n = (b - a).cross(c - a);
+        double tri_area = 0.5 * n.norm();
+        if (tri_area < EPSILON || n.normalized().z() > -0.5)
+            continue;
+        size_t divs = size_t(std::ceil(std::max({(b - a).norm(), (c - b).norm(), (a - c).norm()}) / step));
+        size_t num_samples = 0, num_unsupported = 0;
+        for (size_t i = 0; i <= divs; ++ i)
+            for (size_t j = 0; i + j <= divs; ++ j, ++ num_samples) {
+                Vec3d p = a + (b - a) * (double(i) / divs) + (c - a) * (double(j) / divs);
+                auto res = index.nearest(p, 1);
+                if (res.empty() || (res.front().first - p).norm() > max_dist)
+                    ++ num_unsupported;
+            }
+        area += tri_area * double(num_unsupported) / double(num_samples);
+    }
+    return area;
+}
+
+TEST_CASE("Adaptive and dense sampling should support the overhangs alike", "[SupGen]") {
+    sla::SupportPointGenerator::Config cfg;
+    double max_dist = 2. * std::sqrt(cfg.support_force() / (PI * cfg.tear_pressure()));
+
+    // A large rectangular plate and a disc, both lifted above the bed.
+    for (TriangleMesh mesh : { make_cube(40., 30., 2.), make_cylinder(15., 2.) }) {
+        mesh.translate(0., 0., 5.);
+        mesh.require_shared_vertices();
+
+        double area[2];
+        for (bool adaptive : { false, true }) {
+            cfg.adaptive_sampling = adaptive;
+            area[adaptive] = unsupported_area(mesh, calc_support_pts(mesh, cfg), max_dist);
+        }
+
+        CHECK(area[true] <= 1.1 * area[false] + 1.);
+    }
+}
+
+TEST_CASE("Benchmark adaptive support point sampling", "[SupGen][.Benchmark]") {
+    sla::SupportPointGenerator::Config cfg;
+    // Distance at which a single support point carries the tear pressure of the surface around it, doubled.
+    double max_dist = 2. * std::sqrt(cfg.support_force() / (PI * cfg.tear_pressure()));
+
+    for (const char *obj_filename : { "A_upsidedown.obj", "extruder_idler.obj",
+                                      "cube_with_concave_hole_enlarged_standing.obj", "20mm_cube.obj" }) {
+        TriangleMesh mesh = load_model(obj_filename);
+        mesh.require_shared_vertices();
+
+        double area[2], seconds[2];
+        size_t num_pts[2];
+        for (bool adaptive : { false, true }) {
+            cfg.adaptive_sampling = adaptive;
+            auto t_start = std::chrono::steady_clock::now();
+            sla::SupportPoints pts = calc_support_pts(mesh, cfg);
+            seconds[adaptive] = std::chrono::duration<double>(std::chrono::steady_clock::now() - t_start).count();
+            num_pts[adaptive] = pts.size();
+            area[adaptive]    = unsupported_area(mesh, pts, max_dist);
+        }
+
+        std::cout << obj_filename << ": dense sampling " << seconds[false] << "s, " << num_pts[false] << " points, "
+                  << area[false] << "mm2 unsupported; adaptive sampling " << seconds[true] << "s, " << num_pts[true]
+                  << " points, " << area[true] << "mm2 unsupported" << std::endl;
+
+        CHECK(area[true] <= 1.1 * area[false] + 1.);
+    }
+}
+
 }} // namespace Slic3r::sla